@@ -16,6 +16,8 @@
 
 #include "absl/strings/ascii.h"
 
+#include "yacl/io/msgpack/spec_traits.h"
+
 namespace yacl::crypto {
 
 EcGroupFactory &EcGroupFactory::Instance() {
@@ -42,4 +44,34 @@ void EcGroupFactory::Register(const std::string &lib_name, uint64_t performance,
       });
 }
 
+Buffer EcGroup::SerializePoints(absl::Span<const EcPoint> points,
+                                PointOctetFormat format) const {
+  const size_t item_size = GetSerializeLength(format);
+  const size_t head_size = io::msgpack_traits::HeadSizeOfStr(item_size);
+  Buffer buf(io::msgpack_traits::HeadSizeOfArray(points.size()) +
+             (head_size + item_size) * points.size());
+
+  auto *pos = buf.data<char>();
+  pos += io::msgpack_traits::WriteArrayHead(points.size(), pos);
+  for (const auto &point : points) {
+    pos += io::msgpack_traits::WriteStrHead(item_size, pos);
+    SerializePoint(point, format, reinterpret_cast<uint8_t *>(pos), item_size);
+    pos += item_size;
+  }
+  return buf;
+}
+
+std::vector<EcPoint> EcGroup::DeserializePoints(ByteContainerView buf,
+                                                PointOctetFormat format) const {
+  size_t pos = 0;
+  size_t count = io::msgpack_traits::ReadArrayHead(buf, &pos);
+  std::vector<EcPoint> points;
+  points.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    points.emplace_back(
+        DeserializePoint(io::msgpack_traits::ReadStr(buf, &pos), format));
+  }
+  return points;
+}
+
 }  // namespace yacl::crypto
@@ -18,6 +18,9 @@
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
+
+#include "absl/types/span.h"
 
 #include "yacl/base/byte_container_view.h"
 #include "yacl/crypto/base/ecc/curve_meta.h"
@@ -250,6 +253,22 @@ class EcGroup {
     return DeserializePoint(buf, PointOctetFormat::Autonomous);
   }
 
+  // Serialize points to a msgpack array of str, every item takes
+  // GetSerializeLength(format) bytes, so the output is allocated only once.
+  // For fixed length formats (e.g. X9.62), infinity is zero padded.
+  Buffer SerializePoints(absl::Span<const EcPoint> points,
+                         PointOctetFormat format) const;
+  Buffer SerializePoints(absl::Span<const EcPoint> points) const {
+    return SerializePoints(points, PointOctetFormat::Autonomous);
+  }
+
+  // Load points of SerializePoints, items are parsed in place (no copy).
+  std::vector<EcPoint> DeserializePoints(ByteContainerView buf,
+                                         PointOctetFormat format) const;
+  std::vector<EcPoint> DeserializePoints(ByteContainerView buf) const {
+    return DeserializePoints(buf, PointOctetFormat::Autonomous);
+  }
+
   // Get a human-readable representation of elliptic curve point
   virtual AffinePoint GetAffinePoint(const EcPoint &point) const = 0;
 
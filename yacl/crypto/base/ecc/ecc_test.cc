@@ -231,6 +231,13 @@ class EcCurveTest : public ::testing::TestWithParam<std::string> {
                                        PointOctetFormat::X962Compressed);
       ASSERT_TRUE(ec_->PointEqual(tmp, points[i]));
     }
+    buf_m = ec_->SerializePoints(points, PointOctetFormat::X962Compressed);
+    auto points2 =
+        ec_->DeserializePoints(buf_m, PointOctetFormat::X962Compressed);
+    ASSERT_EQ(points2.size(), points.size());
+    for (uint64_t i = 0; i < points.size(); i++) {
+      ASSERT_TRUE(ec_->PointEqual(points2[i], points[i]));
+    }
   }
 
   void TestHashPointWorks() {
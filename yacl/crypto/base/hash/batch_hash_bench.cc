@@ -0,0 +1,80 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "yacl/crypto/base/hash/hash_utils.h"
+
+namespace yacl::crypto {
+
+// n inputs of len bytes, e.g. PSI identifiers.
+std::vector<std::string> MakeInputs(size_t n, size_t len) {
+  std::vector<std::string> inputs(n);
+  for (size_t i = 0; i < n; i++) {
+    inputs[i] = std::string(len, static_cast<char>(i));
+    std::memcpy(inputs[i].data(), &i, std::min(len, sizeof(i)));
+  }
+  return inputs;
+}
+
+// one Sha256/Sm3/Blake3 call per input.
+template <HashAlgorithm kAlgo>
+void BM_OneByOne(benchmark::State& state) {
+  const size_t n = state.range(0);
+  const auto inputs = MakeInputs(n, state.range(1));
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      if constexpr (kAlgo == HashAlgorithm::SHA256) {
+        benchmark::DoNotOptimize(Sha256(input));
+      } else if constexpr (kAlgo == HashAlgorithm::SM3) {
+        benchmark::DoNotOptimize(Sm3(input));
+      } else {
+        benchmark::DoNotOptimize(Blake3(input));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <HashAlgorithm kAlgo>
+void BM_BatchHash(benchmark::State& state) {
+  const size_t n = state.range(0);
+  const auto inputs = MakeInputs(n, state.range(1));
+  std::vector<ByteContainerView> views(inputs.begin(), inputs.end());
+  std::vector<uint8_t> out(n * BatchHashDigestSize(kAlgo));
+  for (auto _ : state) {
+    BatchHash(kAlgo, views, absl::MakeSpan(out));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define BATCH_HASH_BENCHMARK(func, algo)        \
+  BENCHMARK_TEMPLATE(func, algo)                \
+      ->Unit(benchmark::kMillisecond)           \
+      ->ArgsProduct({{1 << 16, 1 << 20}, {16, 32, 64, 128}})
+
+BATCH_HASH_BENCHMARK(BM_OneByOne, HashAlgorithm::SHA256);
+BATCH_HASH_BENCHMARK(BM_BatchHash, HashAlgorithm::SHA256);
+BATCH_HASH_BENCHMARK(BM_OneByOne, HashAlgorithm::SM3);
+BATCH_HASH_BENCHMARK(BM_BatchHash, HashAlgorithm::SM3);
+BATCH_HASH_BENCHMARK(BM_OneByOne, HashAlgorithm::BLAKE3);
+BATCH_HASH_BENCHMARK(BM_BatchHash, HashAlgorithm::BLAKE3);
+
+}  // namespace yacl::crypto
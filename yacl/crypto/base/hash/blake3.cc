@@ -14,12 +14,136 @@
 
 #include "yacl/crypto/base/hash/blake3.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <vector>
 
+// blake3_impl.h has no C linkage declaration.
+extern "C" {
+#include "c/blake3_impl.h"
+}
+
 #include "yacl/base/exception.h"
+#include "yacl/utils/parallel.h"
 
 namespace yacl::crypto {
 
+namespace {
+
+constexpr size_t kSubtreeChunks =
+    Blake3Hash::kParallelSubtreeLen / BLAKE3_CHUNK_LEN;
+static_assert(kSubtreeChunks > 0 &&
+                  (kSubtreeChunks & (kSubtreeChunks - 1)) == 0,
+              "subtree must be power of 2 chunks");
+
+// HashFile maps this many bytes at a time, must be multiple of subtree len.
+constexpr size_t kFileWindowLen = 1024 * Blake3Hash::kParallelSubtreeLen;
+
+// Merge num adjacent chaining values in cvs (in place) until `keep` are left.
+// Pairing level by level and carrying the odd one up gives the same parents
+// as the left complete tree of blake3_hasher.
+size_t MergeCvs(uint8_t* cvs, size_t num, size_t keep) {
+  std::vector<const uint8_t*> ptrs;
+  std::vector<uint8_t> parents;
+  while (num > keep) {
+    const size_t pairs = num / 2;
+    ptrs.resize(pairs);
+    for (size_t i = 0; i < pairs; i++) {
+      ptrs[i] = cvs + 2 * i * BLAKE3_OUT_LEN;
+    }
+    parents.resize(pairs * BLAKE3_OUT_LEN);
+    blake3_hash_many(ptrs.data(), pairs, 1, IV, 0, false, PARENT, 0, 0,
+                     parents.data());
+    std::memcpy(cvs, parents.data(), parents.size());
+    if (num % 2 == 1) {
+      std::memmove(cvs + pairs * BLAKE3_OUT_LEN,
+                   cvs + (num - 1) * BLAKE3_OUT_LEN, BLAKE3_OUT_LEN);
+    }
+    num = pairs + num % 2;
+  }
+  return num;
+}
+
+// Chaining value of subtree data[0, len), 0 < len <= kParallelSubtreeLen,
+// whose first chunk is chunk_counter.
+void SubtreeCv(const uint8_t* data, size_t len, uint64_t chunk_counter,
+               uint8_t* out) {
+  const size_t full_chunks = len / BLAKE3_CHUNK_LEN;
+  const size_t rem = len % BLAKE3_CHUNK_LEN;
+  std::array<const uint8_t*, kSubtreeChunks> ptrs;
+  std::array<uint8_t, kSubtreeChunks * BLAKE3_OUT_LEN> cvs;
+  for (size_t i = 0; i < full_chunks; i++) {
+    ptrs[i] = data + i * BLAKE3_CHUNK_LEN;
+  }
+  blake3_hash_many(ptrs.data(), full_chunks,
+                   BLAKE3_CHUNK_LEN / BLAKE3_BLOCK_LEN, IV, chunk_counter,
+                   true, 0, CHUNK_START, CHUNK_END, cvs.data());
+  size_t num = full_chunks;
+  if (rem > 0) {
+    // partial last chunk of the data.
+    const uint8_t* p = data + full_chunks * BLAKE3_CHUNK_LEN;
+    const uint64_t counter = chunk_counter + full_chunks;
+    uint32_t cv[8];
+    std::memcpy(cv, IV, sizeof(cv));
+    uint8_t flags = CHUNK_START;
+    size_t left = rem;
+    for (; left > BLAKE3_BLOCK_LEN; left -= BLAKE3_BLOCK_LEN) {
+      blake3_compress_in_place(cv, p, BLAKE3_BLOCK_LEN, counter, flags);
+      flags = 0;
+      p += BLAKE3_BLOCK_LEN;
+    }
+    uint8_t block[BLAKE3_BLOCK_LEN] = {};
+    std::memcpy(block, p, left);
+    blake3_compress_in_place(cv, block, static_cast<uint8_t>(left), counter,
+                             flags | CHUNK_END);
+    store_cv_words(cvs.data() + num * BLAKE3_OUT_LEN, cv);
+    num++;
+  }
+  MergeCvs(cvs.data(), num, 1);
+  std::memcpy(out, cvs.data(), BLAKE3_OUT_LEN);
+}
+
+// Chaining values of subtrees of data[0, len) in parallel, data starts at
+// chunk first_chunk which is aligned to subtree.
+void SubtreeCvs(const uint8_t* data, size_t len, uint64_t first_chunk,
+                uint8_t* cvs) {
+  const int64_t num =
+      (len + Blake3Hash::kParallelSubtreeLen - 1) /
+      Blake3Hash::kParallelSubtreeLen;
+  parallel_for(0, num, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const size_t offset = i * Blake3Hash::kParallelSubtreeLen;
+      SubtreeCv(data + offset,
+                std::min(Blake3Hash::kParallelSubtreeLen, len - offset),
+                first_chunk + i * kSubtreeChunks, cvs + i * BLAKE3_OUT_LEN);
+    }
+  });
+}
+
+// Root output of num (>= 2) subtree chaining values.
+std::vector<uint8_t> RootOutput(uint8_t* cvs, size_t num, size_t output_len) {
+  MergeCvs(cvs, num, 2);
+  std::vector<uint8_t> digest(output_len);
+  uint8_t block[BLAKE3_BLOCK_LEN];
+  for (size_t offset = 0, counter = 0; offset < output_len;
+       offset += BLAKE3_BLOCK_LEN, counter++) {
+    blake3_compress_xof(IV, cvs, BLAKE3_BLOCK_LEN, counter, PARENT | ROOT,
+                        block);
+    std::memcpy(digest.data() + offset, block,
+                std::min<size_t>(BLAKE3_BLOCK_LEN, output_len - offset));
+  }
+  return digest;
+}
+
+}  // namespace
+
 Blake3Hash::Blake3Hash()
     : hash_algo_(HashAlgorithm::BLAKE3), digest_size_(BLAKE3_OUT_LEN) {
   Init();
@@ -64,4 +188,67 @@ std::vector<uint8_t> Blake3Hash::CumulativeHash() const {
   return digest;
 }
 
+std::vector<uint8_t> Blake3Hash::ParallelHash(ByteContainerView data,
+                                              size_t output_len) {
+  if (data.size() <= kParallelSubtreeLen) {
+    return Blake3Hash(output_len).Update(data).CumulativeHash();
+  }
+  const size_t num =
+      (data.size() + kParallelSubtreeLen - 1) / kParallelSubtreeLen;
+  std::vector<uint8_t> cvs(num * BLAKE3_OUT_LEN);
+  SubtreeCvs(data.data(), data.size(), 0, cvs.data());
+  return RootOutput(cvs.data(), num, output_len);
+}
+
+std::vector<uint8_t> Blake3Hash::HashFile(const std::string& path,
+                                          size_t output_len) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    YACL_THROW_IO_ERROR("Open file '{}' failed, error msg '{}'", path,
+                        std::strerror(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int err = errno;
+    close(fd);
+    YACL_THROW_IO_ERROR("Stat file '{}' failed, error msg '{}'", path,
+                        std::strerror(err));
+  }
+  const size_t size = st.st_size;
+  if (size == 0) {
+    close(fd);
+    return ParallelHash({}, output_len);
+  }
+  const size_t num = (size + kParallelSubtreeLen - 1) / kParallelSubtreeLen;
+  std::vector<uint8_t> cvs(num * BLAKE3_OUT_LEN);
+  std::vector<uint8_t> digest;
+  // map one window at a time, so address space & page cache pressure is
+  // bounded for files larger than memory.
+  for (size_t offset = 0; offset < size; offset += kFileWindowLen) {
+    const size_t len = std::min(kFileWindowLen, size - offset);
+    void* addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, offset);
+    if (addr == MAP_FAILED) {
+      int err = errno;
+      close(fd);
+      YACL_THROW_IO_ERROR("Mmap file '{}' failed, error msg '{}'", path,
+                          std::strerror(err));
+    }
+    // hint only, ignore error.
+    madvise(addr, len, MADV_WILLNEED);
+    const auto* data = static_cast<const uint8_t*>(addr);
+    if (num == 1) {
+      digest = ParallelHash({data, len}, output_len);
+    } else {
+      SubtreeCvs(data, len, offset / BLAKE3_CHUNK_LEN,
+                 cvs.data() + offset / kParallelSubtreeLen * BLAKE3_OUT_LEN);
+    }
+    munmap(addr, len);
+  }
+  close(fd);
+  if (num > 1) {
+    digest = RootOutput(cvs.data(), num, output_len);
+  }
+  return digest;
+}
+
 }  // namespace yacl::crypto
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "c/blake3.h"
@@ -50,6 +51,20 @@ class Blake3Hash : public HashInterface {
   Blake3Hash& Update(ByteContainerView data) override;
   std::vector<uint8_t> CumulativeHash() const override;
 
+  // One shot hash of large data, same result as Update(data).CumulativeHash().
+  // Data is split into subtrees of kParallelSubtreeLen bytes hashed by
+  // parallel_for, then their chaining values are merged up to the root, so
+  // throughput scales with threads. Small data goes to the plain hasher.
+  static std::vector<uint8_t> ParallelHash(ByteContainerView data,
+                                           size_t output_len = BLAKE3_OUT_LEN);
+
+  // ParallelHash of the whole content of file, read through mmap.
+  static std::vector<uint8_t> HashFile(const std::string& path,
+                                       size_t output_len = BLAKE3_OUT_LEN);
+
+  // Must be power of 2 chunks, so that every subtree is a node of the tree.
+  static constexpr size_t kParallelSubtreeLen = 256 * BLAKE3_CHUNK_LEN;
+
  private:
   const HashAlgorithm hash_algo_;
   const size_t digest_size_;
@@ -14,11 +14,13 @@
 
 #include <future>
 #include <iostream>
+#include <string>
 
 #include "benchmark/benchmark.h"
 
 #include "yacl/base/exception.h"
 #include "yacl/crypto/base/hash/blake3.h"
+#include "yacl/utils/parallel.h"
 
 namespace yacl::crypto {
 
@@ -48,4 +50,38 @@ BENCHMARK(BM_Blake3)
     ->Arg(81920)
     ->Arg(1 << 21);
 
+// range(0): bytes to hash.
+static void BM_Blake3Update(benchmark::State& state) {
+  std::string data(state.range(0), 'x');
+  for (auto _ : state) {
+    Blake3Hash blake3;
+    benchmark::DoNotOptimize(blake3.Update(data).CumulativeHash());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// range(0): bytes to hash.
+// the intra-op pool is sized once per process (set_num_threads is ignored
+// after first use), so sweep threads by one run per count, e.g.
+//   YACL_NUM_THREADS=4 blake3_bench --benchmark_filter=ParallelHash
+static void BM_Blake3ParallelHash(benchmark::State& state) {
+  std::string data(state.range(0), 'x');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Blake3Hash::ParallelHash(data));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  state.counters["threads"] = get_num_threads();
+}
+
+BENCHMARK(BM_Blake3Update)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(1 << 24)
+    ->Arg(1 << 28);
+
+BENCHMARK(BM_Blake3ParallelHash)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Arg(1 << 24)
+    ->Arg(1 << 28);
+
 }  // namespace yacl::crypto
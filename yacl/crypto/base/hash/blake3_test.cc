@@ -14,6 +14,10 @@
 
 #include "yacl/crypto/base/hash/blake3.h"
 
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
 #include <limits>
 #include <string>
 #include <vector>
@@ -157,4 +161,50 @@ TEST(Blake3HashTest, MaximumLength) {
   EXPECT_EQ(cur_result.substr(0, 2 * len), std_result);
 }
 
+std::string MakeData(size_t len) {
+  std::string data(len, '\0');
+  for (size_t i = 0; i < len; i++) {
+    data[i] = static_cast<char>(i * 131 + (i >> 10));
+  }
+  return data;
+}
+
+TEST(Blake3HashTest, ParallelHash) {
+  constexpr size_t kSubtree = Blake3Hash::kParallelSubtreeLen;
+  // cover single chunk, single subtree, partial last chunk/block, odd number
+  // of subtrees and tail subtree of one chunk.
+  for (size_t len : {size_t{0}, size_t{1}, size_t{BLAKE3_CHUNK_LEN + 1},
+                     kSubtree, kSubtree + 1, 2 * kSubtree,
+                     3 * kSubtree + BLAKE3_CHUNK_LEN,
+                     5 * kSubtree + 3 * BLAKE3_CHUNK_LEN + 65,
+                     8 * kSubtree - 1}) {
+    auto data = MakeData(len);
+    for (size_t output_len : {size_t{BLAKE3_OUT_LEN}, size_t{100}}) {
+      EXPECT_EQ(Blake3Hash::ParallelHash(data, output_len),
+                Blake3Hash(output_len).Update(data).CumulativeHash())
+          << "len " << len << " output_len " << output_len;
+    }
+  }
+}
+
+TEST(Blake3HashTest, HashFile) {
+  auto path = fmt::format("{}/blake3_hash_file_{}",
+                          std::filesystem::temp_directory_path().string(),
+                          getpid());
+  for (size_t len : {size_t{0}, size_t{1000},
+                     3 * Blake3Hash::kParallelSubtreeLen + 7}) {
+    auto data = MakeData(len);
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out.write(data.data(), data.size());
+    }
+    EXPECT_EQ(Blake3Hash::HashFile(path),
+              Blake3Hash().Update(data).CumulativeHash())
+        << "len " << len;
+  }
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(Blake3Hash::HashFile(path), IoError);
+}
+
 }  // namespace yacl::crypto
@@ -14,13 +14,22 @@
 
 #include "yacl/crypto/base/hash/hash_utils.h"
 
+#include <array>
 #include <cstring>
 #include <iostream>
 #include <vector>
 
 #include "c/blake3.h"
 
+// blake3_impl.h has no C linkage declaration.
+extern "C" {
+#include "c/blake3_impl.h"
+}
+
 #include "yacl/base/exception.h"
+#include "yacl/crypto/base/hash/sha256_mb.h"
+#include "yacl/crypto/base/openssl_wrappers.h"
+#include "yacl/utils/parallel.h"
 
 namespace yacl::crypto {
 
@@ -58,4 +67,184 @@ std::array<uint8_t, 32> Blake3(ByteContainerView data) {
   return digest;
 }
 
+namespace {
+
+// inputs hashed by one task of parallel_for.
+constexpr int64_t kBatchHashGrainSize = 4096;
+
+// longer inputs are hashed one by one.
+constexpr size_t kSha256MultiMaxBlocks = 16;
+
+constexpr size_t kBlake3ChunkBlocks = BLAKE3_CHUNK_LEN / BLAKE3_BLOCK_LEN;
+
+// one shot OpenSSL hash reusing one context.
+class SslOneShot {
+ public:
+  explicit SslOneShot(const EVP_MD* md) : md_(md), ctx_(EVP_MD_CTX_new()) {
+    YACL_ENFORCE(ctx_ != nullptr);
+  }
+
+  void Hash(ByteContainerView in, uint8_t* out) {
+    unsigned int out_len = 0;
+    OSSL_RET_1(EVP_DigestInit_ex(ctx_.get(), md_, nullptr));
+    OSSL_RET_1(EVP_DigestUpdate(ctx_.get(), in.data(), in.size()));
+    OSSL_RET_1(EVP_DigestFinal_ex(ctx_.get(), out, &out_len));
+  }
+
+ private:
+  const EVP_MD* md_;
+  openssl::UniqueMdCtx ctx_;
+};
+
+void SslBatchHash(const EVP_MD* md, size_t digest_size,
+                  absl::Span<const ByteContainerView> inputs, uint8_t* out) {
+  SslOneShot hasher(md);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    hasher.Hash(inputs[i], out + i * digest_size);
+  }
+}
+
+void Sha256BatchHash(const EVP_MD* md,
+                     absl::Span<const ByteContainerView> inputs,
+                     uint8_t* out) {
+  if (!internal::Sha256MultiSupported()) {
+    SslBatchHash(md, 32, inputs, out);
+    return;
+  }
+
+  // lanes of Sha256Multi should pad to the same blocks.
+  SslOneShot hasher(md);
+  std::array<std::vector<size_t>, kSha256MultiMaxBlocks + 1> groups;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    const size_t blocks = internal::Sha256PaddedBlocks(inputs[i].size());
+    if (blocks <= kSha256MultiMaxBlocks) {
+      groups[blocks].push_back(i);
+    } else {
+      hasher.Hash(inputs[i], out + i * 32);
+    }
+  }
+
+  ByteContainerView lanes[internal::kSha256Lanes];
+  uint8_t* outs[internal::kSha256Lanes];
+  for (const auto& group : groups) {
+    size_t j = 0;
+    for (; j + internal::kSha256Lanes <= group.size();
+         j += internal::kSha256Lanes) {
+      for (size_t l = 0; l < internal::kSha256Lanes; l++) {
+        lanes[l] = inputs[group[j + l]];
+        outs[l] = out + group[j + l] * 32;
+      }
+      internal::Sha256Multi(lanes, outs);
+    }
+    for (; j < group.size(); j++) {
+      hasher.Hash(inputs[group[j]], out + group[j] * 32);
+    }
+  }
+}
+
+void Blake3BatchHash(absl::Span<const ByteContainerView> inputs,
+                     uint8_t* out) {
+  // inputs of whole blocks in one chunk, grouped by blocks for hash_many.
+  std::array<std::vector<size_t>, kBlake3ChunkBlocks + 1> groups;
+  blake3_hasher hasher;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    const size_t len = inputs[i].size();
+    if (len > BLAKE3_BLOCK_LEN && len <= BLAKE3_CHUNK_LEN &&
+        len % BLAKE3_BLOCK_LEN == 0) {
+      groups[len / BLAKE3_BLOCK_LEN].push_back(i);
+    } else if (len <= BLAKE3_BLOCK_LEN) {
+      // the only block of the only chunk is root.
+      uint8_t block[BLAKE3_BLOCK_LEN] = {};
+      if (len > 0) {
+        std::memcpy(block, inputs[i].data(), len);
+      }
+      uint32_t cv[8];
+      std::memcpy(cv, IV, sizeof(cv));
+      blake3_compress_in_place(cv, block, static_cast<uint8_t>(len), 0,
+                               CHUNK_START | CHUNK_END | ROOT);
+      store_cv_words(out + i * BLAKE3_OUT_LEN, cv);
+    } else {
+      blake3_hasher_init(&hasher);
+      blake3_hasher_update(&hasher, inputs[i].data(), len);
+      blake3_hasher_finalize(&hasher, out + i * BLAKE3_OUT_LEN,
+                             BLAKE3_OUT_LEN);
+    }
+  }
+
+  std::vector<const uint8_t*> ptrs;
+  std::vector<uint8_t> cvs;
+  for (size_t blocks = 1; blocks < groups.size(); blocks++) {
+    const auto& group = groups[blocks];
+    if (group.empty()) {
+      continue;
+    }
+    ptrs.resize(group.size());
+    for (size_t j = 0; j < group.size(); j++) {
+      ptrs[j] = inputs[group[j]].data();
+    }
+    // chaining value of the last block of a single chunk with ROOT flag is
+    // the 32 bytes digest.
+    cvs.resize(group.size() * BLAKE3_OUT_LEN);
+    blake3_hash_many(ptrs.data(), ptrs.size(), blocks, IV, 0, false, 0,
+                     CHUNK_START, CHUNK_END | ROOT, cvs.data());
+    for (size_t j = 0; j < group.size(); j++) {
+      std::memcpy(out + group[j] * BLAKE3_OUT_LEN,
+                  cvs.data() + j * BLAKE3_OUT_LEN, BLAKE3_OUT_LEN);
+    }
+  }
+}
+
+}  // namespace
+
+size_t BatchHashDigestSize(HashAlgorithm algo) {
+  switch (algo) {
+    case HashAlgorithm::SHA256:
+    case HashAlgorithm::SM3:
+    case HashAlgorithm::BLAKE3:
+      return 32;
+    case HashAlgorithm::BLAKE2B:
+      return 64;
+    default:
+      YACL_THROW("Unsupported batch hash algo: {}", static_cast<int>(algo));
+  }
+}
+
+void BatchHash(HashAlgorithm algo, absl::Span<const ByteContainerView> inputs,
+               absl::Span<uint8_t> out) {
+  const size_t digest_size = BatchHashDigestSize(algo);
+  YACL_ENFORCE(out.size() == inputs.size() * digest_size,
+               "out size {} mismatch, expect {} * {}", out.size(),
+               inputs.size(), digest_size);
+
+  // fetched once, shared by all threads.
+  openssl::UniqueMd md;
+  if (algo != HashAlgorithm::BLAKE3) {
+    md = openssl::FetchEvpMd(ToString(algo));
+    YACL_ENFORCE(md != nullptr, "fetch {} failed", ToString(algo));
+  }
+
+  parallel_for(0, inputs.size(), kBatchHashGrainSize,
+               [&](int64_t begin, int64_t end) {
+                 auto sub = inputs.subspan(begin, end - begin);
+                 auto* sub_out = out.data() + begin * digest_size;
+                 switch (algo) {
+                   case HashAlgorithm::SHA256:
+                     Sha256BatchHash(md.get(), sub, sub_out);
+                     break;
+                   case HashAlgorithm::BLAKE3:
+                     Blake3BatchHash(sub, sub_out);
+                     break;
+                   default:
+                     SslBatchHash(md.get(), digest_size, sub, sub_out);
+                 }
+               });
+}
+
+std::vector<uint8_t> BatchHash(HashAlgorithm algo,
+                               absl::Span<const ByteContainerView> inputs) {
+  std::vector<uint8_t> out(inputs.size() * BatchHashDigestSize(algo));
+  BatchHash(algo, inputs, absl::MakeSpan(out));
+  return out;
+}
+
 }  // namespace yacl::crypto
@@ -16,6 +16,8 @@
 
 #include <vector>
 
+#include "absl/types/span.h"
+
 #include "yacl/base/int128.h"
 #include "yacl/crypto/base/hash/ssl_hash.h"
 
@@ -44,4 +46,23 @@ DECLARE_HASH_OUT_128(Sm3);     // uint128_t Sm3_128(ByteContainerView data);
 DECLARE_HASH_OUT_128(Blake2);  // uint128_t Blake2_128(ByteContainerView data);
 DECLARE_HASH_OUT_128(Blake3);  // uint128_t Blake3_128(ByteContainerView data);
 
+// digest size of BatchHash with algo, i.e. 32 for SHA256/SM3/BLAKE3 and 64 for
+// BLAKE2B, throw if algo is not supported by BatchHash.
+size_t BatchHashDigestSize(HashAlgorithm algo);
+
+// hash every input independently (same as Sha256, Sm3, Blake2 & Blake3), the
+// digest of inputs[i] is written to out[i * digest_size, (i + 1) *
+// digest_size), so out.size() should be inputs.size() * BatchHashDigestSize.
+//
+// for many short inputs, e.g. PSI identifiers. inputs are split across
+// threads by parallel_for, hash contexts are reused within a thread, and
+//  - SHA256: inputs up to 1KB are hashed 8 at a time by AVX2 if supported.
+//  - BLAKE3: inputs of whole blocks in one chunk go through blake3's SIMD
+//            hash_many, inputs up to one block take a single compression.
+void BatchHash(HashAlgorithm algo, absl::Span<const ByteContainerView> inputs,
+               absl::Span<uint8_t> out);
+
+std::vector<uint8_t> BatchHash(HashAlgorithm algo,
+                               absl::Span<const ByteContainerView> inputs);
+
 }  // namespace yacl::crypto
@@ -0,0 +1,129 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/crypto/base/hash/hash_utils.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "yacl/crypto/base/hash/sha256_mb.h"
+
+namespace yacl::crypto {
+
+namespace {
+
+std::vector<uint8_t> OneShot(HashAlgorithm algo, ByteContainerView data) {
+  switch (algo) {
+    case HashAlgorithm::SHA256: {
+      auto d = Sha256(data);
+      return {d.begin(), d.end()};
+    }
+    case HashAlgorithm::SM3: {
+      auto d = Sm3(data);
+      return {d.begin(), d.end()};
+    }
+    case HashAlgorithm::BLAKE2B: {
+      auto d = Blake2(data);
+      return {d.begin(), d.end()};
+    }
+    case HashAlgorithm::BLAKE3: {
+      auto d = Blake3(data);
+      return {d.begin(), d.end()};
+    }
+    default:
+      YACL_THROW("unsupported");
+  }
+}
+
+// every length up to 1200 (crossing blocks & one blake3 chunk), twice so
+// there are enough inputs of each length for multi-buffer paths, and a long
+// one.
+std::vector<std::string> MakeInputs() {
+  std::vector<std::string> inputs;
+  for (size_t round = 0; round < 2; round++) {
+    for (size_t len = 0; len <= 1200; len++) {
+      std::string s(len, '\0');
+      for (size_t i = 0; i < len; i++) {
+        s[i] = static_cast<char>(i * 31 + len + round);
+      }
+      inputs.push_back(std::move(s));
+    }
+  }
+  inputs.emplace_back(100000, 'x');
+  return inputs;
+}
+
+}  // namespace
+
+class BatchHashTest : public testing::TestWithParam<HashAlgorithm> {};
+
+TEST_P(BatchHashTest, SameAsOneShot) {
+  const auto algo = GetParam();
+  const auto inputs = MakeInputs();
+  std::vector<ByteContainerView> views(inputs.begin(), inputs.end());
+
+  auto out = BatchHash(algo, views);
+
+  const size_t digest_size = BatchHashDigestSize(algo);
+  ASSERT_EQ(out.size(), inputs.size() * digest_size);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    auto expect = OneShot(algo, inputs[i]);
+    ASSERT_EQ(expect.size(), digest_size);
+    EXPECT_EQ(std::memcmp(out.data() + i * digest_size, expect.data(),
+                          digest_size),
+              0)
+        << "len " << inputs[i].size();
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Algos, BatchHashTest,
+                         testing::Values(HashAlgorithm::SHA256,
+                                         HashAlgorithm::SM3,
+                                         HashAlgorithm::BLAKE2B,
+                                         HashAlgorithm::BLAKE3));
+
+TEST(BatchHashErrorTest, Works) {
+  std::vector<ByteContainerView> views(3);
+  std::vector<uint8_t> out(2 * 32);
+  EXPECT_ANY_THROW(
+      BatchHash(HashAlgorithm::SHA256, views, absl::MakeSpan(out)));
+  EXPECT_ANY_THROW(BatchHashDigestSize(HashAlgorithm::SHA384));
+}
+
+TEST(Sha256MultiTest, MixedLengths) {
+  if (!internal::Sha256MultiSupported()) {
+    GTEST_SKIP() << "no AVX2";
+  }
+  // all pad to 2 blocks.
+  const std::vector<std::string> inputs = {
+      std::string(56, 'a'), std::string(64, 'b'), std::string(100, 'c'),
+      std::string(119, 'd'), std::string(60, 'e'), std::string(70, 'f'),
+      std::string(80, 'g'), std::string(90, 'h')};
+  std::vector<ByteContainerView> views(inputs.begin(), inputs.end());
+  uint8_t out[internal::kSha256Lanes][32];
+  uint8_t* outs[internal::kSha256Lanes];
+  for (size_t i = 0; i < internal::kSha256Lanes; i++) {
+    outs[i] = out[i];
+  }
+  internal::Sha256Multi(views.data(), outs);
+  for (size_t i = 0; i < internal::kSha256Lanes; i++) {
+    auto expect = Sha256(inputs[i]);
+    EXPECT_EQ(std::memcmp(out[i], expect.data(), 32), 0) << i;
+  }
+}
+
+}  // namespace yacl::crypto
@@ -0,0 +1,195 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/crypto/base/hash/sha256_mb.h"
+
+#include <cstring>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "yacl/base/exception.h"
+#include "yacl/utils/platform_utils.h"
+
+namespace yacl::crypto::internal {
+
+#ifdef __AVX2__
+
+namespace {
+
+constexpr uint32_t kK[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr uint32_t kIv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+inline __m256i Rotr(__m256i x, int n) {
+  return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+inline __m256i Add(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+
+inline __m256i Xor3(__m256i a, __m256i b, __m256i c) {
+  return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+// state[8] += compress(state, w[16]), w is message words of every lane.
+void Compress(__m256i* state, __m256i* w) {
+  __m256i a = state[0];
+  __m256i b = state[1];
+  __m256i c = state[2];
+  __m256i d = state[3];
+  __m256i e = state[4];
+  __m256i f = state[5];
+  __m256i g = state[6];
+  __m256i h = state[7];
+  for (int t = 0; t < 64; t++) {
+    __m256i wt;
+    if (t < 16) {
+      wt = w[t];
+    } else {
+      // message schedule in place, w[t % 16] holds w[t - 16].
+      const __m256i w15 = w[(t - 15) & 15];
+      const __m256i w2 = w[(t - 2) & 15];
+      const __m256i s0 =
+          Xor3(Rotr(w15, 7), Rotr(w15, 18), _mm256_srli_epi32(w15, 3));
+      const __m256i s1 =
+          Xor3(Rotr(w2, 17), Rotr(w2, 19), _mm256_srli_epi32(w2, 10));
+      wt = Add(Add(w[t & 15], s0), Add(w[(t - 7) & 15], s1));
+      w[t & 15] = wt;
+    }
+    const __m256i s1 = Xor3(Rotr(e, 6), Rotr(e, 11), Rotr(e, 25));
+    const __m256i ch =
+        _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    const __m256i t1 = Add(Add(Add(h, s1), Add(ch, wt)),
+                           _mm256_set1_epi32(static_cast<int>(kK[t])));
+    const __m256i s0 = Xor3(Rotr(a, 2), Rotr(a, 13), Rotr(a, 22));
+    const __m256i maj = _mm256_or_si256(
+        _mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    const __m256i t2 = Add(s0, maj);
+    h = g;
+    g = f;
+    f = e;
+    e = Add(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = Add(t1, t2);
+  }
+  state[0] = Add(state[0], a);
+  state[1] = Add(state[1], b);
+  state[2] = Add(state[2], c);
+  state[3] = Add(state[3], d);
+  state[4] = Add(state[4], e);
+  state[5] = Add(state[5], f);
+  state[6] = Add(state[6], g);
+  state[7] = Add(state[7], h);
+}
+
+inline uint32_t LoadBe32(const uint8_t* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return __builtin_bswap32(v);
+}
+
+}  // namespace
+
+bool Sha256MultiSupported() { return hasAVX2(); }
+
+void Sha256Multi(const ByteContainerView* inputs, uint8_t* const* outs) {
+  const size_t num_blocks = Sha256PaddedBlocks(inputs[0].size());
+  // padded tail blocks of every lane, at most 2 blocks.
+  alignas(32) uint8_t tails[kSha256Lanes][128];
+  // index of first tail block of every lane.
+  size_t tail_start[kSha256Lanes];
+  for (size_t l = 0; l < kSha256Lanes; l++) {
+    const size_t len = inputs[l].size();
+    YACL_ENFORCE(Sha256PaddedBlocks(len) == num_blocks,
+                 "inputs of Sha256Multi should pad to the same blocks");
+    tail_start[l] = len / 64;
+    const size_t tail_len = len % 64;
+    const size_t tail_blocks = num_blocks - tail_start[l];
+    std::memset(tails[l], 0, tail_blocks * 64);
+    if (tail_len > 0) {
+      std::memcpy(tails[l], inputs[l].data() + tail_start[l] * 64, tail_len);
+    }
+    tails[l][tail_len] = 0x80;
+    const uint64_t bits = static_cast<uint64_t>(len) * 8;
+    for (size_t i = 0; i < 8; i++) {
+      tails[l][tail_blocks * 64 - 1 - i] =
+          static_cast<uint8_t>(bits >> (8 * i));
+    }
+  }
+
+  __m256i state[8];
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = _mm256_set1_epi32(static_cast<int>(kIv[i]));
+  }
+  for (size_t blk = 0; blk < num_blocks; blk++) {
+    const uint8_t* ptrs[kSha256Lanes];
+    for (size_t l = 0; l < kSha256Lanes; l++) {
+      ptrs[l] = blk < tail_start[l]
+                    ? inputs[l].data() + blk * 64
+                    : tails[l] + (blk - tail_start[l]) * 64;
+    }
+    __m256i w[16];
+    for (size_t t = 0; t < 16; t++) {
+      w[t] = _mm256_setr_epi32(
+          static_cast<int>(LoadBe32(ptrs[0] + t * 4)),
+          static_cast<int>(LoadBe32(ptrs[1] + t * 4)),
+          static_cast<int>(LoadBe32(ptrs[2] + t * 4)),
+          static_cast<int>(LoadBe32(ptrs[3] + t * 4)),
+          static_cast<int>(LoadBe32(ptrs[4] + t * 4)),
+          static_cast<int>(LoadBe32(ptrs[5] + t * 4)),
+          static_cast<int>(LoadBe32(ptrs[6] + t * 4)),
+          static_cast<int>(LoadBe32(ptrs[7] + t * 4)));
+    }
+    Compress(state, w);
+  }
+
+  alignas(32) uint32_t words[8][kSha256Lanes];
+  for (size_t i = 0; i < 8; i++) {
+    _mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), state[i]);
+  }
+  for (size_t l = 0; l < kSha256Lanes; l++) {
+    for (size_t i = 0; i < 8; i++) {
+      const uint32_t v = __builtin_bswap32(words[i][l]);
+      std::memcpy(outs[l] + i * 4, &v, sizeof(v));
+    }
+  }
+}
+
+#else
+
+bool Sha256MultiSupported() { return false; }
+
+void Sha256Multi(const ByteContainerView*, uint8_t* const*) {
+  YACL_THROW("Sha256Multi is not supported on this platform");
+}
+
+#endif
+
+}  // namespace yacl::crypto::internal
@@ -0,0 +1,41 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "yacl/base/byte_container_view.h"
+
+namespace yacl::crypto::internal {
+
+// Multi-buffer SHA-256, hashes kSha256Lanes independent inputs at once, one
+// per 32-bit lane of AVX2 registers. For short inputs, where a single stream
+// spends most of its time on per-call setup and the dependency chain of one
+// compression, e.g. 16-64 bytes PSI identifiers.
+
+inline constexpr size_t kSha256Lanes = 8;
+
+// whether Sha256Multi is usable on this cpu, i.e. x86_64 with AVX2.
+bool Sha256MultiSupported();
+
+// number of 64 bytes blocks of input with SHA-256 padding.
+inline size_t Sha256PaddedBlocks(size_t len) { return (len + 8) / 64 + 1; }
+
+// hash kSha256Lanes inputs with the same Sha256PaddedBlocks, digest of
+// inputs[i] (32 bytes) is written to outs[i].
+void Sha256Multi(const ByteContainerView* inputs, uint8_t* const* outs);
+
+}  // namespace yacl::crypto::internal
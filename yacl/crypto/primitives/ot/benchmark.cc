@@ -25,16 +25,20 @@
 namespace yacl::crypto {
 
 void BM_DefaultArguments(benchmark::internal::Benchmark* b) {
-  b->Arg(8192)->Unit(benchmark::kMillisecond)->Iterations(1);
+  b->ArgNames({"num_ot", "net"})
+      ->ArgsProduct({{8192},
+                     {link::test::kNetLocal, link::test::kNetLan,
+                      link::test::kNetWan}})
+      ->Unit(benchmark::kMillisecond)
+      ->Iterations(1);
 }
 
 void BM_PerfArguments(benchmark::internal::Benchmark* b) {
-  b->Arg(1 << 20)  // 1048576, one million
-      ->Arg(1 << 21)
-      ->Arg(1 << 22)
-      ->Arg(1 << 23)
-      ->Arg(1 << 24)
-      ->Arg(1 << 25)
+  b->ArgNames({"num_ot", "net"})
+      ->ArgsProduct({{1 << 20,  // 1048576, one million
+                      1 << 21, 1 << 22, 1 << 23, 1 << 24, 1 << 25},
+                     {link::test::kNetLocal, link::test::kNetLan,
+                      link::test::kNetWan}})
       ->Unit(benchmark::kMillisecond)
       ->Iterations(10);
 }
@@ -15,11 +15,13 @@
 #pragma once
 
 #include <future>
+#include <map>
 #include <memory>
 #include <vector>
 
 #include "absl/numeric/bits.h"
 #include "benchmark/benchmark.h"
+#include "fmt/format.h"
 
 #include "yacl/base/aligned_vector.h"
 #include "yacl/base/exception.h"
@@ -39,19 +41,29 @@
 
 namespace yacl::crypto {
 
+// Benchmark arguments are {num_ot, network}, network selects the emulated
+// network (link::test::BenchNetwork) between sender and receiver.
 class OtBench : public benchmark::Fixture {
  public:
-  void SetUp(const ::benchmark::State&) override {
-    if (lctxs_.empty()) {
-      // lctxs_ = link::test::SetupBrpcWorld(2);
-      lctxs_ = link::test::SetupWorld(2);
+  void SetUp(const ::benchmark::State& state) override {
+    const auto network = state.range(1);
+    auto& lctxs = worlds_[network];
+    if (lctxs.empty()) {
+      // lctxs = link::test::SetupBrpcWorld(2);
+      lctxs = link::test::SetupWorld(fmt::format("ot_bench_{}", network), 2,
+                                     link::test::BenchEmulation(network));
     }
+    lctxs_ = lctxs;
   }
 
   static std::vector<std::shared_ptr<link::Context>> lctxs_;
+  static std::map<int64_t, std::vector<std::shared_ptr<link::Context>>>
+      worlds_;
 };
 
 std::vector<std::shared_ptr<link::Context>> OtBench::lctxs_ = {};
+std::map<int64_t, std::vector<std::shared_ptr<link::Context>>>
+    OtBench::worlds_ = {};
 
 BENCHMARK_DEFINE_F(OtBench, SimplestOT)(benchmark::State& state) {
   YACL_ENFORCE(lctxs_.size() == 2);
@@ -0,0 +1,381 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/crypto/primitives/ot/chosen_ot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "yacl/base/buffer.h"
+#include "yacl/base/exception.h"
+#include "yacl/math/gadget.h"
+#include "yacl/utils/parallel.h"
+
+namespace yacl::crypto {
+
+namespace {
+
+// max number of masked-message bytes in one chunk
+constexpr uint64_t kMaxChunkBytes = 1 << 22;
+
+// grain size of parallel masking
+constexpr int64_t kMaskGrainSize = 1024;
+
+// out = a ^ b, (a, b, out) may alias
+inline void XorBytes(const uint8_t* a, const uint8_t* b, uint8_t* out,
+                     uint64_t n) {
+  uint64_t i = 0;
+#ifdef __AVX2__
+  for (; i + 32 <= n; i += 32) {
+    auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        _mm256_xor_si256(va, vb));
+  }
+#endif
+  for (; i + 8 <= n; i += 8) {
+    uint64_t va;
+    uint64_t vb;
+    std::memcpy(&va, a + i, 8);
+    std::memcpy(&vb, b + i, 8);
+    va ^= vb;
+    std::memcpy(out + i, &va, 8);
+  }
+  for (; i < n; ++i) {
+    out[i] = a[i] ^ b[i];
+  }
+}
+
+inline uint8_t GetBit(const uint8_t* bits, uint64_t idx) {
+  return (bits[idx / 8] >> (idx % 8)) & 1;
+}
+
+// out = in ^ Pad(seed), where Pad(seed) is seed itself (truncated) for short
+// messages, and PRG(seed) otherwise. `pad_buf` should have at least `msg_len`
+// bytes if msg_len > sizeof(uint128_t).
+inline void MaskMessage(uint128_t seed, const uint8_t* in, uint8_t* out,
+                        uint64_t msg_len, absl::Span<uint8_t> pad_buf) {
+  if (msg_len <= sizeof(uint128_t)) {
+    XorBytes(in, reinterpret_cast<const uint8_t*>(&seed), out, msg_len);
+  } else {
+    auto pad = pad_buf.subspan(0, msg_len);
+    PrgAesCtr<uint8_t>(seed, pad);
+    XorBytes(in, pad.data(), out, msg_len);
+  }
+}
+
+// Number of ots in one chunk, always a multiple of 8 so that the correction
+// bits of a chunk start at a byte boundary.
+inline uint64_t GetChunkSize(uint64_t bytes_per_ot) {
+  const uint64_t chunk = kMaxChunkBytes / std::max<uint64_t>(bytes_per_ot, 1);
+  return std::max<uint64_t>(8, chunk / 8 * 8);
+}
+
+// Receiver: send the packed corrections d = b ^ c of the first
+// `choices.size()` ots in chunks of `chunk_size` bits.
+void SendCorrections(const std::shared_ptr<link::Context>& ctx,
+                     const OtRecvStore& ot,
+                     const dynamic_bitset<uint128_t>& choices,
+                     uint64_t chunk_size) {
+  const uint64_t num = choices.size();
+  std::vector<uint8_t> corr(math::DivCeil(num, 8));
+  ot.CopyChoicesTo(absl::MakeSpan(corr));
+  XorBytes(corr.data(), reinterpret_cast<const uint8_t*>(choices.data()),
+           corr.data(), corr.size());
+
+  for (uint64_t begin = 0, i = 0; begin < num; begin += chunk_size, ++i) {
+    const uint64_t size = std::min(chunk_size, num - begin);
+    ctx->SendAsync(ctx->NextRank(),
+                   ByteContainerView(corr.data() + begin / 8,
+                                     math::DivCeil(size, 8)),
+                   fmt::format("ChosenOt:Corr:{}", i));
+  }
+}
+
+// Sender: receive the packed corrections of the i-th chunk.
+Buffer RecvCorrections(const std::shared_ptr<link::Context>& ctx, uint64_t i,
+                       uint64_t size) {
+  auto buf = ctx->Recv(ctx->NextRank(), fmt::format("ChosenOt:Corr:{}", i));
+  YACL_ENFORCE_EQ(static_cast<uint64_t>(buf.size()), math::DivCeil(size, 8),
+                  "unexpected correction size of chunk {}", i);
+  return buf;
+}
+
+}  // namespace
+
+// ------------------------
+//  1-out-of-2, 128 bits
+// ------------------------
+
+void ChosenOtSend(const std::shared_ptr<link::Context>& ctx,
+                  OtSendStore& send_ot,
+                  absl::Span<const std::array<uint128_t, 2>> messages) {
+  ChosenOtSend(
+      ctx, send_ot, sizeof(uint128_t),
+      absl::MakeConstSpan(reinterpret_cast<const uint8_t*>(messages.data()),
+                          messages.size() * 2 * sizeof(uint128_t)));
+}
+
+void ChosenOtRecv(const std::shared_ptr<link::Context>& ctx,
+                  OtRecvStore& recv_ot,
+                  const dynamic_bitset<uint128_t>& choices,
+                  absl::Span<uint128_t> out) {
+  ChosenOtRecv(ctx, recv_ot, choices, sizeof(uint128_t),
+               absl::MakeSpan(reinterpret_cast<uint8_t*>(out.data()),
+                              out.size() * sizeof(uint128_t)));
+}
+
+// ------------------------------------
+//  1-out-of-2, arbitrary message length
+// ------------------------------------
+
+void ChosenOtSend(const std::shared_ptr<link::Context>& ctx,
+                  OtSendStore& send_ot, uint64_t msg_len,
+                  absl::Span<const uint8_t> messages) {
+  YACL_ENFORCE(ctx->WorldSize() == 2);  // Make sure that OT has two parties
+  YACL_ENFORCE(msg_len > 0);
+  YACL_ENFORCE(messages.size() % (2 * msg_len) == 0,
+               "messages size ({}) should be a multiple of 2 * msg_len ({})",
+               messages.size(), 2 * msg_len);
+  const uint64_t num = messages.size() / (2 * msg_len);
+  YACL_ENFORCE(send_ot.Size() >= num,
+               "not enough ots, required: {}, but got: {}", num,
+               send_ot.Size());
+  if (num == 0) {
+    return;
+  }
+  auto ot = send_ot.NextSlice(num);
+
+  const uint64_t chunk_size = GetChunkSize(2 * msg_len);
+  std::vector<uint128_t> keys;
+  for (uint64_t begin = 0, i = 0; begin < num; begin += chunk_size, ++i) {
+    const uint64_t size = std::min(chunk_size, num - begin);
+    auto corr_buf = RecvCorrections(ctx, i, size);
+    const auto* corr = corr_buf.data<const uint8_t>();
+
+    // keys[2 * j + t] = H(k^t_j)
+    keys.resize(2 * size);
+    for (uint64_t j = 0; j < size; ++j) {
+      keys[2 * j] = ot.GetBlock(begin + j, 0);
+      keys[2 * j + 1] = ot.GetBlock(begin + j, 1);
+    }
+    ParaCrHashInplace_128(absl::MakeSpan(keys));
+
+    // y^t_j = x^t_j ^ Pad(H(k^{t ^ d_j}_j))
+    Buffer send_buf(static_cast<int64_t>(size * 2 * msg_len));
+    auto* y = send_buf.data<uint8_t>();
+    const auto* x = messages.data() + begin * 2 * msg_len;
+    parallel_for(0, size, kMaskGrainSize, [&](int64_t b, int64_t e) {
+      std::vector<uint8_t> pad_buf(msg_len > sizeof(uint128_t) ? msg_len : 0);
+      for (int64_t j = b; j < e; ++j) {
+        const uint8_t d = GetBit(corr, j);
+        for (uint8_t t = 0; t < 2; ++t) {
+          const uint64_t offset = (2 * j + t) * msg_len;
+          MaskMessage(keys[2 * j + (t ^ d)], x + offset, y + offset, msg_len,
+                      absl::MakeSpan(pad_buf));
+        }
+      }
+    });
+    ctx->SendAsync(ctx->NextRank(), std::move(send_buf),
+                   fmt::format("ChosenOt:Msg:{}", i));
+  }
+}
+
+void ChosenOtRecv(const std::shared_ptr<link::Context>& ctx,
+                  OtRecvStore& recv_ot,
+                  const dynamic_bitset<uint128_t>& choices, uint64_t msg_len,
+                  absl::Span<uint8_t> out) {
+  YACL_ENFORCE(ctx->WorldSize() == 2);  // Make sure that OT has two parties
+  YACL_ENFORCE(msg_len > 0);
+  const uint64_t num = choices.size();
+  YACL_ENFORCE_EQ(static_cast<uint64_t>(out.size()), num * msg_len);
+  YACL_ENFORCE(recv_ot.Size() >= num,
+               "not enough ots, required: {}, but got: {}", num,
+               recv_ot.Size());
+  if (num == 0) {
+    return;
+  }
+  auto ot = recv_ot.NextSlice(num);
+
+  const uint64_t chunk_size = GetChunkSize(2 * msg_len);
+  SendCorrections(ctx, ot, choices, chunk_size);
+
+  std::vector<uint128_t> keys;
+  for (uint64_t begin = 0, i = 0; begin < num; begin += chunk_size, ++i) {
+    const uint64_t size = std::min(chunk_size, num - begin);
+    auto recv_buf =
+        ctx->Recv(ctx->NextRank(), fmt::format("ChosenOt:Msg:{}", i));
+    YACL_ENFORCE_EQ(static_cast<uint64_t>(recv_buf.size()),
+                    size * 2 * msg_len,
+                    "unexpected message size of chunk {}", i);
+    const auto* y = recv_buf.data<const uint8_t>();
+
+    auto blocks = ot.GetBlocks(begin, size);
+    keys.assign(blocks.begin(), blocks.end());
+    ParaCrHashInplace_128(absl::MakeSpan(keys));
+
+    // x^b_j = y^b_j ^ Pad(H(k^c_j))
+    parallel_for(0, size, kMaskGrainSize, [&](int64_t b, int64_t e) {
+      std::vector<uint8_t> pad_buf(msg_len > sizeof(uint128_t) ? msg_len : 0);
+      for (int64_t j = b; j < e; ++j) {
+        const uint64_t choice = choices[begin + j];
+        MaskMessage(keys[j], y + (2 * j + choice) * msg_len,
+                    out.data() + (begin + j) * msg_len, msg_len,
+                    absl::MakeSpan(pad_buf));
+      }
+    });
+  }
+}
+
+// ------------------------
+//  1-out-of-N, 128 bits
+// ------------------------
+
+uint64_t ChosenOtNHelper(uint64_t n, uint64_t num) {
+  YACL_ENFORCE(n >= 2, "n should be at least 2, but got {}", n);
+  return num * math::Log2Ceil(n);
+}
+
+void ChosenOtNSend(const std::shared_ptr<link::Context>& ctx,
+                   OtSendStore& send_ot, uint64_t n,
+                   absl::Span<const uint128_t> messages) {
+  YACL_ENFORCE(ctx->WorldSize() == 2);  // Make sure that OT has two parties
+  YACL_ENFORCE(n >= 2, "n should be at least 2, but got {}", n);
+  YACL_ENFORCE(messages.size() % n == 0,
+               "messages size ({}) should be a multiple of n ({})",
+               messages.size(), n);
+  const uint64_t num = messages.size() / n;
+  const uint64_t l = math::Log2Ceil(n);
+  YACL_ENFORCE(send_ot.Size() >= num * l,
+               "not enough ots, required: {}, but got: {}", num * l,
+               send_ot.Size());
+  if (num == 0) {
+    return;
+  }
+  auto ot = send_ot.NextSlice(num * l);
+
+  // NOTE a chunk of `chunk_size` instances uses `chunk_size * l` ots, whose
+  // correction bits also start at a byte boundary
+  const uint64_t chunk_size = GetChunkSize(n * sizeof(uint128_t));
+  std::vector<uint128_t> keys;
+  for (uint64_t begin = 0, i = 0; begin < num; begin += chunk_size, ++i) {
+    const uint64_t size = std::min(chunk_size, num - begin);
+    auto corr_buf = RecvCorrections(ctx, i, size * l);
+    const auto* corr = corr_buf.data<const uint8_t>();
+
+    // keys[2 * k + t] = H(k^t_k)
+    keys.resize(2 * size * l);
+    for (uint64_t k = 0; k < size * l; ++k) {
+      keys[2 * k] = ot.GetBlock(begin * l + k, 0);
+      keys[2 * k + 1] = ot.GetBlock(begin * l + k, 1);
+    }
+    ParaCrHashInplace_128(absl::MakeSpan(keys));
+
+    // y^j = x^j ^ (XOR_t H(keys[t, j_t ^ d_t] ^ j))
+    Buffer send_buf(static_cast<int64_t>(size * n * sizeof(uint128_t)));
+    auto* y = send_buf.data<uint128_t>();
+    const auto* x = messages.data() + begin * n;
+    const int64_t grain_size = std::max<int64_t>(1, kMaskGrainSize / n);
+    parallel_for(0, size, grain_size, [&](int64_t b, int64_t e) {
+      std::vector<uint128_t> pads(n * l);
+      for (int64_t idx = b; idx < e; ++idx) {
+        const uint64_t base = idx * l;
+        for (uint64_t j = 0; j < n; ++j) {
+          for (uint64_t t = 0; t < l; ++t) {
+            const uint8_t bit = ((j >> t) & 1) ^ GetBit(corr, base + t);
+            pads[j * l + t] = keys[2 * (base + t) + bit] ^ uint128_t(j);
+          }
+        }
+        ParaCrHashInplace_128(absl::MakeSpan(pads));
+        for (uint64_t j = 0; j < n; ++j) {
+          uint128_t pad = 0;
+          for (uint64_t t = 0; t < l; ++t) {
+            pad ^= pads[j * l + t];
+          }
+          y[idx * n + j] = x[idx * n + j] ^ pad;
+        }
+      }
+    });
+    ctx->SendAsync(ctx->NextRank(), std::move(send_buf),
+                   fmt::format("ChosenOt:Msg:{}", i));
+  }
+}
+
+void ChosenOtNRecv(const std::shared_ptr<link::Context>& ctx,
+                   OtRecvStore& recv_ot, uint64_t n,
+                   absl::Span<const uint64_t> choices,
+                   absl::Span<uint128_t> out) {
+  YACL_ENFORCE(ctx->WorldSize() == 2);  // Make sure that OT has two parties
+  YACL_ENFORCE(n >= 2, "n should be at least 2, but got {}", n);
+  const uint64_t num = choices.size();
+  const uint64_t l = math::Log2Ceil(n);
+  YACL_ENFORCE_EQ(static_cast<uint64_t>(out.size()), num);
+  YACL_ENFORCE(recv_ot.Size() >= num * l,
+               "not enough ots, required: {}, but got: {}", num * l,
+               recv_ot.Size());
+  if (num == 0) {
+    return;
+  }
+  auto ot = recv_ot.NextSlice(num * l);
+
+  // decompose the choices into bits
+  dynamic_bitset<uint128_t> choice_bits(num * l);
+  for (uint64_t idx = 0; idx < num; ++idx) {
+    YACL_ENFORCE(choices[idx] < n, "choice ({}) should be less than n ({})",
+                 choices[idx], n);
+    for (uint64_t t = 0; t < l; ++t) {
+      choice_bits[idx * l + t] = (choices[idx] >> t) & 1;
+    }
+  }
+
+  const uint64_t chunk_size = GetChunkSize(n * sizeof(uint128_t));
+  SendCorrections(ctx, ot, choice_bits, chunk_size * l);
+
+  std::vector<uint128_t> keys;
+  for (uint64_t begin = 0, i = 0; begin < num; begin += chunk_size, ++i) {
+    const uint64_t size = std::min(chunk_size, num - begin);
+    auto recv_buf =
+        ctx->Recv(ctx->NextRank(), fmt::format("ChosenOt:Msg:{}", i));
+    YACL_ENFORCE_EQ(static_cast<uint64_t>(recv_buf.size()),
+                    size * n * sizeof(uint128_t),
+                    "unexpected message size of chunk {}", i);
+    const auto* y = recv_buf.data<const uint128_t>();
+
+    // keys[k] = H(k^c_k) ^ b, where b is the choice of the instance
+    auto blocks = ot.GetBlocks(begin * l, size * l);
+    keys.assign(blocks.begin(), blocks.end());
+    ParaCrHashInplace_128(absl::MakeSpan(keys));
+    for (uint64_t idx = 0; idx < size; ++idx) {
+      for (uint64_t t = 0; t < l; ++t) {
+        keys[idx * l + t] ^= static_cast<uint128_t>(choices[begin + idx]);
+      }
+    }
+    ParaCrHashInplace_128(absl::MakeSpan(keys));
+
+    for (uint64_t idx = 0; idx < size; ++idx) {
+      uint128_t pad = 0;
+      for (uint64_t t = 0; t < l; ++t) {
+        pad ^= keys[idx * l + t];
+      }
+      out[begin + idx] = y[idx * n + choices[begin + idx]] ^ pad;
+    }
+  }
+}
+
+}  // namespace yacl::crypto
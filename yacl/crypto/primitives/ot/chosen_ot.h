@@ -0,0 +1,113 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "absl/types/span.h"
+
+#include "yacl/base/dynamic_bitset.h"
+#include "yacl/base/int128.h"
+#include "yacl/crypto/primitives/ot/ot_store.h"
+#include "yacl/link/context.h"
+
+/* submodules */
+#include "yacl/crypto/tools/crhash.h"
+#include "yacl/crypto/tools/prg.h"
+
+namespace yacl::crypto {
+
+// Chosen-message OT from random/correlated OT (a.k.a. derandomization)
+//
+// Reference: Precomputing Oblivious Transfer, https://link.springer.com/
+// chapter/10.1007/3-540-44750-4_8 (Beaver95)
+//
+//              +---------+    +----------------+
+//              | ROT/COT | => | chosen-msg OT  |
+//              +---------+    +----------------+
+//
+//  > The receiver sends d = b ^ c for each ot, where b is the desired choice
+//    and c is the choice of the (random) ot.
+//  > The sender sends y_j = x_j ^ H(k_{j ^ d}) for j = 0, 1, where k_0, k_1
+//    are the messages of the (random) ot and H is the correlation-robust hash
+//    (`CrHash_128`), so both rot and cot (normal or compact) stores are
+//    supported.
+//  > Messages longer than 128 bits are masked with PRG(H(k)), see
+//    `yacl/crypto/tools/prg.h`.
+//
+// The 1-out-of-N version consumes log2(N) ots for each instance, the j-th
+// message is masked by XOR_t H(H(k^t_{j_t ^ d_t}) ^ j), where j_t is the t-th
+// bit of j (see https://eprint.iacr.org/2013/491.pdf, Sec 4.1 for the idea).
+//
+// All correction bits and masked messages are packed into large contiguous
+// buffers and streamed in chunks, so the sender could start as soon as the
+// first chunk of corrections arrives.
+//
+// NOTE
+//  * The ots are consumed from the given store with `NextSlice`, so both
+//    parties should have their stores sliced in the same way.
+//  * Both parties should agree on the number of ots (and message length).
+//
+
+// ------------------------
+//  1-out-of-2, 128 bits
+// ------------------------
+
+void ChosenOtSend(const std::shared_ptr<link::Context>& ctx,
+                  OtSendStore& send_ot,
+                  absl::Span<const std::array<uint128_t, 2>> messages);
+
+void ChosenOtRecv(const std::shared_ptr<link::Context>& ctx,
+                  OtRecvStore& recv_ot,
+                  const dynamic_bitset<uint128_t>& choices,
+                  absl::Span<uint128_t> out);
+
+// ------------------------------------
+//  1-out-of-2, arbitrary message length
+// ------------------------------------
+
+// messages: num * 2 * msg_len bytes, where the j-th message of the i-th ot is
+// messages[(2 * i + j) * msg_len, (2 * i + j + 1) * msg_len)
+void ChosenOtSend(const std::shared_ptr<link::Context>& ctx,
+                  OtSendStore& send_ot, uint64_t msg_len,
+                  absl::Span<const uint8_t> messages);
+
+// out: num * msg_len bytes, where num = choices.size()
+void ChosenOtRecv(const std::shared_ptr<link::Context>& ctx,
+                  OtRecvStore& recv_ot,
+                  const dynamic_bitset<uint128_t>& choices, uint64_t msg_len,
+                  absl::Span<uint8_t> out);
+
+// ------------------------
+//  1-out-of-N, 128 bits
+// ------------------------
+
+// messages: num * n blocks, where the j-th message of the i-th ot is
+// messages[i * n + j]
+void ChosenOtNSend(const std::shared_ptr<link::Context>& ctx,
+                   OtSendStore& send_ot, uint64_t n,
+                   absl::Span<const uint128_t> messages);
+
+// choices: num choices, each choice should be in [0, n)
+void ChosenOtNRecv(const std::shared_ptr<link::Context>& ctx,
+                   OtRecvStore& recv_ot, uint64_t n,
+                   absl::Span<const uint64_t> choices,
+                   absl::Span<uint128_t> out);
+
+// get the number of (1-out-of-2) ots consumed by `num` 1-out-of-n ots
+uint64_t ChosenOtNHelper(uint64_t n, uint64_t num);
+
+}  // namespace yacl::crypto
@@ -0,0 +1,179 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/crypto/primitives/ot/chosen_ot.h"
+
+#include <cstring>
+#include <future>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "yacl/base/dynamic_bitset.h"
+#include "yacl/base/exception.h"
+#include "yacl/base/int128.h"
+#include "yacl/crypto/primitives/ot/ot_store.h"
+#include "yacl/crypto/utils/rand.h"
+#include "yacl/link/test_util.h"
+
+namespace yacl::crypto {
+
+struct TestParams {
+  unsigned num;
+};
+
+class ChosenOtTest : public ::testing::TestWithParam<TestParams> {};
+
+TEST_P(ChosenOtTest, RotWorks) {
+  // GIVEN
+  const int kWorldSize = 2;
+  const size_t num = GetParam().num;
+  auto lctxs = link::test::SetupWorld(kWorldSize);
+  auto rot = MockRots(num);
+  auto choices = RandBits<dynamic_bitset<uint128_t>>(num);
+  std::vector<std::array<uint128_t, 2>> messages(num);
+  for (auto& msg : messages) {
+    msg = {FastRandU128(), FastRandU128()};
+  }
+  std::vector<uint128_t> out(num);
+
+  // WHEN
+  auto sender = std::async([&] {
+    ChosenOtSend(lctxs[0], rot.send, absl::MakeConstSpan(messages));
+  });
+  auto receiver = std::async([&] {
+    ChosenOtRecv(lctxs[1], rot.recv, choices, absl::MakeSpan(out));
+  });
+  sender.get();
+  receiver.get();
+
+  // THEN
+  for (size_t i = 0; i < num; ++i) {
+    EXPECT_EQ(out[i], messages[i][choices[i]]);
+  }
+  EXPECT_EQ(rot.send.Size(), 0);  // all ots are consumed
+  EXPECT_EQ(rot.recv.Size(), 0);
+}
+
+TEST_P(ChosenOtTest, CompactCotWorks) {
+  // GIVEN
+  const int kWorldSize = 2;
+  const size_t num = GetParam().num;
+  auto lctxs = link::test::SetupWorld(kWorldSize);
+  auto cot = MockCompactOts(num);
+  auto choices = RandBits<dynamic_bitset<uint128_t>>(num);
+  std::vector<std::array<uint128_t, 2>> messages(num);
+  for (auto& msg : messages) {
+    msg = {FastRandU128(), FastRandU128()};
+  }
+  std::vector<uint128_t> out(num);
+
+  // WHEN
+  auto sender = std::async([&] {
+    ChosenOtSend(lctxs[0], cot.send, absl::MakeConstSpan(messages));
+  });
+  auto receiver = std::async([&] {
+    ChosenOtRecv(lctxs[1], cot.recv, choices, absl::MakeSpan(out));
+  });
+  sender.get();
+  receiver.get();
+
+  // THEN
+  for (size_t i = 0; i < num; ++i) {
+    EXPECT_EQ(out[i], messages[i][choices[i]]);
+  }
+}
+
+TEST_P(ChosenOtTest, BytesWorks) {
+  // GIVEN
+  const int kWorldSize = 2;
+  const size_t num = GetParam().num;
+  auto lctxs = link::test::SetupWorld(kWorldSize);
+
+  for (uint64_t msg_len : {1, 5, 16, 33, 100}) {
+    auto rot = MockRots(num);
+    auto choices = RandBits<dynamic_bitset<uint128_t>>(num);
+    auto messages = RandVec<uint8_t>(num * 2 * msg_len);
+    std::vector<uint8_t> out(num * msg_len);
+
+    // WHEN
+    auto sender = std::async([&] {
+      ChosenOtSend(lctxs[0], rot.send, msg_len, absl::MakeConstSpan(messages));
+    });
+    auto receiver = std::async([&] {
+      ChosenOtRecv(lctxs[1], rot.recv, choices, msg_len, absl::MakeSpan(out));
+    });
+    sender.get();
+    receiver.get();
+
+    // THEN
+    for (size_t i = 0; i < num; ++i) {
+      EXPECT_EQ(std::memcmp(out.data() + i * msg_len,
+                            messages.data() + (2 * i + choices[i]) * msg_len,
+                            msg_len),
+                0);
+    }
+  }
+}
+
+TEST_P(ChosenOtTest, OneOutOfNWorks) {
+  // GIVEN
+  const int kWorldSize = 2;
+  const size_t num = GetParam().num;
+  auto lctxs = link::test::SetupWorld(kWorldSize);
+
+  for (uint64_t n : {2, 3, 16, 100}) {
+    auto rot = MockRots(ChosenOtNHelper(n, num));
+    auto messages = RandVec<uint128_t>(num * n);
+    std::vector<uint64_t> choices(num);
+    for (auto& choice : choices) {
+      choice = FastRandU64() % n;
+    }
+    std::vector<uint128_t> out(num);
+
+    // WHEN
+    auto sender = std::async([&] {
+      ChosenOtNSend(lctxs[0], rot.send, n, absl::MakeConstSpan(messages));
+    });
+    auto receiver = std::async([&] {
+      ChosenOtNRecv(lctxs[1], rot.recv, n, absl::MakeConstSpan(choices),
+                    absl::MakeSpan(out));
+    });
+    sender.get();
+    receiver.get();
+
+    // THEN
+    for (size_t i = 0; i < num; ++i) {
+      EXPECT_EQ(out[i], messages[i * n + choices[i]]);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Works_Instances, ChosenOtTest,
+                         testing::Values(TestParams{1},     //
+                                         TestParams{9},     //
+                                         TestParams{1000},  //
+                                         TestParams{1 << 15}));
+
+TEST(ChosenOtEdgeTest, NotEnoughOtsThrow) {
+  auto lctxs = link::test::SetupWorld(2);
+  auto rot = MockRots(10);
+  auto choices = RandBits<dynamic_bitset<uint128_t>>(11);
+  std::vector<uint128_t> out(11);
+
+  EXPECT_THROW(ChosenOtRecv(lctxs[1], rot.recv, choices, absl::MakeSpan(out)),
+               ::yacl::Exception);
+}
+
+}  // namespace yacl::crypto
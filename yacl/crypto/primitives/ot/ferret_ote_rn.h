@@ -43,16 +43,10 @@ inline void MpCotRNSend(const std::shared_ptr<link::Context>& ctx,
   const auto batch_size = full_size / batch_num;
   const auto last_size = full_size - (batch_num - 1) * batch_size;
 
-  // for each bin, call single-point cot
-  for (uint64_t i = 0; i < batch_num; ++i) {
-    const uint64_t this_size = (i == batch_num - 1) ? last_size : batch_size;
-    const auto& cot_slice =
-        cot.Slice(i * math::Log2Ceil(batch_size),
-                  i * math::Log2Ceil(batch_size) + math::Log2Ceil(this_size));
-
-    GywzOtExtSend_ferret(ctx, cot_slice, this_size,
-                         out.subspan(i * batch_size, this_size));
-  }
+  // for each bin, call single-point cot (all bins are expanded together)
+  std::vector<uint32_t> sizes(batch_num, batch_size);
+  sizes.back() = last_size;
+  GywzOtExtSendBatch_ferret(ctx, cot, absl::MakeConstSpan(sizes), out);
 }
 
 inline void MpCotRNRecv(const std::shared_ptr<link::Context>& ctx,
@@ -63,15 +57,10 @@ inline void MpCotRNRecv(const std::shared_ptr<link::Context>& ctx,
   const auto batch_size = full_size / batch_num;
   const auto last_size = full_size - (batch_num - 1) * batch_size;
 
-  // for each bin, call single-point cot
-  for (uint64_t i = 0; i < batch_num; ++i) {
-    const uint64_t this_size = (i == batch_num - 1) ? last_size : batch_size;
-    const auto cot_slice =
-        cot.Slice(i * math::Log2Ceil(batch_size),
-                  i * math::Log2Ceil(batch_size) + math::Log2Ceil(this_size));
-    GywzOtExtRecv_ferret(ctx, cot_slice, this_size,
-                         out.subspan(i * batch_size, this_size));
-  }
+  // for each bin, call single-point cot (all bins are expanded together)
+  std::vector<uint32_t> sizes(batch_num, batch_size);
+  sizes.back() = last_size;
+  GywzOtExtRecvBatch_ferret(ctx, cot, absl::MakeConstSpan(sizes), out);
 }
 
 }  // namespace yacl::crypto
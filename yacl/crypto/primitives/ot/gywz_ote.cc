@@ -14,13 +14,16 @@
 
 #include "yacl/crypto/primitives/ot/gywz_ote.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 
 #include "yacl/base/aligned_vector.h"
 #include "yacl/base/byte_container_view.h"
 #include "yacl/base/dynamic_bitset.h"
 #include "yacl/base/exception.h"
 #include "yacl/math/gadget.h"
+#include "yacl/utils/parallel.h"
 
 namespace yacl::crypto {
 
@@ -41,6 +44,12 @@ void CggmFullEval(uint128_t delta, uint128_t seed, uint32_t n,
   // first level
   seed &= one;
   delta &= one;
+  if (height == 0) {
+    // zero-depth tree (n == 1), the only leaf is punctured, so it is delta
+    // (sum of all leaves) and no cot is consumed
+    all_msgs[0] = delta;
+    return;
+  }
   uint32_t prev_size = 1;
   working_seeds[0] = seed;
   working_seeds[1] = seed ^ delta;
@@ -89,6 +98,12 @@ void CggmPuncFullEval(uint32_t index, absl::Span<const uint128_t> sibling_sums,
   bool is_two_power = (n == (static_cast<uint32_t>(1) << (height)));
   auto& working_seeds = punctured_msgs;
 
+  if (height == 0) {
+    // zero-depth tree (n == 1), see CggmFullEval
+    punctured_msgs[0] = 0;
+    return;
+  }
+
   //  first level
   uint32_t prev_size = 1;
   uint32_t& mask = prev_size;
@@ -132,6 +147,244 @@ void CggmPuncFullEval(uint32_t index, absl::Span<const uint128_t> sibling_sums,
            (n - prev_size) * sizeof(uint128_t));
   }
 }
+
+// Number of trees expanded together (level by level) in one task
+constexpr uint32_t kTreeBatch = 8;
+// Levels with fewer nodes (per tree) than this are hashed across all trees of
+// a task in one call, so that AES is always called with enough blocks
+constexpr uint32_t kGatherLimit = 64;
+
+// Layout of a batch of trees: the i-th tree has ns[i] leaves stored at
+// output[leaf_offsets[i], leaf_offsets[i] + ns[i]), and consumes heights[i]
+// cots starting from ot_offsets[i]. A tree with ns[i] == 1 has zero depth and
+// consumes no cot.
+struct TreeBatchLayout {
+  std::vector<uint32_t> heights;
+  std::vector<uint64_t> leaf_offsets;
+  std::vector<uint64_t> ot_offsets;
+  uint64_t leaf_num = 0;
+  uint64_t ot_num = 0;
+
+  explicit TreeBatchLayout(absl::Span<const uint32_t> ns) {
+    heights.resize(ns.size());
+    leaf_offsets.resize(ns.size());
+    ot_offsets.resize(ns.size());
+    for (size_t i = 0; i < ns.size(); ++i) {
+      YACL_ENFORCE_GE(ns[i], (uint32_t)1);
+      heights[i] = math::Log2Ceil(ns[i]);
+      leaf_offsets[i] = leaf_num;
+      ot_offsets[i] = ot_num;
+      leaf_num += ns[i];
+      ot_num += heights[i];
+    }
+  }
+};
+
+// Working space of one tree in a level-synchronous expansion
+struct TreeWorkspace {
+  absl::Span<uint128_t> leaves;
+  uint32_t n;
+  uint32_t height;
+  // the right half of the last level, if leaves can not hold all of them
+  AlignedVector<uint128_t> extra_buff;
+
+  // get the right side of the given level (prev_size = 1 << level)
+  absl::Span<uint128_t> RightSide(uint32_t level, uint32_t prev_size) {
+    if (level == height - 1 && n != (static_cast<uint32_t>(1) << height)) {
+      extra_buff.resize(prev_size);
+      return absl::MakeSpan(extra_buff);
+    }
+    return leaves.subspan(prev_size, prev_size);
+  }
+
+  // copy the right side leaves back to leaves
+  void Finalize() {
+    if (!extra_buff.empty()) {
+      const uint32_t half = static_cast<uint32_t>(1) << (height - 1);
+      memcpy(leaves.data() + half, extra_buff.data(),
+             (n - half) * sizeof(uint128_t));
+    }
+  }
+};
+
+// Perform Ccrhash on the left sides of the given level for all active trees.
+// Small levels are gathered into one buffer to batch the AES calls.
+void HashLeftSides(std::vector<TreeWorkspace>& trees, uint32_t level,
+                   uint32_t prev_size, AlignedVector<uint128_t>& gather_buff) {
+  if (prev_size >= kGatherLimit) {
+    for (auto& tree : trees) {
+      if (tree.height > level) {
+        ParaCcrHashInplace_128(tree.leaves.subspan(0, prev_size));
+      }
+    }
+    return;
+  }
+  gather_buff.resize(trees.size() * prev_size);
+  uint64_t pos = 0;
+  for (auto& tree : trees) {
+    if (tree.height > level) {
+      memcpy(gather_buff.data() + pos, tree.leaves.data(),
+             prev_size * sizeof(uint128_t));
+      pos += prev_size;
+    }
+  }
+  ParaCcrHashInplace_128(absl::MakeSpan(gather_buff.data(), pos));
+  pos = 0;
+  for (auto& tree : trees) {
+    if (tree.height > level) {
+      memcpy(tree.leaves.data(), gather_buff.data() + pos,
+             prev_size * sizeof(uint128_t));
+      pos += prev_size;
+    }
+  }
+}
+
+// Level-synchronous version of CggmFullEval for trees [begin, end)
+void CggmFullEvalGroup(uint128_t delta, absl::Span<const uint128_t> seeds,
+                       absl::Span<const uint32_t> ns,
+                       const TreeBatchLayout& layout, uint64_t begin,
+                       uint64_t end, absl::Span<uint128_t> all_msgs,
+                       absl::Span<uint128_t> all_left_sums,
+                       uint128_t one = Uint128Max()) {
+  std::vector<TreeWorkspace> trees(end - begin);
+  uint32_t max_height = 0;
+  delta &= one;
+  for (uint64_t i = begin; i < end; ++i) {
+    auto& tree = trees[i - begin];
+    tree.n = ns[i];
+    tree.height = layout.heights[i];
+    tree.leaves = all_msgs.subspan(layout.leaf_offsets[i], ns[i]);
+    max_height = std::max(max_height, tree.height);
+
+    if (tree.height == 0) {
+      // zero-depth tree, see CggmFullEval
+      tree.leaves[0] = delta;
+      continue;
+    }
+    // first level
+    const uint128_t seed = seeds[i] & one;
+    tree.leaves[0] = seed;
+    tree.leaves[1] = seed ^ delta;
+    all_left_sums[layout.ot_offsets[i]] = seed;
+  }
+
+  AlignedVector<uint128_t> gather_buff;
+  uint32_t prev_size = 1;
+  for (uint32_t level = 1; level < max_height; ++level) {
+    // the number of node in next level should be double
+    prev_size <<= 1;
+    // copy previous seeds into right side
+    for (auto& tree : trees) {
+      if (tree.height > level) {
+        memcpy(tree.RightSide(level, prev_size).data(), tree.leaves.data(),
+               prev_size * sizeof(uint128_t));
+      }
+    }
+    // perform Ccrhash(x)
+    HashLeftSides(trees, level, prev_size, gather_buff);
+    // G(x) = Ccrhash(x) || x ^ Ccrhash(x)
+    for (uint64_t i = begin; i < end; ++i) {
+      auto& tree = trees[i - begin];
+      if (tree.height <= level) {
+        continue;
+      }
+      auto left_side = tree.leaves.subspan(0, prev_size);
+      auto right_side = tree.RightSide(level, prev_size);
+      uint128_t left_side_sum = 0;
+      for (uint32_t j = 0; j < prev_size; ++j) {
+        left_side[j] &= one;
+        right_side[j] ^= left_side[j];
+        left_side_sum ^= left_side[j];
+      }
+      all_left_sums[layout.ot_offsets[i] + level] = left_side_sum;
+    }
+  }
+  for (auto& tree : trees) {
+    tree.Finalize();
+  }
+}
+
+// Level-synchronous version of CggmPuncFullEval for trees [begin, end)
+void CggmPuncFullEvalGroup(absl::Span<const uint32_t> indexes,
+                           absl::Span<const uint128_t> all_sibling_sums,
+                           absl::Span<const uint32_t> ns,
+                           const TreeBatchLayout& layout, uint64_t begin,
+                           uint64_t end, absl::Span<uint128_t> all_msgs,
+                           uint128_t one = Uint128Max()) {
+  std::vector<TreeWorkspace> trees(end - begin);
+  std::vector<uint32_t> punctured_idxs(end - begin);
+  uint32_t max_height = 0;
+  for (uint64_t i = begin; i < end; ++i) {
+    auto& tree = trees[i - begin];
+    tree.n = ns[i];
+    tree.height = layout.heights[i];
+    tree.leaves = all_msgs.subspan(layout.leaf_offsets[i], ns[i]);
+    max_height = std::max(max_height, tree.height);
+
+    if (tree.height == 0) {
+      // zero-depth tree, see CggmFullEval
+      tree.leaves[0] = 0;
+      continue;
+    }
+    //  first level
+    const uint128_t sum = all_sibling_sums[layout.ot_offsets[i]] & one;
+    tree.leaves[0] = sum;
+    tree.leaves[1] = sum;
+    punctured_idxs[i - begin] = indexes[i] & 1;
+  }
+
+  AlignedVector<uint128_t> gather_buff;
+  uint32_t prev_size = 1;
+  for (uint32_t level = 1; level < max_height; ++level) {
+    // the number of seeds in next level
+    prev_size <<= 1;
+    // copy previous seeds into right side
+    for (auto& tree : trees) {
+      if (tree.height > level) {
+        memcpy(tree.RightSide(level, prev_size).data(), tree.leaves.data(),
+               prev_size * sizeof(uint128_t));
+      }
+    }
+    // perform Ccrhash(x)
+    HashLeftSides(trees, level, prev_size, gather_buff);
+    // G(x) = Ccrhash(x) || x ^ Ccrhash(x)
+    for (uint64_t i = begin; i < end; ++i) {
+      auto& tree = trees[i - begin];
+      if (tree.height <= level) {
+        continue;
+      }
+      auto left_side = tree.leaves.subspan(0, prev_size);
+      auto right_side = tree.RightSide(level, prev_size);
+      uint128_t left_side_sum = all_sibling_sums[layout.ot_offsets[i] + level];
+      for (uint32_t j = 0; j < prev_size; ++j) {
+        left_side[j] &= one;
+        left_side_sum ^= left_side[j];
+        right_side[j] ^= left_side[j];
+      }
+      auto& punctured_idx = punctured_idxs[i - begin];
+      left_side[punctured_idx] ^= left_side_sum;
+      right_side[punctured_idx] ^= left_side_sum;
+      // update punctured index
+      punctured_idx |= indexes[i] & prev_size;
+    }
+  }
+  for (auto& tree : trees) {
+    tree.Finalize();
+  }
+}
+
+// Expand all trees, `kTreeBatch` trees per task, tasks run in parallel
+template <typename F>
+void ForEachTreeGroup(uint64_t tree_num, F&& func) {
+  const auto group_num =
+      static_cast<int64_t>(math::DivCeil(tree_num, kTreeBatch));
+  parallel_for(0, group_num, 1, [&](int64_t beg, int64_t end) {
+    for (int64_t g = beg; g < end; ++g) {
+      func(g * kTreeBatch, std::min<uint64_t>((g + 1) * kTreeBatch, tree_num));
+    }
+  });
+}
+
 }  // namespace
 
 void GywzOtExtRecv(const std::shared_ptr<link::Context>& ctx,
@@ -320,4 +573,149 @@ void GywzOtExtSend_fixed_index(const OtSendStore& cot, uint32_t n,
   }
 }
 
+// --------------------------
+//          Batched
+// --------------------------
+
+void GywzOtExtRecvBatch(const std::shared_ptr<link::Context>& ctx,
+                        const OtRecvStore& cot, absl::Span<const uint32_t> ns,
+                        absl::Span<const uint32_t> indexes,
+                        absl::Span<uint128_t> output) {
+  const TreeBatchLayout layout(ns);
+  YACL_ENFORCE(cot.Size() >= layout.ot_num);
+  YACL_ENFORCE(indexes.size() == ns.size());
+  YACL_ENFORCE(output.size() >= layout.leaf_num);
+
+  // Convert indexes into ot choices
+  dynamic_bitset<uint128_t> masked_choice(layout.ot_num);
+  for (size_t i = 0; i < ns.size(); ++i) {
+    YACL_ENFORCE_GT(ns[i], indexes[i]);
+    const auto offset = layout.ot_offsets[i];
+    for (uint32_t j = 0; j < layout.heights[i]; ++j) {
+      masked_choice[offset + j] =
+          ((indexes[i] >> j) & 1) ^ cot.GetChoice(offset + j);
+    }
+  }
+  ctx->SendAsync(
+      ctx->NextRank(),
+      ByteContainerView(masked_choice.data(),
+                        masked_choice.num_blocks() * sizeof(uint128_t)),
+      "GYWZ_OTE: batch choice");
+
+  // receive punctured seeds thought cot, one message for all trees
+  auto recv_buf = ctx->Recv(ctx->NextRank(), "GYWZ_OTE: batch message");
+  YACL_ENFORCE(recv_buf.size() ==
+               static_cast<int64_t>(layout.ot_num * sizeof(uint128_t)));
+  AlignedVector<uint128_t> sibling_sums(layout.ot_num);
+  memcpy(sibling_sums.data(), recv_buf.data(), recv_buf.size());
+  for (uint64_t i = 0; i < layout.ot_num; ++i) {
+    sibling_sums[i] ^= cot.GetBlock(i);
+  }
+
+  ForEachTreeGroup(ns.size(), [&](uint64_t begin, uint64_t end) {
+    CggmPuncFullEvalGroup(indexes, absl::MakeConstSpan(sibling_sums), ns,
+                          layout, begin, end, output);
+  });
+}
+
+void GywzOtExtSendBatch(const std::shared_ptr<link::Context>& ctx,
+                        const OtSendStore& cot, absl::Span<const uint32_t> ns,
+                        absl::Span<uint128_t> output) {
+  const TreeBatchLayout layout(ns);
+  YACL_ENFORCE(cot.Size() >= layout.ot_num);
+  YACL_ENFORCE(output.size() >= layout.leaf_num);
+
+  // get delta from cot
+  uint128_t delta = cot.GetDelta();
+  auto seeds = RandVec<uint128_t>(ns.size());
+  AlignedVector<uint128_t> left_sums(layout.ot_num);
+  ForEachTreeGroup(ns.size(), [&](uint64_t begin, uint64_t end) {
+    CggmFullEvalGroup(delta, absl::MakeConstSpan(seeds), ns, layout, begin,
+                      end, output, absl::MakeSpan(left_sums));
+  });
+
+  dynamic_bitset<uint128_t> masked_choice(layout.ot_num);
+  auto recv_buf = ctx->Recv(ctx->NextRank(), "GYWZ_OTE: batch choice");
+  YACL_ENFORCE(recv_buf.size() ==
+               static_cast<int64_t>(masked_choice.num_blocks() *
+                                    sizeof(uint128_t)));
+  memcpy(masked_choice.data(), recv_buf.data(), recv_buf.size());
+
+  for (uint64_t i = 0; i < layout.ot_num; ++i) {
+    left_sums[i] ^= cot.GetBlock(i, 1 - masked_choice[i]);
+  }
+  ctx->SendAsync(
+      ctx->NextRank(),
+      ByteContainerView(left_sums.data(), sizeof(uint128_t) * layout.ot_num),
+      "GYWZ_OTE: batch message");
+}
+
+void GywzOtExtRecvBatch_ferret(const std::shared_ptr<link::Context>& ctx,
+                               const OtRecvStore& cot,
+                               absl::Span<const uint32_t> ns,
+                               absl::Span<uint128_t> output) {
+  const TreeBatchLayout layout(ns);
+  YACL_ENFORCE(cot.Size() >= layout.ot_num);
+  YACL_ENFORCE(cot.Type() == OtStoreType::Compact);
+  YACL_ENFORCE(output.size() >= layout.leaf_num);
+
+  std::vector<uint32_t> indexes(ns.size(), 0);
+  for (size_t i = 0; i < ns.size(); ++i) {
+    for (uint32_t j = 0; j < layout.heights[i]; ++j) {
+      indexes[i] |= (cot.GetChoice(layout.ot_offsets[i] + j)) << j;
+    }
+  }
+  uint128_t one = MakeUint128(0xffffffffffffffff, 0xfffffffffffffffe);
+
+  auto recv_buf = ctx->Recv(ctx->NextRank(), "GYWZ_OTE: batch messages");
+  YACL_ENFORCE(recv_buf.size() ==
+               static_cast<int64_t>(layout.ot_num * sizeof(uint128_t)));
+  AlignedVector<uint128_t> sibling_sums(layout.ot_num);
+  memcpy(sibling_sums.data(), recv_buf.data(), recv_buf.size());
+  for (uint64_t i = 0; i < layout.ot_num; ++i) {
+    sibling_sums[i] ^= (cot.GetBlock(i) & one);
+  }
+
+  ForEachTreeGroup(ns.size(), [&](uint64_t begin, uint64_t end) {
+    CggmPuncFullEvalGroup(absl::MakeConstSpan(indexes),
+                          absl::MakeConstSpan(sibling_sums), ns, layout, begin,
+                          end, output, one);
+    // notice: "index" may be greater than n
+    for (uint64_t i = begin; i < end; ++i) {
+      if (ns[i] > indexes[i]) {
+        output[layout.leaf_offsets[i] + indexes[i]] |= ~one;
+      }
+    }
+  });
+}
+
+void GywzOtExtSendBatch_ferret(const std::shared_ptr<link::Context>& ctx,
+                               const OtSendStore& cot,
+                               absl::Span<const uint32_t> ns,
+                               absl::Span<uint128_t> output) {
+  const TreeBatchLayout layout(ns);
+  YACL_ENFORCE(cot.Size() >= layout.ot_num);
+  YACL_ENFORCE(cot.Type() == OtStoreType::Compact);
+  YACL_ENFORCE(output.size() >= layout.leaf_num);
+
+  // get delta from cot
+  uint128_t one = MakeUint128(0xffffffffffffffff, 0xfffffffffffffffe);
+  uint128_t delta = cot.GetDelta() & one;
+  auto seeds = RandVec<uint128_t>(ns.size());
+
+  AlignedVector<uint128_t> left_sums(layout.ot_num);
+  ForEachTreeGroup(ns.size(), [&](uint64_t begin, uint64_t end) {
+    CggmFullEvalGroup(delta, absl::MakeConstSpan(seeds), ns, layout, begin,
+                      end, output, absl::MakeSpan(left_sums), one);
+  });
+
+  for (uint64_t i = 0; i < layout.ot_num; ++i) {
+    left_sums[i] ^= (cot.GetBlock(i, 1) & one);
+  }
+  ctx->SendAsync(
+      ctx->NextRank(),
+      ByteContainerView(left_sums.data(), sizeof(uint128_t) * layout.ot_num),
+      "GYWZ_OTE: batch messages");
+}
+
 }  // namespace yacl::crypto
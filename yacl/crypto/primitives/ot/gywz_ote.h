@@ -61,6 +61,46 @@ void GywzOtExtSend(const std::shared_ptr<link::Context>& ctx,
                    const OtSendStore& cot, uint32_t n,
                    absl::Span<uint128_t> output);
 
+// --------------------------
+//          Batched
+// --------------------------
+//
+// Batched GYWZ OT Extension, which runs `ns.size()` single-point cots at once.
+//
+//  > The i-th tree has ns[i] >= 1 leaves, and consumes Log2Ceil(ns[i]) cots.
+//    Cots are consumed continuously, i.e. the i-th tree uses the cots starting
+//    from sum_{j < i} Log2Ceil(ns[j]).
+//  > A tree with one leaf consumes no cot: the leaf is punctured, the sender
+//    gets delta and the receiver gets 0 (1 for ferret).
+//  > The leaves of the i-th tree are written to output continuously, i.e.
+//    output[sum_{j < i} ns[j], sum_{j <= i} ns[j]).
+//  > All trees are expanded level by level (level-synchronous), such that the
+//    small levels of different trees are hashed (AES) together. Groups of
+//    trees are expanded in parallel.
+//  > Only one message is sent in each direction for all trees, instead of one
+//    round trip per tree.
+//
+void GywzOtExtRecvBatch(const std::shared_ptr<link::Context>& ctx,
+                        const OtRecvStore& cot, absl::Span<const uint32_t> ns,
+                        absl::Span<const uint32_t> indexes,
+                        absl::Span<uint128_t> output);
+
+void GywzOtExtSendBatch(const std::shared_ptr<link::Context>& ctx,
+                        const OtSendStore& cot, absl::Span<const uint32_t> ns,
+                        absl::Span<uint128_t> output);
+
+// [Warning] For ferretOTe only, batched version of "GywzOtExtRecv_ferret"
+void GywzOtExtRecvBatch_ferret(const std::shared_ptr<link::Context>& ctx,
+                               const OtRecvStore& cot,
+                               absl::Span<const uint32_t> ns,
+                               absl::Span<uint128_t> output);
+
+// [Warning] For ferretOTe only, batched version of "GywzOtExtSend_ferret"
+void GywzOtExtSendBatch_ferret(const std::shared_ptr<link::Context>& ctx,
+                               const OtSendStore& cot,
+                               absl::Span<const uint32_t> ns,
+                               absl::Span<uint128_t> output);
+
 // --------------------------
 //         Customized
 // --------------------------
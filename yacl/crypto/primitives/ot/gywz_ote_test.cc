@@ -16,6 +16,7 @@
 
 #include <future>
 #include <thread>
+#include <vector>
 
 #include "fmt/format.h"
 #include "gtest/gtest.h"
@@ -147,6 +148,188 @@ TEST_P(GywzParamTest, FixIndexSpCotWork) {
   }
 }
 
+TEST_P(GywzParamTest, BatchCotWork) {
+  const uint32_t n = GetParam().n;
+  const uint32_t last_n = n + 3;
+  const uint32_t tree_num = 20;
+
+  auto lctxs = link::test::SetupWorld(2);
+  uint128_t delta = SecureRandSeed();
+
+  std::vector<uint32_t> ns(tree_num, n);
+  ns.back() = last_n;
+  std::vector<uint32_t> indexes(tree_num);
+  uint64_t ot_num = 0;
+  uint64_t total_n = 0;
+  for (uint32_t i = 0; i < tree_num; ++i) {
+    indexes[i] = RandInRange(ns[i]);
+    ot_num += math::Log2Ceil(ns[i]);
+    total_n += ns[i];
+  }
+  auto base_ot = MockCots(ot_num, delta);  // mock many base OTs
+
+  std::vector<uint128_t> send_out(total_n);
+  std::vector<uint128_t> recv_out(total_n);
+
+  std::future<void> sender = std::async([&] {
+    GywzOtExtRecvBatch(lctxs[0], base_ot.recv, absl::MakeConstSpan(ns),
+                       absl::MakeConstSpan(indexes), absl::MakeSpan(recv_out));
+  });
+  std::future<void> receiver = std::async([&] {
+    GywzOtExtSendBatch(lctxs[1], base_ot.send, absl::MakeConstSpan(ns),
+                       absl::MakeSpan(send_out));
+  });
+  sender.get();
+  receiver.get();
+
+  uint64_t offset = 0;
+  for (uint32_t t = 0; t < tree_num; ++t) {
+    for (uint32_t i = 0; i < ns[t]; ++i) {
+      EXPECT_NE(recv_out[offset + i], 0);
+      EXPECT_NE(send_out[offset + i], 0);
+      if (indexes[t] != i) {
+        EXPECT_EQ(send_out[offset + i], recv_out[offset + i]);
+      } else {
+        EXPECT_EQ(send_out[offset + i] ^ delta, recv_out[offset + i]);
+      }
+    }
+    offset += ns[t];
+  }
+}
+
+TEST_P(GywzParamTest, BatchFerretSpCotWork) {
+  const uint32_t n = GetParam().n;
+  const uint32_t tree_num = 20;
+  const uint32_t height = math::Log2Ceil(n);
+
+  auto lctxs = link::test::SetupWorld(2);
+
+  std::vector<uint32_t> ns(tree_num, n);
+  auto base_ot = MockCompactOts(height * tree_num);  // mock many base OTs
+  auto delta = base_ot.send.GetDelta();
+
+  std::vector<uint128_t> send_out(n * tree_num);
+  std::vector<uint128_t> recv_out(n * tree_num);
+
+  std::future<void> sender = std::async([&] {
+    GywzOtExtRecvBatch_ferret(lctxs[0], base_ot.recv, absl::MakeConstSpan(ns),
+                              absl::MakeSpan(recv_out));
+  });
+  std::future<void> receiver = std::async([&] {
+    GywzOtExtSendBatch_ferret(lctxs[1], base_ot.send, absl::MakeConstSpan(ns),
+                              absl::MakeSpan(send_out));
+  });
+  sender.get();
+  receiver.get();
+
+  for (uint32_t t = 0; t < tree_num; ++t) {
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < height; ++i) {
+      index |= (base_ot.recv.GetChoice(t * height + i)) << i;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+      if (index != i) {
+        EXPECT_EQ(send_out[t * n + i], recv_out[t * n + i]);
+      } else {
+        EXPECT_EQ(send_out[t * n + i] ^ delta, recv_out[t * n + i]);
+      }
+    }
+  }
+}
+
+TEST(GywzBatchTest, SingleLeafTrees) {
+  // heterogeneous trees, including zero-depth ones
+  const std::vector<uint32_t> ns = {1, 5, 1, 2, 1, 8, 3};
+  const uint32_t tree_num = ns.size();
+
+  auto lctxs = link::test::SetupWorld(2);
+  uint128_t delta = SecureRandSeed();
+
+  std::vector<uint32_t> indexes(tree_num);
+  uint64_t ot_num = 0;
+  uint64_t total_n = 0;
+  for (uint32_t i = 0; i < tree_num; ++i) {
+    indexes[i] = RandInRange(ns[i]);
+    ot_num += math::Log2Ceil(ns[i]);
+    total_n += ns[i];
+  }
+  auto base_ot = MockCots(ot_num, delta);  // mock many base OTs
+
+  std::vector<uint128_t> send_out(total_n);
+  std::vector<uint128_t> recv_out(total_n);
+
+  std::future<void> sender = std::async([&] {
+    GywzOtExtRecvBatch(lctxs[0], base_ot.recv, absl::MakeConstSpan(ns),
+                       absl::MakeConstSpan(indexes), absl::MakeSpan(recv_out));
+  });
+  std::future<void> receiver = std::async([&] {
+    GywzOtExtSendBatch(lctxs[1], base_ot.send, absl::MakeConstSpan(ns),
+                       absl::MakeSpan(send_out));
+  });
+  sender.get();
+  receiver.get();
+
+  uint64_t offset = 0;
+  for (uint32_t t = 0; t < tree_num; ++t) {
+    for (uint32_t i = 0; i < ns[t]; ++i) {
+      if (indexes[t] != i) {
+        EXPECT_EQ(send_out[offset + i], recv_out[offset + i]);
+      } else {
+        EXPECT_EQ(send_out[offset + i] ^ delta, recv_out[offset + i]);
+      }
+    }
+    offset += ns[t];
+  }
+}
+
+TEST(GywzBatchTest, SingleLeafTreesFerret) {
+  const std::vector<uint32_t> ns = {1, 4, 1, 3};
+  const uint32_t tree_num = ns.size();
+
+  auto lctxs = link::test::SetupWorld(2);
+
+  std::vector<uint64_t> ot_offsets(tree_num);
+  uint64_t ot_num = 0;
+  uint64_t total_n = 0;
+  for (uint32_t i = 0; i < tree_num; ++i) {
+    ot_offsets[i] = ot_num;
+    ot_num += math::Log2Ceil(ns[i]);
+    total_n += ns[i];
+  }
+  auto base_ot = MockCompactOts(ot_num);  // mock many base OTs
+  auto delta = base_ot.send.GetDelta();
+
+  std::vector<uint128_t> send_out(total_n);
+  std::vector<uint128_t> recv_out(total_n);
+
+  std::future<void> sender = std::async([&] {
+    GywzOtExtRecvBatch_ferret(lctxs[0], base_ot.recv, absl::MakeConstSpan(ns),
+                              absl::MakeSpan(recv_out));
+  });
+  std::future<void> receiver = std::async([&] {
+    GywzOtExtSendBatch_ferret(lctxs[1], base_ot.send, absl::MakeConstSpan(ns),
+                              absl::MakeSpan(send_out));
+  });
+  sender.get();
+  receiver.get();
+
+  uint64_t offset = 0;
+  for (uint32_t t = 0; t < tree_num; ++t) {
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < math::Log2Ceil(ns[t]); ++i) {
+      index |= (base_ot.recv.GetChoice(ot_offsets[t] + i)) << i;
+    }
+    for (uint32_t i = 0; i < ns[t]; ++i) {
+      if (index != i) {
+        EXPECT_EQ(send_out[offset + i], recv_out[offset + i]);
+      } else {
+        EXPECT_EQ(send_out[offset + i] ^ delta, recv_out[offset + i]);
+      }
+    }
+    offset += ns[t];
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(TestWork, GywzParamTest,
                          testing::Values(TestParams{2},        // edge
                                          TestParams{3},        //
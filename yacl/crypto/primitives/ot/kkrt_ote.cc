@@ -22,8 +22,13 @@
 #include "yacl/base/byte_container_view.h"
 #include "yacl/base/int128.h"
 #include "yacl/utils/matrix_utils.h"
+#include "yacl/utils/parallel.h"
 #include "yacl/utils/serialize.h"
 
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
 namespace yacl::crypto {
 namespace {
 
@@ -38,6 +43,11 @@ constexpr int kBatchSize1024 = 1024;
 constexpr int kNumBlockPerBatch1024 = kBatchSize1024 / kKappa;
 constexpr int kPrgBatchSize1024 = kBatchSize * kNumBlockPerBatch1024;
 static_assert(kBatchSize1024 % kKappa == 0);
+// How many inputs are encoded together in `BatchEval`, 8 inputs * 4 keys gives
+// 32 independent AES pipelines which is enough to hide the AES-NI latency.
+constexpr size_t kPrcBatchSize = 8;
+// Grain size for `ParallelBatchEval`.
+constexpr int64_t kParallelEvalGrainSize = 4096;
 
 // Pseudorandom coding initialization
 inline void PrcInit(const std::shared_ptr<link::Context>& ctx,
@@ -60,8 +70,50 @@ void Prc(AES_KEY* aes_key, uint128_t input, KkrtRow* prc) {
   }
 }
 
+// Apply Pseudorandom coding on a batch of inputs (at most kPrcBatchSize), the
+// i-th encoded row is written to prc[i].
+void PrcBatch(AES_KEY* aes_key, absl::Span<const uint128_t> inputs,
+              KkrtRow* prc) {
+  // aes_blocks[w * kPrcBatchSize + i] = Enc(k_w, inputs[i])
+  std::array<uint128_t, kKkrtWidth * kPrcBatchSize> aes_blocks{};
+  for (size_t w = 0; w < kKkrtWidth; ++w) {
+    std::copy(inputs.begin(), inputs.end(),
+              aes_blocks.begin() + w * kPrcBatchSize);
+  }
+  ParaEnc<kKkrtWidth, kPrcBatchSize>(aes_blocks.data(), aes_key);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    for (size_t w = 0; w < kKkrtWidth; ++w) {
+      // aes(x) xor x, Correlation Roustness Hash
+      prc[i][w] = aes_blocks[w * kPrcBatchSize + i] ^ inputs[i];
+    }
+  }
+}
+
 }  // namespace
 
+void IGroupPRF::BatchEval(absl::Span<const size_t> group_idxs,
+                          absl::Span<const uint128_t> inputs,
+                          absl::Span<uint128_t> out) {
+  YACL_ENFORCE(group_idxs.size() == inputs.size() &&
+               inputs.size() == out.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    out[i] = Eval(group_idxs[i], inputs[i]);
+  }
+}
+
+void IGroupPRF::ParallelBatchEval(absl::Span<const size_t> group_idxs,
+                                  absl::Span<const uint128_t> inputs,
+                                  absl::Span<uint128_t> out) {
+  YACL_ENFORCE(group_idxs.size() == inputs.size() &&
+               inputs.size() == out.size());
+  parallel_for(0, inputs.size(), kParallelEvalGrainSize,
+               [&](int64_t begin, int64_t end) {
+                 const size_t n = end - begin;
+                 BatchEval(group_idxs.subspan(begin, n),
+                           inputs.subspan(begin, n), out.subspan(begin, n));
+               });
+}
+
 class KkrtGroupPRF : public IGroupPRF {
  public:
   explicit KkrtGroupPRF(const std::shared_ptr<link::Context>& ctx, size_t n,
@@ -107,6 +159,55 @@ class KkrtGroupPRF : public IGroupPRF {
     std::memcpy(outbuf, tmp.data(), bufsize);
   }
 
+  // Same as `Eval(group_idx, input)`, but the pseudorandom codes of
+  // kPrcBatchSize inputs are computed together with pipelined AES, and
+  // `(c(r) & s) ^ q` is computed in 256-bit registers when AVX is available.
+  void BatchEval(absl::Span<const size_t> group_idxs,
+                 absl::Span<const uint128_t> inputs,
+                 absl::Span<uint128_t> out) override {
+    YACL_ENFORCE(group_idxs.size() == inputs.size() &&
+                 inputs.size() == out.size());
+    const size_t num = inputs.size();
+
+#ifdef __AVX__
+    // KkrtRow (512 bits) = two 256-bit lanes, AVX only provides bitwise
+    // operations on 256-bit float vectors, which is fine for AND/XOR.
+    const auto* s_ptr = reinterpret_cast<const float*>(s_.data());
+    const __m256 s_lo = _mm256_loadu_ps(s_ptr);
+    const __m256 s_hi = _mm256_loadu_ps(s_ptr + 8);
+#endif
+
+    std::array<KkrtRow, kPrcBatchSize> prc;
+    for (size_t offset = 0; offset < num; offset += kPrcBatchSize) {
+      const size_t num_this_batch = std::min(kPrcBatchSize, num - offset);
+      for (size_t i = 0; i < num_this_batch; ++i) {
+        YACL_ENFORCE_LT(group_idxs[offset + i], size_);
+      }
+      PrcBatch(aes_key_, inputs.subspan(offset, num_this_batch), prc.data());
+
+      for (size_t i = 0; i < num_this_batch; ++i) {
+        const auto& q = q_[group_idxs[offset + i]];
+#ifdef __AVX__
+        auto* prc_ptr = reinterpret_cast<float*>(prc[i].data());
+        const auto* q_ptr = reinterpret_cast<const float*>(q.data());
+        __m256 lo = _mm256_and_ps(_mm256_loadu_ps(prc_ptr), s_lo);
+        __m256 hi = _mm256_and_ps(_mm256_loadu_ps(prc_ptr + 8), s_hi);
+        lo = _mm256_xor_ps(lo, _mm256_loadu_ps(q_ptr));
+        hi = _mm256_xor_ps(hi, _mm256_loadu_ps(q_ptr + 8));
+        _mm256_storeu_ps(prc_ptr, lo);
+        _mm256_storeu_ps(prc_ptr + 8, hi);
+#else
+        for (size_t w = 0; w < kKkrtWidth; ++w) {
+          prc[i][w] &= s_[w];
+          prc[i][w] ^= q[w];
+        }
+#endif
+        out[offset + i] =
+            RO_Blake3_128(ByteContainerView(prc[i].data(), sizeof(KkrtRow)));
+      }
+    }
+  }
+
   template <size_t N>
   void SetQ(const std::array<KkrtRow, N>& q, size_t offset, size_t num_valid) {
     YACL_ENFORCE(num_valid <= q.size() && offset + num_valid <= this->Size());
@@ -75,6 +75,21 @@ class IGroupPRF {
   virtual void Eval(size_t group_idx, uint128_t input, uint8_t* buf,
                     size_t bufsize) = 0;
 
+  // Evaluate `inputs[i]` with PRF `group_idxs[i]`, the i-th result is written
+  // to `out[i]`. The default implementation simply calls `Eval` in a loop,
+  // implementations are encouraged to override it with a faster one.
+  virtual void BatchEval(absl::Span<const size_t> group_idxs,
+                         absl::Span<const uint128_t> inputs,
+                         absl::Span<uint128_t> out);
+
+  // Parallel version of `BatchEval`, the inputs are split into chunks and
+  // evaluated with `yacl::parallel_for`.
+  //
+  // NOTE `BatchEval` must be thread-safe for the underlying implementation.
+  void ParallelBatchEval(absl::Span<const size_t> group_idxs,
+                         absl::Span<const uint128_t> inputs,
+                         absl::Span<uint128_t> out);
+
   virtual size_t Size() const = 0;
 };
 
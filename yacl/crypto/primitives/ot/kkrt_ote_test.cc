@@ -78,6 +78,62 @@ INSTANTIATE_TEST_SUITE_P(Works_Instances, KkrtOtExtTest,
                                          TestParams{4096},  //
                                          TestParams{65536}));
 
+TEST(KkrtOtExtBatchEvalTest, Works) {
+  // GIVEN
+  const int kWorldSize = 2;
+  auto contexts = link::test::SetupWorld(kWorldSize);
+  auto base_ot = MockRots(512);
+
+  const size_t num_ot = 1000;
+  const size_t num_eval = 10007;  // not a multiple of any batch size
+  std::vector<uint128_t> recv_out(num_ot);
+  std::vector<uint128_t> inputs(num_ot);
+  Prg<uint128_t> prg;
+  std::generate(inputs.begin(), inputs.end(),
+                [&]() -> uint128_t { return prg(); });
+
+  std::future<std::unique_ptr<IGroupPRF>> sender = std::async(
+      [&] { return KkrtOtExtSend(contexts[0], base_ot.recv, num_ot); });
+  std::future<void> receiver = std::async([&] {
+    KkrtOtExtRecv(contexts[1], base_ot.send, inputs, absl::MakeSpan(recv_out));
+  });
+  receiver.get();
+  auto encoder = sender.get();
+
+  std::vector<size_t> group_idxs(num_eval);
+  std::vector<uint128_t> eval_inputs(num_eval);
+  for (size_t i = 0; i < num_eval; ++i) {
+    group_idxs[i] = (i * 7) % num_ot;
+    // half of the inputs hit the receiver's choices
+    eval_inputs[i] = (i % 2 == 0) ? inputs[group_idxs[i]] : prg();
+  }
+
+  // WHEN
+  std::vector<uint128_t> batch_out(num_eval);
+  std::vector<uint128_t> parallel_out(num_eval);
+  encoder->BatchEval(group_idxs, eval_inputs, absl::MakeSpan(batch_out));
+  encoder->ParallelBatchEval(group_idxs, eval_inputs,
+                             absl::MakeSpan(parallel_out));
+
+  // THEN
+  for (size_t i = 0; i < num_eval; ++i) {
+    EXPECT_EQ(batch_out[i], encoder->Eval(group_idxs[i], eval_inputs[i]));
+    EXPECT_EQ(parallel_out[i], batch_out[i]);
+    if (i % 2 == 0) {
+      EXPECT_EQ(batch_out[i], recv_out[group_idxs[i]]);
+    }
+  }
+
+  // Mismatched size / out of range group index.
+  EXPECT_THROW(encoder->BatchEval(absl::MakeSpan(group_idxs).subspan(1),
+                                  eval_inputs, absl::MakeSpan(batch_out)),
+               yacl::Exception);
+  group_idxs[0] = num_ot;
+  EXPECT_THROW(
+      encoder->BatchEval(group_idxs, eval_inputs, absl::MakeSpan(batch_out)),
+      yacl::Exception);
+}
+
 TEST(KkrtOtExtEdgeTest, Test) {
   // GIVEN
   const int kWorldSize = 2;
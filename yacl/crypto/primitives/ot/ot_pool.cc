@@ -0,0 +1,323 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/crypto/primitives/ot/ot_pool.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "yacl/base/aligned_vector.h"
+#include "yacl/base/dynamic_bitset.h"
+#include "yacl/crypto/primitives/ot/ferret_ote.h"
+#include "yacl/crypto/primitives/ot/iknp_ote.h"
+#include "yacl/crypto/primitives/ot/softspoken_ote.h"
+#include "yacl/crypto/utils/rand.h"
+
+namespace yacl::crypto {
+
+namespace {
+
+// Concatenate multiple ot stores into a new one (by copy)
+OtSendStore ConcatOtStores(const std::vector<OtSendStore>& parts,
+                           uint64_t num) {
+  YACL_ENFORCE(!parts.empty());
+  const auto type = parts[0].Type();
+  for (const auto& part : parts) {
+    YACL_ENFORCE(part.Type() == type);
+    YACL_ENFORCE(part.HasDelta() == parts[0].HasDelta());
+  }
+
+  uint64_t idx = 0;
+  if (type == OtStoreType::Compact) {
+    AlignedVector<uint128_t> blocks(num);
+    for (const auto& part : parts) {
+      for (uint64_t i = 0; i < part.Size(); ++i) {
+        blocks[idx++] = part.GetBlock(i, 0);
+      }
+    }
+    YACL_ENFORCE_EQ(idx, num);
+    return MakeCompactOtSendStore(std::move(blocks), parts[0].GetDelta());
+  }
+
+  AlignedVector<std::array<uint128_t, 2>> blocks(num);
+  for (const auto& part : parts) {
+    for (uint64_t i = 0; i < part.Size(); ++i) {
+      blocks[idx][0] = part.GetBlock(i, 0);
+      blocks[idx][1] = part.GetBlock(i, 1);
+      ++idx;
+    }
+  }
+  YACL_ENFORCE_EQ(idx, num);
+  auto out = MakeOtSendStore(blocks);
+  if (parts[0].HasDelta()) {
+    out.SetDelta(parts[0].GetDelta());
+  }
+  return out;
+}
+
+// Concatenate multiple ot stores into a new one (by copy)
+OtRecvStore ConcatOtStores(const std::vector<OtRecvStore>& parts,
+                           uint64_t num) {
+  YACL_ENFORCE(!parts.empty());
+  const auto type = parts[0].Type();
+  for (const auto& part : parts) {
+    YACL_ENFORCE(part.Type() == type);
+  }
+
+  // NOTE in compact mode, the choice bits are stored in the blocks
+  uint64_t idx = 0;
+  AlignedVector<uint128_t> blocks(num);
+  dynamic_bitset<uint128_t> choices;
+  if (type == OtStoreType::Normal) {
+    choices.resize(num);
+  }
+  for (const auto& part : parts) {
+    for (uint64_t i = 0; i < part.Size(); ++i) {
+      blocks[idx] = part.GetBlock(i);
+      if (type == OtStoreType::Normal) {
+        choices[idx] = part.GetChoice(i);
+      }
+      ++idx;
+    }
+  }
+  YACL_ENFORCE_EQ(idx, num);
+
+  if (type == OtStoreType::Compact) {
+    return MakeCompactOtRecvStore(std::move(blocks));
+  }
+  return MakeOtRecvStore(choices, blocks);
+}
+
+}  // namespace
+
+template <typename StoreT>
+OtPool<StoreT>::OtPool(const std::shared_ptr<link::Context>& ctx,
+                       Generator generator, const OtPoolOptions& options)
+    : options_(options), generator_(std::move(generator)) {
+  YACL_ENFORCE(ctx->WorldSize() == 2);  // Make sure that OT has two parties
+  YACL_ENFORCE(options_.batch_size > 0);
+  YACL_ENFORCE(options_.low_watermark > 0);
+  YACL_ENFORCE(options_.low_watermark <= options_.high_watermark,
+               "low watermark ({}) should be no greater than high watermark "
+               "({})",
+               options_.low_watermark, options_.high_watermark);
+  YACL_ENFORCE(generator_ != nullptr);
+
+  // NOTE Spawn is not thread-safe, so we call it in the caller's thread. Both
+  // parties should create their pools in the same order to get the same
+  // context id.
+  ctx_ = ctx->Spawn();
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ScheduleRefill(0);
+  }
+  worker_ = std::thread([this] { Work(); });
+}
+
+template <typename StoreT>
+OtPool<StoreT>::~OtPool() {
+  Stop();
+}
+
+template <typename StoreT>
+void OtPool<StoreT>::Stop() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+template <typename StoreT>
+uint64_t OtPool<StoreT>::Available() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return available_;
+}
+
+template <typename StoreT>
+uint64_t OtPool<StoreT>::Scheduled() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return available_ + pending_rounds_ * options_.batch_size;
+}
+
+template <typename StoreT>
+void OtPool<StoreT>::ScheduleRefill(uint64_t demand) {
+  // NOTE the scheduled number only depends on the sequence of `Acquire`, so
+  // that both parties always schedule the same refill rounds.
+  uint64_t scheduled = available_ + pending_rounds_ * options_.batch_size;
+  if (scheduled >= demand + options_.low_watermark) {
+    return;
+  }
+  while (scheduled < demand + options_.high_watermark) {
+    ++pending_rounds_;
+    scheduled += options_.batch_size;
+  }
+  cond_.notify_all();
+}
+
+template <typename StoreT>
+void OtPool<StoreT>::Work() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [&] { return stop_ || pending_rounds_ > 0; });
+      // finish all scheduled rounds before stopping, since the peer would
+      // also run them
+      if (pending_rounds_ == 0) {
+        return;
+      }
+    }
+
+    try {
+      auto store = generator_(ctx_, options_.batch_size);
+      YACL_ENFORCE_EQ(store.Size(), options_.batch_size,
+                      "OT generator returns unexpected number of ots");
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        chunks_.push_back({std::move(store), options_.batch_size});
+        available_ += options_.batch_size;
+        --pending_rounds_;
+      }
+    } catch (...) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      error_ = std::current_exception();
+      pending_rounds_ = 0;
+      stop_ = true;
+      cond_.notify_all();
+      return;
+    }
+    cond_.notify_all();
+  }
+}
+
+template <typename StoreT>
+StoreT OtPool<StoreT>::Acquire(uint64_t num) {
+  YACL_ENFORCE(num > 0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  YACL_ENFORCE(!stop_, "OtPool has been stopped");
+
+  ScheduleRefill(num);
+  cond_.wait(lock, [&] { return available_ >= num || error_; });
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  available_ -= num;
+
+  // fast path: the first chunk has enough ots, no copy is needed
+  if (chunks_.front().left >= num) {
+    auto& chunk = chunks_.front();
+    auto out = chunk.store.NextSlice(num);
+    chunk.left -= num;
+    if (chunk.left == 0) {
+      chunks_.pop_front();
+    }
+    return out;
+  }
+
+  // slow path: concatenate slices from multiple chunks
+  std::vector<StoreT> parts;
+  uint64_t left = num;
+  while (left > 0) {
+    auto& chunk = chunks_.front();
+    const uint64_t slice_num = std::min(left, chunk.left);
+    parts.push_back(chunk.store.NextSlice(slice_num));
+    chunk.left -= slice_num;
+    left -= slice_num;
+    if (chunk.left == 0) {
+      chunks_.pop_front();
+    }
+  }
+  lock.unlock();
+
+  return ConcatOtStores(parts, num);
+}
+
+template class OtPool<OtSendStore>;
+template class OtPool<OtRecvStore>;
+
+// --------------------------
+//         Generators
+// --------------------------
+
+OtSendPool::Generator MakeIknpOtSendGenerator(const OtRecvStore& base_ot,
+                                              bool cot) {
+  return [base_ot, cot](const std::shared_ptr<link::Context>& ctx,
+                        uint64_t num) {
+    return IknpOtExtSend(ctx, base_ot, num, cot);
+  };
+}
+
+OtRecvPool::Generator MakeIknpOtRecvGenerator(const OtSendStore& base_ot,
+                                              bool cot) {
+  return [base_ot, cot](const std::shared_ptr<link::Context>& ctx,
+                        uint64_t num) {
+    auto choices = RandBits<dynamic_bitset<uint128_t>>(num);
+    return IknpOtExtRecv(ctx, base_ot, choices, num, cot);
+  };
+}
+
+OtSendPool::Generator MakeSoftspokenOtSendGenerator(uint64_t k, bool cot) {
+  auto sender = std::make_shared<SoftspokenOtExtSender>(k);
+  return [sender, cot](const std::shared_ptr<link::Context>& ctx,
+                       uint64_t num) {
+    sender->OneTimeSetup(ctx);  // only runs in the first round
+    return cot ? sender->GenCot(ctx, num) : sender->GenRot(ctx, num);
+  };
+}
+
+OtRecvPool::Generator MakeSoftspokenOtRecvGenerator(uint64_t k, bool cot) {
+  auto receiver = std::make_shared<SoftspokenOtExtReceiver>(k);
+  return [receiver, cot](const std::shared_ptr<link::Context>& ctx,
+                         uint64_t num) {
+    receiver->OneTimeSetup(ctx);  // only runs in the first round
+    return cot ? receiver->GenCot(ctx, num) : receiver->GenRot(ctx, num);
+  };
+}
+
+OtSendPool::Generator MakeFerretOtSendGenerator(const OtSendStore& base_cot,
+                                                const LpnParam& lpn_param) {
+  YACL_ENFORCE(base_cot.Type() == OtStoreType::Compact);
+  auto base = std::make_shared<OtSendStore>(base_cot);
+  return [base, lpn_param](const std::shared_ptr<link::Context>& ctx,
+                           uint64_t num) {
+    const uint64_t cot_num = FerretCotHelper(lpn_param, num);
+    auto out = FerretOtExtSend(ctx, *base, lpn_param, num + cot_num);
+    *base = out.NextSlice(cot_num);  // bootstrap: base cots for next round
+    return out.NextSlice(num);
+  };
+}
+
+OtRecvPool::Generator MakeFerretOtRecvGenerator(const OtRecvStore& base_cot,
+                                                const LpnParam& lpn_param) {
+  YACL_ENFORCE(base_cot.Type() == OtStoreType::Compact);
+  auto base = std::make_shared<OtRecvStore>(base_cot);
+  return [base, lpn_param](const std::shared_ptr<link::Context>& ctx,
+                           uint64_t num) {
+    const uint64_t cot_num = FerretCotHelper(lpn_param, num);
+    auto out = FerretOtExtRecv(ctx, *base, lpn_param, num + cot_num);
+    *base = out.NextSlice(cot_num);  // bootstrap: base cots for next round
+    return out.NextSlice(num);
+  };
+}
+
+}  // namespace yacl::crypto
@@ -0,0 +1,159 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "yacl/base/exception.h"
+#include "yacl/crypto/primitives/ot/ot_store.h"
+#include "yacl/crypto/utils/secparam.h"
+#include "yacl/link/context.h"
+
+namespace yacl::crypto {
+
+// OT Pool
+//
+// An OT pool wraps an OT extension protocol (a.k.a. the generator) and keeps a
+// number of ready-to-use ots in memory, so that the online phase of a protocol
+// does not have to run a full extension round synchronously when it runs out
+// of ots. The refill rounds are executed by a background thread on a dedicated
+// link context (spawned from the user's context with `Context::Spawn`).
+//
+//       Acquire(n)        +---------------------------+
+//   <---------------------|  ready ots (OtStore list) |<---- refill thread
+//                         +---------------------------+      (generator)
+//                         ^                           ^
+//                   low watermark             high watermark
+//
+// Refill policy: whenever the number of scheduled (ready or in-flight) ots
+// drops below `low_watermark`, refill rounds of `batch_size` ots are scheduled
+// until it reaches `high_watermark`. `Acquire(n)` only blocks if there are less
+// than n ready ots.
+//
+// NOTE
+//  * Refill rounds are scheduled only by the constructor and by `Acquire`,
+//    hence both parties MUST call `Acquire` with the same sequence of sizes.
+//    This keeps the refill rounds of both parties in sync without any extra
+//    control message.
+//  * `Acquire` is thread-safe, but the order of concurrent `Acquire` calls has
+//    to be the same on both sides.
+//  * `Stop()` (or the destructor) waits for all scheduled refill rounds, which
+//    requires the peer's pool to be alive.
+//
+struct OtPoolOptions {
+  // number of ots generated by one refill round
+  uint64_t batch_size = 1 << 20;
+  // refill is triggered when scheduled ots drop below this value
+  uint64_t low_watermark = 1 << 20;
+  // refill stops when scheduled ots reach this value
+  uint64_t high_watermark = 1 << 22;
+};
+
+template <typename StoreT>
+class OtPool {
+ public:
+  // A generator runs one round of ot extension with the given context and
+  // returns exactly `num` ots.
+  using Generator = std::function<StoreT(
+      const std::shared_ptr<link::Context>& ctx, uint64_t num)>;
+
+  OtPool(const std::shared_ptr<link::Context>& ctx, Generator generator,
+         const OtPoolOptions& options = {});
+
+  ~OtPool();
+
+  OtPool(const OtPool&) = delete;
+  OtPool& operator=(const OtPool&) = delete;
+
+  // Take `num` ots from the pool, blocks if there are not enough ready ots.
+  // The returned store shares the underlying buffer with the pool whenever
+  // possible, and is copied otherwise.
+  StoreT Acquire(uint64_t num);
+
+  // Stop the refill thread after all scheduled rounds are finished.
+  void Stop();
+
+  // get the number of ready ots
+  uint64_t Available() const;
+
+  // get the number of ready and in-flight ots
+  uint64_t Scheduled() const;
+
+  const OtPoolOptions& GetOptions() const { return options_; }
+
+ private:
+  // schedule refill rounds, requires mutex_ to be held
+  void ScheduleRefill(uint64_t demand);
+
+  // refill thread
+  void Work();
+
+  struct Chunk {
+    StoreT store;
+    uint64_t left;
+  };
+
+  const OtPoolOptions options_;
+  const Generator generator_;
+  std::shared_ptr<link::Context> ctx_;  // dedicated context for refill rounds
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<Chunk> chunks_;     // ready ots
+  uint64_t available_ = 0;       // number of ready ots
+  uint64_t pending_rounds_ = 0;  // number of scheduled but unfinished rounds
+  bool stop_ = false;
+  std::exception_ptr error_;
+
+  std::thread worker_;
+};
+
+using OtSendPool = OtPool<OtSendStore>;
+using OtRecvPool = OtPool<OtRecvStore>;
+
+extern template class OtPool<OtSendStore>;
+extern template class OtPool<OtRecvStore>;
+
+// --------------------------
+//         Generators
+// --------------------------
+
+// IKNP generators, requires 128 base ots
+OtSendPool::Generator MakeIknpOtSendGenerator(const OtRecvStore& base_ot,
+                                              bool cot = false);
+OtRecvPool::Generator MakeIknpOtRecvGenerator(const OtSendStore& base_ot,
+                                              bool cot = false);
+
+// SoftSpoken generators, base ots are generated in the first refill round
+OtSendPool::Generator MakeSoftspokenOtSendGenerator(uint64_t k = 2,
+                                                    bool cot = false);
+OtRecvPool::Generator MakeSoftspokenOtRecvGenerator(uint64_t k = 2,
+                                                    bool cot = false);
+
+// Ferret generators (compact cot), requires at least
+// `FerretCotHelper(lpn_param, *)` base cots. The base cots of the next round
+// are taken from the output of the current round (a.k.a. bootstrapping).
+OtSendPool::Generator MakeFerretOtSendGenerator(const OtSendStore& base_cot,
+                                                const LpnParam& lpn_param);
+OtRecvPool::Generator MakeFerretOtRecvGenerator(const OtRecvStore& base_cot,
+                                                const LpnParam& lpn_param);
+
+}  // namespace yacl::crypto
@@ -0,0 +1,156 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/crypto/primitives/ot/ot_pool.h"
+
+#include <future>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "yacl/base/exception.h"
+#include "yacl/link/test_util.h"
+
+namespace yacl::crypto {
+
+namespace {
+
+// acquire sizes, some of them span multiple refill rounds
+const std::vector<uint64_t> kAcquireNums = {100, 5000, 3000, 20000, 1};
+
+OtPoolOptions MakeTestOptions() {
+  OtPoolOptions options;
+  options.batch_size = 4096;
+  options.low_watermark = 2048;
+  options.high_watermark = 8192;
+  return options;
+}
+
+void CheckOts(const std::vector<OtSendStore>& send,
+              const std::vector<OtRecvStore>& recv) {
+  ASSERT_EQ(send.size(), recv.size());
+  for (size_t i = 0; i < send.size(); ++i) {
+    ASSERT_EQ(send[i].Size(), kAcquireNums[i]);
+    ASSERT_EQ(recv[i].Size(), kAcquireNums[i]);
+    for (size_t j = 0; j < send[i].Size(); ++j) {
+      EXPECT_EQ(send[i].GetBlock(j, recv[i].GetChoice(j)), recv[i].GetBlock(j));
+      EXPECT_NE(send[i].GetBlock(j, 1 - recv[i].GetChoice(j)),
+                recv[i].GetBlock(j));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(OtPoolTest, IknpWorks) {
+  // GIVEN
+  auto lctxs = link::test::SetupWorld(2);
+  auto base_ot = MockRots(128);
+  auto options = MakeTestOptions();
+
+  // WHEN
+  auto sender = std::async([&] {
+    OtSendPool pool(lctxs[0], MakeIknpOtSendGenerator(base_ot.recv), options);
+    std::vector<OtSendStore> out;
+    for (auto num : kAcquireNums) {
+      out.push_back(pool.Acquire(num));
+    }
+    return out;
+  });
+  auto receiver = std::async([&] {
+    OtRecvPool pool(lctxs[1], MakeIknpOtRecvGenerator(base_ot.send), options);
+    std::vector<OtRecvStore> out;
+    for (auto num : kAcquireNums) {
+      out.push_back(pool.Acquire(num));
+    }
+    return out;
+  });
+
+  // THEN
+  CheckOts(sender.get(), receiver.get());
+}
+
+TEST(OtPoolTest, SoftspokenCotWorks) {
+  // GIVEN
+  auto lctxs = link::test::SetupWorld(2);
+  auto options = MakeTestOptions();
+
+  // WHEN
+  auto sender = std::async([&] {
+    OtSendPool pool(lctxs[0], MakeSoftspokenOtSendGenerator(2, true), options);
+    std::vector<OtSendStore> out;
+    for (auto num : kAcquireNums) {
+      out.push_back(pool.Acquire(num));
+    }
+    return out;
+  });
+  auto receiver = std::async([&] {
+    OtRecvPool pool(lctxs[1], MakeSoftspokenOtRecvGenerator(2, true), options);
+    std::vector<OtRecvStore> out;
+    for (auto num : kAcquireNums) {
+      out.push_back(pool.Acquire(num));
+    }
+    return out;
+  });
+  auto send_ots = sender.get();
+  auto recv_ots = receiver.get();
+
+  // THEN
+  CheckOts(send_ots, recv_ots);
+  const auto delta = send_ots[0].GetDelta();
+  for (const auto& ots : send_ots) {
+    EXPECT_EQ(ots.GetDelta(), delta);
+    EXPECT_EQ(ots.GetBlock(0, 0) ^ ots.GetBlock(0, 1), delta);
+  }
+}
+
+TEST(OtPoolTest, WatermarkWorks) {
+  // GIVEN
+  auto lctxs = link::test::SetupWorld(2);
+  auto base_ot = MockRots(128);
+  auto options = MakeTestOptions();
+
+  // WHEN
+  auto sender = std::async([&] {
+    OtSendPool pool(lctxs[0], MakeIknpOtSendGenerator(base_ot.recv), options);
+    // initial refill: 2 rounds to reach the high watermark
+    EXPECT_EQ(pool.Scheduled(), 2 * options.batch_size);
+    pool.Acquire(1000);  // 7192 left, no refill
+    EXPECT_EQ(pool.Scheduled(), 2 * options.batch_size - 1000);
+    pool.Acquire(6000);  // 1192 left, refill to 9384
+    EXPECT_EQ(pool.Scheduled(), 4 * options.batch_size - 7000);
+  });
+  auto receiver = std::async([&] {
+    OtRecvPool pool(lctxs[1], MakeIknpOtRecvGenerator(base_ot.send), options);
+    pool.Acquire(1000);
+    pool.Acquire(6000);
+  });
+
+  // THEN
+  sender.get();
+  receiver.get();
+}
+
+TEST(OtPoolTest, InvalidOptionsThrow) {
+  auto lctxs = link::test::SetupWorld(2);
+  auto base_ot = MockRots(128);
+  auto options = MakeTestOptions();
+  options.low_watermark = options.high_watermark + 1;
+
+  EXPECT_THROW(
+      OtSendPool(lctxs[0], MakeIknpOtSendGenerator(base_ot.recv), options),
+      yacl::Exception);
+}
+
+}  // namespace yacl::crypto
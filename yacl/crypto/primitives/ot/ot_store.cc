@@ -14,16 +14,153 @@
 
 #include "yacl/crypto/primitives/ot/ot_store.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <utility>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include "yacl/base/exception.h"
 #include "yacl/crypto/tools/prg.h"
 #include "yacl/crypto/utils/rand.h"
 
 namespace yacl::crypto {
 
+namespace {
+
+// load (at most) 8 bytes from src[pos, size) as a little-endian word
+inline uint64_t LoadWord(const uint8_t* src, uint64_t pos, uint64_t size) {
+  uint64_t out = 0;
+  if (pos + sizeof(uint64_t) <= size) {
+    std::memcpy(&out, src + pos, sizeof(uint64_t));
+  } else if (pos < size) {
+    std::memcpy(&out, src + pos, size - pos);
+  }
+  return out;
+}
+
+// copy `num` bits from src (starting at bit `offset`) to dst (starting at bit
+// 0), where src has `src_size` bytes
+void CopyBits(const uint8_t* src, uint64_t src_size, uint64_t offset,
+              uint64_t num, uint8_t* dst) {
+  const uint64_t byte_offset = offset / 8;
+  const uint64_t shift = offset % 8;
+  const uint64_t num_bytes = (num + 7) / 8;
+
+  if (shift == 0) {
+    std::memcpy(dst, src + byte_offset, num_bytes);
+  } else {
+    for (uint64_t i = 0; i < num_bytes; i += sizeof(uint64_t)) {
+      const uint64_t pos = byte_offset + i;
+      uint64_t word = LoadWord(src, pos, src_size) >> shift;
+      word |= LoadWord(src, pos + sizeof(uint64_t), src_size) << (64 - shift);
+      std::memcpy(dst + i, &word, std::min(sizeof(uint64_t), num_bytes - i));
+    }
+  }
+  if (num % 8 != 0) {
+    dst[num_bytes - 1] &= static_cast<uint8_t>((1U << (num % 8)) - 1);
+  }
+}
+
+// pack the LSB of each block into bits
+void PackBlockLsbs(const uint128_t* blocks, uint64_t num, uint8_t* dst) {
+  std::memset(dst, 0, (num + 7) / 8);
+  uint64_t i = 0;
+#ifdef __AVX2__
+  // 8 blocks -> 1 byte
+  for (; i + 8 <= num; i += 8) {
+    uint32_t byte = 0;
+    for (uint64_t j = 0; j < 8; j += 4) {
+      const auto* ptr = reinterpret_cast<const __m256i*>(blocks + i + j);
+      // [b0.lo, b0.hi, b1.lo, b1.hi], [b2.lo, b2.hi, b3.lo, b3.hi]
+      __m256i x0 = _mm256_loadu_si256(ptr);
+      __m256i x1 = _mm256_loadu_si256(ptr + 1);
+      // [b0.lo, b2.lo, b1.lo, b3.lo] -> [b0.lo, b1.lo, b2.lo, b3.lo]
+      __m256i lo = _mm256_unpacklo_epi64(x0, x1);
+      lo = _mm256_permute4x64_epi64(lo, 0xd8);
+      lo = _mm256_slli_epi64(lo, 63);
+      byte |= static_cast<uint32_t>(
+                  _mm256_movemask_pd(_mm256_castsi256_pd(lo)))
+              << j;
+    }
+    dst[i / 8] = static_cast<uint8_t>(byte);
+  }
+#endif
+  for (; i < num; ++i) {
+    dst[i / 8] |= static_cast<uint8_t>(blocks[i] & 0x1) << (i % 8);
+  }
+}
+
+// out[i] = bit[i] ? 0xff..ff : 0
+void ExpandBitsToMask(const uint8_t* bits, uint64_t num, uint128_t* out) {
+  uint64_t i = 0;
+#ifdef __AVX2__
+  const __m256i sel = _mm256_set_epi64x(2, 2, 1, 1);
+  for (; i + 8 <= num; i += 8) {
+    const int64_t byte = bits[i / 8];
+    for (uint64_t j = 0; j < 8; j += 2) {
+      // lane 0/1 <- bit j, lane 2/3 <- bit (j + 1)
+      __m256i x = _mm256_set1_epi64x(byte >> j);
+      x = _mm256_cmpeq_epi64(_mm256_and_si256(x, sel), sel);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + j), x);
+    }
+  }
+#endif
+  for (; i < num; ++i) {
+    out[i] = -static_cast<uint128_t>((bits[i / 8] >> (i % 8)) & 0x1);
+  }
+}
+
+// out[i] = (blocks[i] & 0x1) ? 0xff..ff : 0
+void ExpandBlockLsbsToMask(const uint128_t* blocks, uint64_t num,
+                           uint128_t* out) {
+  uint64_t i = 0;
+#ifdef __AVX2__
+  for (; i + 2 <= num; i += 2) {
+    __m256i x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks + i));
+    // move the LSB to the sign bit of the second dword, then broadcast the
+    // second dword and spread its sign bit
+    x = _mm256_slli_epi64(x, 63);
+    x = _mm256_shuffle_epi32(x, 0x55);
+    x = _mm256_srai_epi32(x, 31);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+  }
+#endif
+  for (; i < num; ++i) {
+    out[i] = -(blocks[i] & 0x1);
+  }
+}
+
+// blocks[i] = (blocks[i] & ~1) | bit[i]
+void SetBlockLsbs(const uint8_t* bits, uint64_t num, uint128_t* blocks) {
+  uint64_t i = 0;
+#ifdef __AVX2__
+  const __m256i one = _mm256_set_epi64x(0, 1, 0, 1);
+  const __m256i sel = _mm256_set_epi64x(2, 2, 1, 1);
+  for (; i + 8 <= num; i += 8) {
+    const int64_t byte = bits[i / 8];
+    for (uint64_t j = 0; j < 8; j += 2) {
+      auto* ptr = reinterpret_cast<__m256i*>(blocks + i + j);
+      __m256i mask = _mm256_set1_epi64x(byte >> j);
+      mask = _mm256_cmpeq_epi64(_mm256_and_si256(mask, sel), sel);
+      __m256i x = _mm256_andnot_si256(one, _mm256_loadu_si256(ptr));
+      x = _mm256_or_si256(x, _mm256_and_si256(mask, one));
+      _mm256_storeu_si256(ptr, x);
+    }
+  }
+#endif
+  for (; i < num; ++i) {
+    blocks[i] = (blocks[i] & ~static_cast<uint128_t>(1)) |
+                ((bits[i / 8] >> (i % 8)) & 0x1);
+  }
+}
+
+}  // namespace
+
 //================================//
 //           Slice Base           //
 //================================//
@@ -217,6 +354,68 @@ AlignedVector<uint128_t> OtRecvStore::CopyBlocks() const {
           blk_buf_->begin() + internal_use_ctr_ + internal_use_size_};
 }
 
+void OtRecvStore::CopyChoicesTo(absl::Span<uint8_t> out) const {
+  const uint64_t num = std::min<uint64_t>(Size(), out.size() * 8);
+  if (num > 0) {
+    if (type_ == OtStoreType::Compact) {
+      PackBlockLsbs(blk_buf_->data() + GetBufIdx(0), num, out.data());
+    } else {
+      CopyBits(reinterpret_cast<const uint8_t*>(bit_buf_->data()),
+               bit_buf_->num_blocks() * sizeof(uint128_t), GetBufIdx(0), num,
+               out.data());
+    }
+  }
+  // clear the unused bytes
+  const uint64_t num_bytes = (num + 7) / 8;
+  std::fill(out.begin() + num_bytes, out.end(), 0);
+}
+
+absl::Span<const uint128_t> OtRecvStore::GetBlocks(uint64_t begin,
+                                                   uint64_t num) const {
+  YACL_ENFORCE(begin + num <= Size(),
+               "Slice index out of range, slice size: {}, but got range: [{}, "
+               "{})",
+               Size(), begin, begin + num);
+  return {blk_buf_->data() + internal_use_ctr_ + begin, num};
+}
+
+void OtRecvStore::ExpandChoicesToMask(absl::Span<uint128_t> out) const {
+  YACL_ENFORCE(out.size() <= Size(),
+               "Slice index out of range, slice size: {}, but got: {}", Size(),
+               out.size());
+  if (out.empty()) {
+    return;
+  }
+  if (type_ == OtStoreType::Compact) {
+    ExpandBlockLsbsToMask(blk_buf_->data() + GetBufIdx(0), out.size(),
+                          out.data());
+  } else {
+    std::vector<uint8_t> bits((out.size() + 7) / 8);
+    CopyChoicesTo(absl::MakeSpan(bits));
+    ExpandBitsToMask(bits.data(), out.size(), out.data());
+  }
+}
+
+OtRecvStore OtRecvStore::ToNormal() const {
+  const uint64_t num = Size();
+  auto bit_ptr = std::make_shared<dynamic_bitset<uint128_t>>(num);
+  auto blk_ptr = std::make_shared<AlignedVector<uint128_t>>(CopyBlocks());
+  CopyChoicesTo(absl::MakeSpan(reinterpret_cast<uint8_t*>(bit_ptr->data()),
+                               bit_ptr->num_blocks() * sizeof(uint128_t)));
+  return {bit_ptr, blk_ptr, 0, num, 0, num, OtStoreType::Normal};
+}
+
+OtRecvStore OtRecvStore::ToCompact() const {
+  const uint64_t num = Size();
+  auto blk_ptr = std::make_shared<AlignedVector<uint128_t>>(CopyBlocks());
+  if (type_ == OtStoreType::Normal) {
+    std::vector<uint8_t> bits((num + 7) / 8);
+    CopyChoicesTo(absl::MakeSpan(bits));
+    SetBlockLsbs(bits.data(), num, blk_ptr->data());
+  }
+  return {nullptr, blk_ptr, 0, num, 0, num, OtStoreType::Compact};
+}
+
 OtRecvStore MakeOtRecvStore(const dynamic_bitset<uint128_t>& choices,
                             const std::vector<uint128_t>& blocks) {
   auto tmp1_ptr = std::make_shared<dynamic_bitset<uint128_t>>(choices);  // copy
@@ -17,6 +17,8 @@
 #include <memory>
 #include <vector>
 
+#include "absl/types/span.h"
+
 #include "yacl/base/aligned_vector.h"
 #include "yacl/base/dynamic_bitset.h"
 #include "yacl/base/exception.h"
@@ -146,6 +148,32 @@ class OtRecvStore : public SliceBase {
   // copy out the sliced choice buffer [wanring: low efficiency]
   AlignedVector<uint128_t> CopyBlocks() const;
 
+  // ----------------------------------
+  //   Bulk accessors (vectorized)
+  // ----------------------------------
+
+  // copy the first min(Size(), out.size() * 8) choices into `out` as packed
+  // bits (the same layout as dynamic_bitset, i.e. choice[i] is the (i % 8)-th
+  // bit of out[i / 8]), unused bits & bytes of out are set to zero
+  void CopyChoicesTo(absl::Span<uint8_t> out) const;
+
+  // get a read-only view of `num` blocks starting from slice index `begin`
+  // NOTE in compact mode, the LSB of each block is the choice bit
+  absl::Span<const uint128_t> GetBlocks(uint64_t begin, uint64_t num) const;
+
+  // expand the first out.size() choices to 128-bit masks, i.e.
+  // out[i] = choice[i] ? 0xff..ff : 0
+  void ExpandChoicesToMask(absl::Span<uint128_t> out) const;
+
+  // convert to a normal mode ot store (by copy)
+  OtRecvStore ToNormal() const;
+
+  // convert to a compact mode ot store (by copy), the LSB of each block is
+  // overwritten by its choice bit.
+  // [warning] This is only valid for cot whose delta has LSB = 1, see the
+  // comments of compact mode below.
+  OtRecvStore ToCompact() const;
+
  private:
   // check the consistency of ot receiver store
   void ConsistencyCheck() const override;
@@ -220,6 +248,9 @@ class OtSendStore : public SliceBase {
   // access the delta of the cot
   uint128_t GetDelta() const;
 
+  // check if the delta of the cot is set (a.k.a. this is a cot store)
+  bool HasDelta() const { return delta_ != 0; }
+
   // access a block with the given index
   uint128_t GetBlock(uint64_t ot_idx, uint64_t msg_idx) const;
 
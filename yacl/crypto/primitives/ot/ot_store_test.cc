@@ -134,6 +134,47 @@ TEST(OtRecvStoreTest, GetElementsTest) {
   EXPECT_THROW(ot_store.GetBlock(-1), yacl::Exception);
 }
 
+TEST(OtRecvStoreTest, BulkAccessorTest) {
+  // GIVEN
+  const size_t ot_num = 1000;
+  auto [normal_store, normal_blocks] = RandOtRecvStore(ot_num);
+  auto [compact_store, compact_blocks] = RandCompactOtRecvStore(ot_num);
+
+  // slice with an offset which is not a multiple of 8
+  const size_t offset = 13;
+  const size_t slice_num = 777;
+  for (const auto& store : {normal_store.Slice(offset, offset + slice_num),
+                            compact_store.Slice(offset, offset + slice_num)}) {
+    // WHEN
+    std::vector<uint8_t> bits((slice_num + 7) / 8 + 1, 0xff);
+    store.CopyChoicesTo(absl::MakeSpan(bits));
+    std::vector<uint128_t> masks(slice_num);
+    store.ExpandChoicesToMask(absl::MakeSpan(masks));
+    auto blocks = store.GetBlocks(1, slice_num - 1);
+    auto normal = store.ToNormal();
+    auto compact = store.ToCompact();
+
+    // THEN
+    EXPECT_EQ(bits.back(), 0);  // unused bytes are cleared
+    EXPECT_EQ(blocks.size(), slice_num - 1);
+    EXPECT_EQ(normal.Type(), OtStoreType::Normal);
+    EXPECT_EQ(compact.Type(), OtStoreType::Compact);
+    for (size_t i = 0; i < slice_num; ++i) {
+      const auto choice = store.GetChoice(i);
+      EXPECT_EQ((bits[i / 8] >> (i % 8)) & 0x1, choice);
+      EXPECT_EQ(masks[i], choice ? ~static_cast<uint128_t>(0) : 0);
+      if (i > 0) {
+        EXPECT_EQ(blocks[i - 1], store.GetBlock(i));
+      }
+      EXPECT_EQ(normal.GetChoice(i), choice);
+      EXPECT_EQ(normal.GetBlock(i), store.GetBlock(i));
+      EXPECT_EQ(compact.GetChoice(i), choice);
+      EXPECT_EQ(compact.GetBlock(i) >> 1, store.GetBlock(i) >> 1);
+    }
+    EXPECT_THROW(store.GetBlocks(1, slice_num), yacl::Exception);
+  }
+}
+
 TEST(OtSendStoreTest, ConstructorTest) {
   // GIVEN
   const uint64_t ot_num = 2;
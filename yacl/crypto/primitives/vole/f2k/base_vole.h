@@ -90,9 +90,8 @@ void inline Ot2VoleRecv(OtRecvStore& recv_ot, absl::Span<T> u,
   YACL_ENFORCE(u.size() == v.size());
   YACL_ENFORCE(recv_ot.Size() >= size * T_bits);
 
-  // [Warning] Copying, low efficiency
-  auto choices = recv_ot.CopyChoice();
-  memcpy(u.data(), choices.data(), size * sizeof(T));
+  recv_ot.CopyChoicesTo(absl::MakeSpan(reinterpret_cast<uint8_t*>(u.data()),
+                                       size * sizeof(T)));
 
   std::array<K, T_bits> v_buff;
   std::array<K, T_bits> basis;
@@ -105,9 +104,9 @@ void inline Ot2VoleRecv(OtRecvStore& recv_ot, absl::Span<T> u,
   }
 
   for (uint64_t i = 0; i < size; ++i) {
-    // [Warning] Copying, low efficiency
+    auto blocks = recv_ot.GetBlocks(i * T_bits, T_bits);
     for (size_t j = 0; j < T_bits; ++j) {
-      v_buff[j] = recv_ot.GetBlock(i * T_bits + j);
+      v_buff[j] = static_cast<K>(blocks[j]);
     }
     v[i] = vole::internal::GfMul(absl::MakeSpan(v_buff), absl::MakeSpan(basis));
   }
@@ -16,8 +16,11 @@
 
 #include <cstdint>
 #include <future>
+#include <map>
 #include <vector>
 
+#include "fmt/format.h"
+
 #include "yacl/base/exception.h"
 #include "yacl/crypto/primitives/vole/f2k/base_vole.h"
 #include "yacl/crypto/primitives/vole/f2k/silent_vole.h"
@@ -56,20 +59,29 @@ std::future<double> inline async(Function&& fn, Args&&... args) {
 
 }  // namespace decorator
 
-// VoleBench
+// VoleBench, arguments are {num_vole, network}, network selects the emulated
+// network (link::test::BenchNetwork) between sender and receiver.
 class VoleBench : public benchmark::Fixture {
  public:
-  void SetUp(const ::benchmark::State&) override {
-    if (lctxs_.empty()) {
-      // lctxs_ = link::test::SetupBrpcWorld(2);
-      lctxs_ = link::test::SetupWorld(2);
+  void SetUp(const ::benchmark::State& state) override {
+    const auto network = state.range(1);
+    auto& lctxs = worlds_[network];
+    if (lctxs.empty()) {
+      // lctxs = link::test::SetupBrpcWorld(2);
+      lctxs = link::test::SetupWorld(fmt::format("vole_bench_{}", network), 2,
+                                     link::test::BenchEmulation(network));
     }
+    lctxs_ = lctxs;
   }
 
   static std::vector<std::shared_ptr<link::Context>> lctxs_;
+  static std::map<int64_t, std::vector<std::shared_ptr<link::Context>>>
+      worlds_;
 };
 
 std::vector<std::shared_ptr<link::Context>> VoleBench::lctxs_ = {};
+std::map<int64_t, std::vector<std::shared_ptr<link::Context>>>
+    VoleBench::worlds_ = {};
 
 #define DECLARE_GIBLOA_VOLE_BENCH(type0, type1)                                \
   BENCHMARK_DEFINE_F(VoleBench, GilboaVole_##type0##x##type1)                  \
@@ -241,16 +253,22 @@ DELCARE_SILENT_SUBFIELDVOLE_BENCH(ExAcc40);
   BM_REGISTER_EXACC_SILENT_VOLE(Arguments);
 
 void BM_DefaultArguments(benchmark::internal::Benchmark* b) {
-  b->Arg(8192)->Unit(benchmark::kMillisecond);
+  b->ArgNames({"num", "net"})
+      ->ArgsProduct({{8192},
+                     {link::test::kNetLocal, link::test::kNetLan,
+                      link::test::kNetWan}})
+      ->Unit(benchmark::kMillisecond);
 }
 
 void BM_PerfArguments(benchmark::internal::Benchmark* b) {
-  b->Arg(1 << 18)
-      ->Arg(1 << 20)  // 1048576, one million
-      ->Arg(1 << 22)
-      ->Arg(1 << 24)
-      ->Arg(10000000)  // ten million
-      ->Arg(22437250)
+  b->ArgNames({"num", "net"})
+      ->ArgsProduct({{1 << 18,
+                      1 << 20,  // 1048576, one million
+                      1 << 22, 1 << 24,
+                      10000000,  // ten million
+                      22437250},
+                     {link::test::kNetLocal, link::test::kNetLan,
+                      link::test::kNetWan}})
       ->Unit(benchmark::kMillisecond)
       ->Iterations(10);
 }
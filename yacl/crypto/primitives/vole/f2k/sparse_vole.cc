@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <vector>
 
 #include "yacl/base/aligned_vector.h"
 #include "yacl/base/byte_container_view.h"
@@ -149,21 +150,11 @@ void MpVoleSend(const std::shared_ptr<link::Context>& ctx,
 
   auto send_msg = AlignedVector<uint128_t>(w.data(), w.data() + batch_num);
 
-  for (uint32_t i = 0; i < batch_num; ++i) {
-    auto this_size = (i == batch_num - 1) ? last_batch_size : batch_size;
-    auto this_span = output.subspan(i * batch_size, this_size);
+  // expand all GYWZ trees at once (level-synchronous and in parallel)
+  std::vector<uint32_t> sizes(batch_num, batch_size);
+  sizes.back() = last_batch_size;
+  GywzOtExtSendBatch(ctx, send_ot, absl::MakeConstSpan(sizes), output);
 
-    // TODO: @wenfan
-    // "Slice" would force to slice original OtStore from "begin" to "end",
-    // which might cause unexpected error.
-    // It would be better to use "NextSlice" here, but it's not a const
-    // function.
-    auto ot_slice = send_ot.Slice(
-        i * math::Log2Ceil(batch_size),
-        i * math::Log2Ceil(batch_size) + math::Log2Ceil(this_size));
-
-    GywzOtExtSend(ctx, ot_slice, this_size, this_span);
-  }
   // Break the correlation
   ParaCrHashInplace_128(output.subspan(0, param.mp_vole_size_));
   for (uint32_t i = 0; i < batch_num; ++i) {
@@ -192,20 +183,11 @@ void MpVoleRecv(const std::shared_ptr<link::Context>& ctx,
   const auto& last_batch_size = param.last_sp_vole_size_;
   const auto& indexes = param.indexes_;
 
-  for (uint32_t i = 0; i < batch_num; ++i) {
-    auto this_size = (i == batch_num - 1) ? last_batch_size : batch_size;
-    auto this_span = output.subspan(i * batch_size, this_size);
-
-    // TODO: @wenfan
-    // "Slice" would force to slice original OtStore from "begin" to "end",
-    // which might cause unexpected error.
-    // It would be better to use "NextSlice" here, but it's not a const
-    // function.
-    auto ot_slice = recv_ot.Slice(
-        i * math::Log2Ceil(batch_size),
-        i * math::Log2Ceil(batch_size) + math::Log2Ceil(this_size));
-    GywzOtExtRecv(ctx, ot_slice, this_size, indexes[i], this_span);
-  }
+  // expand all GYWZ trees at once (level-synchronous and in parallel)
+  std::vector<uint32_t> sizes(batch_num, batch_size);
+  sizes.back() = last_batch_size;
+  GywzOtExtRecvBatch(ctx, recv_ot, absl::MakeConstSpan(sizes),
+                     absl::MakeConstSpan(indexes), output);
 
   ParaCrHashInplace_128(output.subspan(0, param.mp_vole_size_));
 
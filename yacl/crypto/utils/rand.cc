@@ -14,8 +14,15 @@
 
 #include "yacl/crypto/utils/rand.h"
 
+#include <pthread.h>
+
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "yacl/base/byte_container_view.h"
 #include "yacl/base/dynamic_bitset.h"
@@ -24,10 +31,114 @@
 
 namespace yacl::crypto {
 
+namespace {
+
+// keystream buffered for small requests.
+constexpr size_t kFastBufferSize = 4096;
+// requests larger than this skip the buffer.
+constexpr size_t kFastBufferedMaxLen = 256;
+
+std::atomic<uint64_t> next_ctx_id{0};
+
+// bumped in the child after fork, so a child never repeats the keystream of
+// its parent.
+std::atomic<uint64_t> fork_generation{0};
+
+void RegisterForkHandler() {
+  static std::once_flag flag;
+  std::call_once(flag, [] {
+    pthread_atfork(nullptr, nullptr, [] { fork_generation++; });
+  });
+}
+
+// per-thread AES-128-CTR keystream of one RandCtx.
+class FastRandState {
+ public:
+  FastRandState() : cipher_(openssl::FetchEvpCipher("aes-128-ctr")) {
+    YACL_ENFORCE(cipher_ != nullptr);
+  }
+
+  template <typename Reseed>
+  void Fill(char *buf, size_t len, const Reseed &reseed) {
+    if (fork_generation_ != fork_generation.load()) {
+      // drop keystream shared with the parent.
+      remaining_ = 0;
+      buf_pos_ = kFastBufferSize;
+    }
+    if (len > kFastBufferedMaxLen) {
+      Keystream(reinterpret_cast<uint8_t *>(buf), len, reseed);
+      return;
+    }
+    while (len > 0) {
+      if (buf_pos_ == kFastBufferSize) {
+        Keystream(buf_.data(), kFastBufferSize, reseed);
+        buf_pos_ = 0;
+      }
+      const size_t n = std::min(len, kFastBufferSize - buf_pos_);
+      std::memcpy(buf, buf_.data() + buf_pos_, n);
+      // used keystream is not left in memory.
+      std::memset(buf_.data() + buf_pos_, 0, n);
+      buf_pos_ += n;
+      buf += n;
+      len -= n;
+    }
+  }
+
+ private:
+  template <typename Reseed>
+  void Keystream(uint8_t *out, size_t len, const Reseed &reseed) {
+    while (len > 0) {
+      if (remaining_ == 0) {
+        fork_generation_ = fork_generation.load();
+        uint128_t key = reseed();
+        const uint128_t iv = 0;
+        ctx_ = openssl::UniqueCipherCtx(EVP_CIPHER_CTX_new());
+        OSSL_RET_1(EVP_EncryptInit_ex(ctx_.get(), cipher_.get(), nullptr,
+                                      reinterpret_cast<uint8_t *>(&key),
+                                      reinterpret_cast<const uint8_t *>(&iv)));
+        key = 0;
+        remaining_ = RandCtx::kFastReseedBytes;
+      }
+      const size_t n = std::min(len, remaining_);
+      // keystream is the encryption of zeros.
+      std::memset(out, 0, n);
+      int out_len = 0;
+      OSSL_RET_1(EVP_EncryptUpdate(ctx_.get(), out, &out_len, out,
+                                   static_cast<int>(n)));
+      remaining_ -= n;
+      out += n;
+      len -= n;
+    }
+  }
+
+  openssl::UniqueCipher cipher_;
+  openssl::UniqueCipherCtx ctx_;
+  size_t remaining_ = 0;
+  uint64_t fork_generation_ = 0;
+  std::array<uint8_t, kFastBufferSize> buf_;
+  size_t buf_pos_ = kFastBufferSize;
+};
+
+FastRandState &GetFastRandState(uint64_t ctx_id) {
+  thread_local std::unordered_map<uint64_t, FastRandState> states;
+  thread_local uint64_t cached_id = std::numeric_limits<uint64_t>::max();
+  thread_local FastRandState *cached = nullptr;
+  if (cached_id != ctx_id) {
+    // references to unordered_map elements are stable.
+    cached = &states[ctx_id];
+    cached_id = ctx_id;
+  }
+  return *cached;
+}
+
+}  // namespace
+
 // --------------------
 // Core Implementations
 // --------------------
-RandCtx::RandCtx(SecParam::C c, bool use_yacl_es) : c_(c) {
+RandCtx::RandCtx(SecParam::C c, bool use_yacl_es)
+    : c_(c), id_(next_ctx_id++) {
+  RegisterForkHandler();
   ctr_drbg_ = DrbgFactory::Instance().Create(
       "ctr-drbg", ArgUseYaclEs = use_yacl_es, ArgSecParamC = c_);
   hash_drbg_ = DrbgFactory::Instance().Create(
@@ -35,14 +146,22 @@ RandCtx::RandCtx(SecParam::C c, bool use_yacl_es) : c_(c) {
 }
 
 void RandCtx::Fill(char *buf, size_t len, bool use_fast_mode) const {
-  YACL_ENFORCE(len <= std::numeric_limits<int>::max());
   if (use_fast_mode) {
-    hash_drbg_->Fill(buf, len);
+    FastFill(buf, len);
   } else {
+    YACL_ENFORCE(len <= std::numeric_limits<int>::max());
     ctr_drbg_->Fill(buf, len);
   }
 }
 
+void RandCtx::FastFill(char *buf, size_t len) const {
+  GetFastRandState(id_).Fill(buf, len, [&] {
+    uint128_t key;
+    hash_drbg_->Fill(reinterpret_cast<char *>(&key), sizeof(key));
+    return key;
+  });
+}
+
 // ---------------------
 // Other Implementations
 // ---------------------
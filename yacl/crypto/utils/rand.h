@@ -37,6 +37,11 @@ namespace yacl::crypto {
 // -------------------------
 
 // A thread-safe random context class
+//
+// Fast mode is served by a per-thread AES-128-CTR keystream keyed from the
+// context's hash drbg and rekeyed every kFastReseedBytes (and after fork), so
+// threads do not contend on the drbg. Small requests are copied out of a
+// buffered keystream, bulk requests are encrypted in place of the output.
 class RandCtx {
  public:
   explicit RandCtx(SecParam::C c,  // we do not recommend to set c <= 256
@@ -51,8 +56,15 @@ class RandCtx {
   // fill random to buf with len (warning: does not check boundaries)
   void Fill(char *buf, size_t len, bool use_fast_mode = false) const;
 
+  // bytes of keystream generated with one key in fast mode
+  static constexpr size_t kFastReseedBytes = 1 << 20;
+
  private:
+  void FastFill(char *buf, size_t len) const;
+
   const SecParam::C c_; /* comp. security param */
+  // identifies the per-thread fast mode generators of this context
+  uint64_t id_;
   std::unique_ptr<Drbg> ctr_drbg_;
 
   // https://crypto.stackexchange.com/a/1395/61581
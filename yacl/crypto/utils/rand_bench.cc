@@ -79,6 +79,32 @@ static void BM_IcDrbg(benchmark::State& state) {
   }
 }
 
+// small draws per iteration in the multi-threaded benchmarks
+constexpr size_t kSmallDraws = 1024;
+
+// many small draws from all threads, served by per-thread keystreams.
+static void BM_FastRandU64MT(benchmark::State& state) {
+  for (auto _ : state) {
+    for (size_t i = 0; i < kSmallDraws; i++) {
+      benchmark::DoNotOptimize(FastRandU64());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kSmallDraws);
+}
+
+// same draws from one drbg shared by all threads, as a baseline.
+static void BM_SharedDrbgU64MT(benchmark::State& state) {
+  static auto drbg = DrbgFactory::Instance().Create("hash-drbg");
+  for (auto _ : state) {
+    for (size_t i = 0; i < kSmallDraws; i++) {
+      uint64_t r;
+      drbg->Fill(reinterpret_cast<char*>(&r), sizeof(r));
+      benchmark::DoNotOptimize(r);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kSmallDraws);
+}
+
 BENCHMARK(BM_SecureRand)
     ->Unit(benchmark::kMillisecond)
     ->Arg(1024)
@@ -108,4 +134,8 @@ BENCHMARK(BM_IcDrbg)
     ->Arg(40960)
     ->Arg(81920)
     ->Arg(1 << 24);
+
+BENCHMARK(BM_FastRandU64MT)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(BM_SharedDrbgU64MT)->ThreadRange(1, 16)->UseRealTime();
 }  // namespace yacl::crypto
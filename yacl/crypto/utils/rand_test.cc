@@ -14,6 +14,17 @@
 
 #include "yacl/crypto/utils/rand.h"
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace yacl::crypto {
@@ -41,4 +52,116 @@ TEST_GENERIC_TYPE_RAND_FUNC(RandSeed);
 TEST_GENERIC_TYPE_RAND_FUNC(RandBytes, 10);
 TEST_GENERIC_TYPE_RAND_FUNC(RandBits, 10);
 
+TEST(FastRandTest, ManyThreads) {
+  constexpr size_t kThreads = 8;
+  constexpr size_t kNum = 10000;
+  std::vector<std::future<std::vector<uint64_t>>> futures;
+  for (size_t t = 0; t < kThreads; t++) {
+    futures.push_back(std::async(std::launch::async, [] {
+      std::vector<uint64_t> ret(kNum);
+      for (auto& r : ret) {
+        r = FastRandU64();
+      }
+      return ret;
+    }));
+  }
+  std::set<uint64_t> all;
+  for (auto& f : futures) {
+    auto ret = f.get();
+    all.insert(ret.begin(), ret.end());
+  }
+  EXPECT_EQ(all.size(), kThreads * kNum);
+}
+
+TEST(FastRandTest, SmallAndBulk) {
+  // cross the buffer & the reseed boundary.
+  std::vector<uint128_t> small(2 * RandCtx::kFastReseedBytes / 16);
+  for (auto& r : small) {
+    r = FastRandU128();
+  }
+  EXPECT_EQ(std::set<uint128_t>(small.begin(), small.end()).size(),
+            small.size());
+
+  auto bulk = RandVec<uint128_t>(small.size() + 3, true);
+  std::set<uint128_t> all(small.begin(), small.end());
+  all.insert(bulk.begin(), bulk.end());
+  EXPECT_EQ(all.size(), small.size() + bulk.size());
+}
+
+namespace {
+
+// run draw() in a forked child and then in the parent, return both results.
+// called in a new thread, so the thread local keystream state is exactly
+// what the caller set up in that thread.
+std::pair<std::vector<uint8_t>, std::vector<uint8_t>> ForkDraw(
+    const std::function<std::vector<uint8_t>()>& draw) {
+  int fds[2];
+  YACL_ENFORCE(pipe(fds) == 0);
+  pid_t pid = fork();
+  YACL_ENFORCE(pid >= 0);
+  if (pid == 0) {
+    auto ret = draw();
+    size_t written = 0;
+    while (written < ret.size()) {
+      auto n = write(fds[1], ret.data() + written, ret.size() - written);
+      if (n <= 0) {
+        _exit(1);
+      }
+      written += n;
+    }
+    _exit(0);
+  }
+  auto parent = draw();
+  std::vector<uint8_t> child(parent.size());
+  size_t got = 0;
+  while (got < child.size()) {
+    auto n = read(fds[0], child.data() + got, child.size() - got);
+    if (n <= 0) {
+      break;
+    }
+    got += n;
+  }
+  waitpid(pid, nullptr, 0);
+  close(fds[0]);
+  close(fds[1]);
+  EXPECT_EQ(got, child.size());
+  return {std::move(parent), std::move(child)};
+}
+
+}  // namespace
+
+TEST(FastRandTest, ForkInsideKey) {
+  // fork with keystream of the current key both buffered and unused.
+  std::thread([] {
+    FastRandBytes(RandCtx::kFastReseedBytes / 2);
+    FastRandU64();
+    const size_t bulk = RandCtx::kFastReseedBytes / 4;
+    auto [parent, child] = ForkDraw([&] {
+      auto ret = FastRandBytes(bulk);
+      uint64_t small = FastRandU64();
+      auto* p = reinterpret_cast<uint8_t*>(&small);
+      ret.insert(ret.begin(), p, p + sizeof(small));
+      return ret;
+    });
+    // buffered keystream.
+    EXPECT_FALSE(std::equal(parent.begin(), parent.begin() + 8, child.begin()));
+    // rest of the current key's keystream.
+    EXPECT_FALSE(std::equal(parent.begin() + 8, parent.end(),
+                            child.begin() + 8));
+  }).join();
+}
+
+TEST(FastRandTest, ForkAtReseed) {
+  // fork right at the reseed boundary, the child's new key should differ
+  // from the parent's.
+  std::thread([] {
+    FastRandBytes(RandCtx::kFastReseedBytes);
+    auto [parent, child] =
+        ForkDraw([] { return FastRandBytes(RandCtx::kFastReseedBytes); });
+    EXPECT_FALSE(std::equal(parent.begin(), parent.begin() + 16,
+                            child.begin()));
+    EXPECT_NE(parent, child);
+  }).join();
+}
+
 }  // namespace yacl::crypto
@@ -2,17 +2,37 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 #include "yacl/base/buffer.h"
 #include "yacl/base/byte_container_view.h"
+#include "yacl/base/exception.h"
 
 namespace yacl::io {
 
+// iterate key,value pairs in key (bytewise) order.
+class KVIterator {
+ public:
+  virtual ~KVIterator() = default;
+
+  // false if reach the end.
+  virtual bool Valid() const = 0;
+
+  virtual void Next() = 0;
+
+  // key & value of current pair, valid until Next().
+  virtual absl::string_view Key() const = 0;
+  virtual ByteContainerView Value() const = 0;
+};
+
 class KVStore {
  public:
   virtual ~KVStore() = default;
@@ -20,6 +40,15 @@ class KVStore {
   // store key,value
   virtual void Put(absl::string_view key, ByteContainerView value) = 0;
 
+  // store key,value pairs in one batch, keys.size() == values.size()
+  virtual void PutBatch(absl::Span<const absl::string_view> keys,
+                        absl::Span<const ByteContainerView> values) {
+    YACL_ENFORCE(keys.size() == values.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      Put(keys[i], values[i]);
+    }
+  }
+
   // get value by key
   virtual bool Get(absl::string_view key, std::string *value) const = 0;
 
@@ -34,28 +63,134 @@ class KVStore {
     return ret;
   }
 
-  // get count
+  // get values by keys, return number of keys found.
+  // values->at(i) is empty if keys[i] is not found, see found->at(i).
+  virtual size_t MultiGet(absl::Span<const absl::string_view> keys,
+                          std::vector<std::string> *values,
+                          std::vector<uint8_t> *found = nullptr) const {
+    size_t count = 0;
+    values->resize(keys.size());
+    if (found != nullptr) {
+      found->resize(keys.size());
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+      bool ret = Get(keys[i], &values->at(i));
+      if (!ret) {
+        values->at(i).clear();
+      }
+      if (found != nullptr) {
+        found->at(i) = ret;
+      }
+      count += ret;
+    }
+    return count;
+  }
+
+  // iterate keys in [begin, end), empty end means no upper bound.
+  virtual std::unique_ptr<KVIterator> NewIterator(
+      absl::string_view begin = {}, absl::string_view end = {}) const = 0;
+
+  // iterate keys start with prefix.
+  std::unique_ptr<KVIterator> NewPrefixIterator(
+      absl::string_view prefix) const {
+    // the smallest key greater than all keys with prefix, i.e. increase the
+    // last byte which is not 0xff.
+    std::string end(prefix);
+    while (!end.empty() && static_cast<uint8_t>(end.back()) == 0xff) {
+      end.pop_back();
+    }
+    if (!end.empty()) {
+      end.back() = static_cast<char>(static_cast<uint8_t>(end.back()) + 1);
+    }
+    return NewIterator(prefix, end);
+  }
+
+  // get count, O(1)
   virtual size_t Count() const = 0;
 };
 
+// index is stored as 8 bytes big endian key, so that iteration of kv_store
+// follows index order.
 class IndexStore {
  public:
+  static constexpr size_t kKeySize = sizeof(uint64_t);
+  using Key = std::array<char, kKeySize>;
+
   explicit IndexStore(const std::shared_ptr<KVStore> &kv_store)
       : kv_store_(kv_store) {}
 
+  static Key IndexToKey(size_t index) {
+    Key key;
+    for (size_t i = 0; i < kKeySize; i++) {
+      key[i] = static_cast<char>(index >> (8 * (kKeySize - 1 - i)));
+    }
+    return key;
+  }
+
+  static size_t KeyToIndex(absl::string_view key) {
+    YACL_ENFORCE(key.size() == kKeySize, "invalid index key size {}",
+                 key.size());
+    size_t index = 0;
+    for (size_t i = 0; i < kKeySize; i++) {
+      index = (index << 8) | static_cast<uint8_t>(key[i]);
+    }
+    return index;
+  }
+
   // store index,value
   void Put(size_t index, ByteContainerView value) {
-    kv_store_->Put(std::to_string(index), value);
+    auto key = IndexToKey(index);
+    kv_store_->Put({key.data(), key.size()}, value);
+  }
+
+  // store index,value pairs in one batch
+  void PutBatch(absl::Span<const size_t> indexes,
+                absl::Span<const ByteContainerView> values) {
+    std::vector<Key> keys(indexes.size());
+    std::vector<absl::string_view> key_views(indexes.size());
+    for (size_t i = 0; i < indexes.size(); i++) {
+      keys[i] = IndexToKey(indexes[i]);
+      key_views[i] = {keys[i].data(), keys[i].size()};
+    }
+    kv_store_->PutBatch(key_views, values);
   }
 
   // get value by index
   bool Get(size_t index, std::string *value) const {
-    return kv_store_->Get(std::to_string(index), value);
+    auto key = IndexToKey(index);
+    return kv_store_->Get({key.data(), key.size()}, value);
   }
 
   // get value by key
   bool Get(size_t index, Buffer *value) const {
-    return kv_store_->Get(std::to_string(index), value);
+    auto key = IndexToKey(index);
+    return kv_store_->Get({key.data(), key.size()}, value);
+  }
+
+  // get values by indexes, return number of indexes found.
+  size_t MultiGet(absl::Span<const size_t> indexes,
+                  std::vector<std::string> *values,
+                  std::vector<uint8_t> *found = nullptr) const {
+    std::vector<Key> keys(indexes.size());
+    std::vector<absl::string_view> key_views(indexes.size());
+    for (size_t i = 0; i < indexes.size(); i++) {
+      keys[i] = IndexToKey(indexes[i]);
+      key_views[i] = {keys[i].data(), keys[i].size()};
+    }
+    return kv_store_->MultiGet(key_views, values, found);
+  }
+
+  // iterate indexes in [begin, end) in index order, use KeyToIndex to get
+  // index of iterator's key.
+  std::unique_ptr<KVIterator> NewIterator(size_t begin = 0,
+                                          size_t end = SIZE_MAX) const {
+    auto begin_key = IndexToKey(begin);
+    if (end == SIZE_MAX) {
+      return kv_store_->NewIterator({begin_key.data(), begin_key.size()});
+    }
+    auto end_key = IndexToKey(end);
+    return kv_store_->NewIterator({begin_key.data(), begin_key.size()},
+                                  {end_key.data(), end_key.size()});
   }
 
   size_t Count() const { return kv_store_->Count(); }
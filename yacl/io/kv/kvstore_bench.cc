@@ -0,0 +1,173 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "yacl/io/kv/leveldb_kvstore.h"
+#include "yacl/io/kv/memory_kvstore.h"
+#include "yacl/io/kv/mmap_kvstore.h"
+
+namespace yacl::io::bench {
+
+// e.g. a serialized (compressed) ec point.
+constexpr size_t kValueSize = 33;
+
+template <typename StoreT>
+std::shared_ptr<KVStore> MakeStore();
+
+template <>
+std::shared_ptr<KVStore> MakeStore<MemoryKVStore>() {
+  return std::make_shared<MemoryKVStore>();
+}
+
+template <>
+std::shared_ptr<KVStore> MakeStore<LeveldbKVStore>() {
+  return std::make_shared<LeveldbKVStore>(true);
+}
+
+template <>
+std::shared_ptr<KVStore> MakeStore<MmapKVStore>() {
+  return std::make_shared<MmapKVStore>(true);
+}
+
+std::vector<std::string> MakeValues(size_t n) {
+  std::vector<std::string> values(n);
+  for (size_t i = 0; i < n; i++) {
+    values[i] = std::string(kValueSize, static_cast<char>(i));
+  }
+  return values;
+}
+
+std::vector<size_t> MakeIndexes(size_t n) {
+  std::vector<size_t> indexes(n);
+  for (size_t i = 0; i < n; i++) {
+    // shuffled
+    indexes[i] = (i * 2654435761ULL) % n;
+  }
+  return indexes;
+}
+
+template <typename StoreT>
+void BM_IndexPut(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto values = MakeValues(n);
+  auto indexes = MakeIndexes(n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    IndexStore store(MakeStore<StoreT>());
+    state.ResumeTiming();
+    for (size_t i = 0; i < n; i++) {
+      store.Put(indexes[i], values[i]);
+    }
+    benchmark::DoNotOptimize(store.Count());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename StoreT>
+void BM_IndexPutBatch(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto values = MakeValues(n);
+  auto indexes = MakeIndexes(n);
+  std::vector<ByteContainerView> value_views(values.begin(), values.end());
+  for (auto _ : state) {
+    state.PauseTiming();
+    IndexStore store(MakeStore<StoreT>());
+    state.ResumeTiming();
+    store.PutBatch(indexes, value_views);
+    benchmark::DoNotOptimize(store.Count());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename StoreT>
+void BM_IndexGet(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto values = MakeValues(n);
+  auto indexes = MakeIndexes(n);
+  std::vector<ByteContainerView> value_views(values.begin(), values.end());
+  IndexStore store(MakeStore<StoreT>());
+  store.PutBatch(indexes, value_views);
+  std::string value;
+  for (auto _ : state) {
+    for (size_t i = 0; i < n; i++) {
+      benchmark::DoNotOptimize(store.Get(indexes[i], &value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename StoreT>
+void BM_IndexMultiGet(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto values = MakeValues(n);
+  auto indexes = MakeIndexes(n);
+  std::vector<ByteContainerView> value_views(values.begin(), values.end());
+  IndexStore store(MakeStore<StoreT>());
+  store.PutBatch(indexes, value_views);
+  std::vector<std::string> got;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(store.MultiGet(indexes, &got));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename StoreT>
+void BM_IndexScan(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto values = MakeValues(n);
+  auto indexes = MakeIndexes(n);
+  std::vector<ByteContainerView> value_views(values.begin(), values.end());
+  IndexStore store(MakeStore<StoreT>());
+  store.PutBatch(indexes, value_views);
+  for (auto _ : state) {
+    size_t sum = 0;
+    for (auto it = store.NewIterator(); it->Valid(); it->Next()) {
+      sum += it->Value().size();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename StoreT>
+void BM_Count(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto values = MakeValues(n);
+  auto indexes = MakeIndexes(n);
+  std::vector<ByteContainerView> value_views(values.begin(), values.end());
+  IndexStore store(MakeStore<StoreT>());
+  store.PutBatch(indexes, value_views);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(store.Count());
+  }
+}
+
+#define KV_BENCHMARK(func)                                              \
+  BENCHMARK_TEMPLATE(func, MemoryKVStore)->Arg(1 << 12)->Arg(1 << 16);  \
+  BENCHMARK_TEMPLATE(func, LeveldbKVStore)->Arg(1 << 12)->Arg(1 << 16); \
+  BENCHMARK_TEMPLATE(func, MmapKVStore)->Arg(1 << 12)->Arg(1 << 16)
+
+KV_BENCHMARK(BM_IndexPut);
+KV_BENCHMARK(BM_IndexPutBatch);
+KV_BENCHMARK(BM_IndexGet);
+KV_BENCHMARK(BM_IndexMultiGet);
+KV_BENCHMARK(BM_IndexScan);
+KV_BENCHMARK(BM_Count);
+
+}  // namespace yacl::io::bench
@@ -1,6 +1,8 @@
 // Copyright (c) 2021 Ant Financial. All rights reserved.
 
 #include <cstdio>
+#include <filesystem>
+#include <functional>
 #include <memory>
 #include <random>
 #include <string>
@@ -11,6 +13,7 @@
 #include "yacl/crypto/tools/prg.h"
 #include "yacl/io/kv/leveldb_kvstore.h"
 #include "yacl/io/kv/memory_kvstore.h"
+#include "yacl/io/kv/mmap_kvstore.h"
 
 namespace yacl::io {
 
@@ -97,4 +100,172 @@ TEST(KVStore, index_leveldb_test) {
   EXPECT_EQ(value, value2);
 }
 
+TEST(KVStore, index_mmap_test) {
+  std::shared_ptr<KVStore> kv_store = std::make_shared<MmapKVStore>(true);
+  IndexStore index_store(kv_store);
+
+  std::random_device rd;
+
+  uint32_t key;
+  std::string value(32, '\0');
+  yacl::crypto::Prg<uint8_t> prg(rd());
+
+  // keep index dense
+  key = prg() % 100000;
+  prg.Fill(absl::MakeSpan(&value[0], value.size()));
+
+  index_store.Put(key, value);
+
+  std::string value2;
+  index_store.Get(key, &value2);
+
+  EXPECT_EQ(value, value2);
+}
+
+TEST(KVStore, mmap_finalize_test) {
+  const std::string path = "/tmp/mmap_kvstore_test";
+  const size_t n = 10000;
+  {
+    auto kv_store = std::make_shared<MmapKVStore>(false, path);
+    IndexStore index_store(kv_store);
+    std::vector<size_t> indexes;
+    std::vector<std::string> value_strs;
+    for (size_t i = 0; i < n; i += 2) {
+      indexes.push_back(i);
+      value_strs.push_back(std::string(i % 100, static_cast<char>(i)));
+    }
+    std::vector<ByteContainerView> values(value_strs.begin(),
+                                          value_strs.end());
+    index_store.PutBatch(indexes, values);
+    index_store.Put(3, "three");
+    index_store.Put(4, "four");
+    EXPECT_EQ(index_store.Count(), n / 2 + 1);
+    EXPECT_THROW(kv_store->Put("not index", "v"), yacl::EnforceNotMet);
+
+    // not finalized yet
+    EXPECT_THROW(MmapKVStore::Open(path), yacl::InvalidFormat);
+    kv_store->Finalize();
+    EXPECT_THROW(index_store.Put(5, "five"), yacl::EnforceNotMet);
+  }
+
+  auto kv_store = MmapKVStore::Open(path);
+  IndexStore index_store(kv_store);
+  EXPECT_EQ(index_store.Count(), n / 2 + 1);
+  EXPECT_EQ(kv_store->Slots(), n - 1);
+  std::string value;
+  EXPECT_TRUE(index_store.Get(4, &value));
+  EXPECT_EQ(value, "four");
+  EXPECT_TRUE(index_store.Get(3, &value));
+  EXPECT_EQ(value, "three");
+  EXPECT_TRUE(index_store.Get(100, &value));
+  EXPECT_EQ(value, "");
+  EXPECT_TRUE(index_store.Get(98, &value));
+  EXPECT_EQ(value, std::string(98, static_cast<char>(98)));
+  EXPECT_FALSE(index_store.Get(5, &value));
+  EXPECT_FALSE(index_store.Get(n, &value));
+
+  ByteContainerView view;
+  EXPECT_TRUE(kv_store->Get(n - 2, &view));
+  EXPECT_EQ(view.size(), (n - 2) % 100);
+
+  std::vector<size_t> iter_indexes;
+  for (auto it = index_store.NewIterator(1, 9); it->Valid(); it->Next()) {
+    iter_indexes.push_back(IndexStore::KeyToIndex(it->Key()));
+  }
+  EXPECT_EQ(iter_indexes, std::vector<size_t>({2, 3, 4, 6, 8}));
+
+  kv_store.reset();
+  std::filesystem::remove_all(path);
+}
+
+using KVStoreFactory = std::function<std::shared_ptr<KVStore>()>;
+
+class KVStoreApiTest : public ::testing::TestWithParam<KVStoreFactory> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    KVStore, KVStoreApiTest,
+    testing::Values([] { return std::make_shared<MemoryKVStore>(); },
+                    [] { return std::make_shared<LeveldbKVStore>(true); }));
+
+TEST_P(KVStoreApiTest, batch_test) {
+  auto kv_store = GetParam()();
+
+  std::vector<std::string> key_strs = {"a1", "b", "a2", "a", "c", "a1"};
+  std::vector<std::string> value_strs = {"v0", "v1", "v2", "v3", "v4", "v0"};
+  std::vector<absl::string_view> keys(key_strs.begin(), key_strs.end());
+  std::vector<ByteContainerView> values(value_strs.begin(), value_strs.end());
+  kv_store->PutBatch(keys, values);
+  kv_store->Put("d", "v5");
+  kv_store->Put("d", "v5");
+  EXPECT_EQ(kv_store->Count(), 6);
+  // count stays right after more writes.
+  kv_store->Put("e", "v6");
+  EXPECT_EQ(kv_store->Count(), 7);
+  kv_store->PutBatch(absl::MakeConstSpan(keys).subspan(0, 1),
+                     absl::MakeConstSpan(values).subspan(0, 1));
+  EXPECT_EQ(kv_store->Count(), 7);
+
+  std::vector<absl::string_view> get_keys = {"c", "x", "a1", "d"};
+  std::vector<std::string> got;
+  std::vector<uint8_t> found;
+  EXPECT_EQ(kv_store->MultiGet(get_keys, &got, &found), 3);
+  EXPECT_EQ(got, std::vector<std::string>({"v4", "", "v0", "v5"}));
+  EXPECT_EQ(found, std::vector<uint8_t>({1, 0, 1, 1}));
+
+  // range & prefix
+  std::vector<std::string> iter_keys;
+  for (auto it = kv_store->NewIterator("a1", "c"); it->Valid(); it->Next()) {
+    iter_keys.emplace_back(it->Key());
+  }
+  EXPECT_EQ(iter_keys, std::vector<std::string>({"a1", "a2", "b"}));
+  iter_keys.clear();
+  for (auto it = kv_store->NewPrefixIterator("a"); it->Valid(); it->Next()) {
+    iter_keys.emplace_back(it->Key());
+  }
+  EXPECT_EQ(iter_keys, std::vector<std::string>({"a", "a1", "a2"}));
+  auto it = kv_store->NewIterator();
+  ASSERT_TRUE(it->Valid());
+  EXPECT_EQ(it->Key(), "a");
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(it->Value().data()),
+                        it->Value().size()),
+            "v3");
+}
+
+TEST_P(KVStoreApiTest, index_order_test) {
+  IndexStore index_store(GetParam()());
+
+  std::vector<size_t> indexes = {256, 1, 255, 65536, 0, 10};
+  std::vector<std::string> value_strs;
+  for (auto index : indexes) {
+    value_strs.push_back(std::to_string(index));
+  }
+  std::vector<ByteContainerView> values(value_strs.begin(), value_strs.end());
+  index_store.PutBatch(indexes, values);
+  index_store.Put(1ULL << 40, "big");
+  EXPECT_EQ(index_store.Count(), 7);
+
+  std::string value;
+  EXPECT_TRUE(index_store.Get(65536, &value));
+  EXPECT_EQ(value, "65536");
+  EXPECT_FALSE(index_store.Get(2, &value));
+
+  std::vector<std::string> got;
+  EXPECT_EQ(index_store.MultiGet(std::vector<size_t>{10, 1ULL << 40, 3}, &got),
+            2);
+  EXPECT_EQ(got, std::vector<std::string>({"10", "big", ""}));
+
+  // iteration follows index order
+  std::vector<size_t> iter_indexes;
+  for (auto it = index_store.NewIterator(1, 65536); it->Valid(); it->Next()) {
+    iter_indexes.push_back(IndexStore::KeyToIndex(it->Key()));
+  }
+  EXPECT_EQ(iter_indexes, std::vector<size_t>({1, 10, 255, 256}));
+  iter_indexes.clear();
+  for (auto it = index_store.NewIterator(); it->Valid(); it->Next()) {
+    iter_indexes.push_back(IndexStore::KeyToIndex(it->Key()));
+  }
+  EXPECT_EQ(iter_indexes,
+            std::vector<size_t>({0, 1, 10, 255, 256, 65536, 1ULL << 40}));
+}
+
 }  // namespace yacl::io
@@ -2,10 +2,15 @@
 
 #include "yacl/io/kv/leveldb_kvstore.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "absl/container/flat_hash_set.h"
 #include "butil/file_util.h"
 #include "butil/files/temp_file.h"
 #include "butil/strings/string_split.h"
 #include "butil/strings/string_util.h"
+#include "leveldb/write_batch.h"
 #include "spdlog/spdlog.h"
 
 #include "yacl/base/exception.h"
@@ -14,8 +19,10 @@ namespace yacl::io {
 
 LeveldbKVStore::LeveldbKVStore(bool is_temp, const std::string &file_path)
     : is_temp_(is_temp) {
+  filter_policy_.reset(leveldb::NewBloomFilterPolicy(10));
   leveldb::Options options;
   options.create_if_missing = true;
+  options.filter_policy = filter_policy_.get();
 
   std::string db_path = file_path;
   if (db_path.empty()) {
@@ -30,6 +37,16 @@ LeveldbKVStore::LeveldbKVStore(bool is_temp, const std::string &file_path)
   db_.reset(db_ptr);
   path_ = db_path;
   is_open_ = true;
+
+  // count existing keys once, then Count is maintained by Put.
+  size_t count = 0;
+  std::unique_ptr<leveldb::Iterator> it(
+      db_->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    count++;
+  }
+  YACL_ENFORCE(it->status().ok());
+  count_ = count;
 }
 
 LeveldbKVStore::~LeveldbKVStore() {
@@ -51,16 +68,55 @@ LeveldbKVStore::~LeveldbKVStore() {
   }
 }
 
+bool LeveldbKVStore::Exists(absl::string_view key) const {
+  std::string value;
+  leveldb::Status db_status = db_->Get(
+      leveldb::ReadOptions(), leveldb::Slice(key.data(), key.size()), &value);
+  if (!db_status.ok() && !db_status.IsNotFound()) {
+    YACL_THROW("Get key:{} error, {}", key, db_status.ToString());
+  }
+  return db_status.ok();
+}
+
 void LeveldbKVStore::Put(absl::string_view key, ByteContainerView value) {
   leveldb::Slice key_slice(key.data(), key.length());
   leveldb::Slice data_slice((const char *)value.data(), value.size());
 
+  const bool exists = Exists(key);
   leveldb::Status db_status =
       db_->Put(leveldb::WriteOptions(), key_slice, data_slice);
 
   if (!db_status.ok()) {
     YACL_THROW("Put key:{} error, {}", key, db_status.ToString());
   }
+  if (!exists) {
+    count_++;
+  }
+}
+
+void LeveldbKVStore::PutBatch(absl::Span<const absl::string_view> keys,
+                              absl::Span<const ByteContainerView> values) {
+  YACL_ENFORCE(keys.size() == values.size());
+  leveldb::WriteBatch batch;
+  // new keys in this batch, a key may appear more than once.
+  absl::flat_hash_set<absl::string_view> new_keys;
+  for (size_t i = 0; i < keys.size(); i++) {
+    batch.Put(leveldb::Slice(keys[i].data(), keys[i].size()),
+              leveldb::Slice(reinterpret_cast<const char *>(values[i].data()),
+                             values[i].size()));
+    if (!new_keys.contains(keys[i]) && !Exists(keys[i])) {
+      new_keys.insert(keys[i]);
+    }
+  }
+
+  leveldb::WriteOptions options;
+  options.sync = false;
+  leveldb::Status db_status = db_->Write(options, &batch);
+  if (!db_status.ok()) {
+    YACL_THROW("PutBatch of {} keys error, {}", keys.size(),
+               db_status.ToString());
+  }
+  count_ += new_keys.size();
 }
 
 bool LeveldbKVStore::Get(absl::string_view key, std::string *value) const {
@@ -79,19 +135,80 @@ bool LeveldbKVStore::Get(absl::string_view key, std::string *value) const {
   return true;
 }
 
-size_t LeveldbKVStore::Count() const {
+size_t LeveldbKVStore::MultiGet(absl::Span<const absl::string_view> keys,
+                                std::vector<std::string> *values,
+                                std::vector<uint8_t> *found) const {
+  values->assign(keys.size(), std::string());
+  if (found != nullptr) {
+    found->assign(keys.size(), 0);
+  }
+  // visit keys in order, so that one iterator walks the db forward.
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+
   size_t count = 0;
+  std::unique_ptr<leveldb::Iterator> it(
+      db_->NewIterator(leveldb::ReadOptions()));
+  for (auto i : order) {
+    leveldb::Slice key(keys[i].data(), keys[i].size());
+    it->Seek(key);
+    if (it->Valid() && it->key() == key) {
+      values->at(i).assign(it->value().data(), it->value().size());
+      if (found != nullptr) {
+        found->at(i) = 1;
+      }
+      count++;
+    }
+  }
+  YACL_ENFORCE(it->status().ok(), "MultiGet error, {}",
+               it->status().ToString());
+  return count;
+}
 
-  leveldb::Iterator *it = db_->NewIterator(leveldb::ReadOptions());
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    count++;
+namespace {
+
+class LeveldbKVIterator : public KVIterator {
+ public:
+  LeveldbKVIterator(leveldb::Iterator *it, absl::string_view begin,
+                    absl::string_view end)
+      : it_(it), end_(end) {
+    it_->Seek(leveldb::Slice(begin.data(), begin.size()));
   }
 
-  YACL_ENFORCE(it->status().ok());
+  bool Valid() const override {
+    if (!it_->Valid()) {
+      YACL_ENFORCE(it_->status().ok(), "leveldb iterator error, {}",
+                   it_->status().ToString());
+      return false;
+    }
+    return end_.empty() || Key() < end_;
+  }
 
-  delete it;
+  void Next() override { it_->Next(); }
 
-  return count;
+  absl::string_view Key() const override {
+    return {it_->key().data(), it_->key().size()};
+  }
+
+  ByteContainerView Value() const override {
+    return {it_->value().data(), it_->value().size()};
+  }
+
+ private:
+  std::unique_ptr<leveldb::Iterator> it_;
+  const std::string end_;
+};
+
+}  // namespace
+
+std::unique_ptr<KVIterator> LeveldbKVStore::NewIterator(
+    absl::string_view begin, absl::string_view end) const {
+  return std::make_unique<LeveldbKVIterator>(
+      db_->NewIterator(leveldb::ReadOptions()), begin, end);
 }
 
+size_t LeveldbKVStore::Count() const { return count_; }
+
 }  // namespace yacl::io
@@ -2,11 +2,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "leveldb/db.h"
+#include "leveldb/filter_policy.h"
 
 #include "yacl/io/kv/kvstore.h"
 
@@ -23,16 +25,37 @@ class LeveldbKVStore : public KVStore {
 
   void Put(absl::string_view key, ByteContainerView value) override;
 
+  // write all pairs in one leveldb::WriteBatch (sync off).
+  void PutBatch(absl::Span<const absl::string_view> keys,
+                absl::Span<const ByteContainerView> values) override;
+
   bool Get(absl::string_view key, std::string *value) const override;
 
+  // keys are looked up in sorted order by one iterator.
+  size_t MultiGet(absl::Span<const absl::string_view> keys,
+                  std::vector<std::string> *values,
+                  std::vector<uint8_t> *found = nullptr) const override;
+
+  std::unique_ptr<KVIterator> NewIterator(
+      absl::string_view begin = {}, absl::string_view end = {}) const override;
+
+  // O(1), keys of an existing db are counted once when it is opened, then
+  // Put/PutBatch add the keys not found by a Get (bloom filter backed) before
+  // the write. exact unless the same new key is put concurrently.
   size_t Count() const override;
 
  private:
+  bool Exists(absl::string_view key) const;
+
   std::string path_;
 
   bool is_open_ = false;
   bool is_temp_;
 
+  std::atomic<size_t> count_{0};
+
+  // bloom filter makes the existence check (for count) of new keys cheap.
+  std::unique_ptr<const leveldb::FilterPolicy> filter_policy_;
   std::unique_ptr<leveldb::DB> db_;
 };
 
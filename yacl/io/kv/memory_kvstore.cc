@@ -24,6 +24,41 @@ bool MemoryKVStore::Get(absl::string_view key, std::string *value) const {
   return false;
 }
 
+namespace {
+
+class MemoryKVIterator : public KVIterator {
+ public:
+  using Iter = std::map<std::string, Buffer>::const_iterator;
+
+  MemoryKVIterator(Iter begin, Iter end) : it_(begin), end_(end) {}
+
+  bool Valid() const override { return it_ != end_; }
+
+  void Next() override { ++it_; }
+
+  absl::string_view Key() const override { return it_->first; }
+
+  ByteContainerView Value() const override {
+    return ByteContainerView(it_->second);
+  }
+
+ private:
+  Iter it_;
+  Iter end_;
+};
+
+}  // namespace
+
+std::unique_ptr<KVIterator> MemoryKVStore::NewIterator(
+    absl::string_view begin, absl::string_view end) const {
+  auto begin_it = kv_map.lower_bound(std::string(begin));
+  auto end_it = kv_map.end();
+  if (!end.empty()) {
+    end_it = end <= begin ? begin_it : kv_map.lower_bound(std::string(end));
+  }
+  return std::make_unique<MemoryKVIterator>(begin_it, end_it);
+}
+
 size_t MemoryKVStore::Count() const { return kv_map.size(); }
 
 }  // namespace yacl::io
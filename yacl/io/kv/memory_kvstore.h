@@ -15,6 +15,9 @@ class MemoryKVStore : public KVStore {
   void Put(absl::string_view key, ByteContainerView value) override;
   bool Get(absl::string_view key, std::string *value) const override;
 
+  std::unique_ptr<KVIterator> NewIterator(
+      absl::string_view begin = {}, absl::string_view end = {}) const override;
+
   size_t Count() const override;
 
  private:
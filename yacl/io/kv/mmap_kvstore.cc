@@ -0,0 +1,412 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/io/kv/mmap_kvstore.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+#include "yacl/base/exception.h"
+
+namespace yacl::io {
+
+namespace {
+
+constexpr char kMagic[8] = {'Y', 'A', 'C', 'L', 'M', 'K', 'V', '\0'};
+constexpr uint32_t kVersion = 1;
+
+struct MmapKVHeader {
+  // written last by Finalize, zero while building.
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t num_slots;
+  uint64_t count;
+  uint64_t data_size;
+};
+
+// slots start at kHeaderSize of index file.
+constexpr size_t kHeaderSize = 64;
+static_assert(sizeof(MmapKVHeader) <= kHeaderSize);
+
+constexpr size_t kMinDataCapacity = 1 << 20;
+constexpr size_t kMinSlotCapacity = 1 << 12;
+
+#define MMAP_KV_THROW(msg_prefix, file, err)                              \
+  YACL_THROW_IO_ERROR(                                                    \
+      msg_prefix " error on file '{}', error msg '{}', error code {}",    \
+      file, std::strerror(err), err)
+
+std::string DataFile(const std::string &path) { return path + "/data"; }
+
+std::string IndexFile(const std::string &path) { return path + "/index"; }
+
+int OpenFile(const std::string &file, bool writable) {
+  int fd = writable
+               ? open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)
+               : open(file.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    MMAP_KV_THROW("Open", file, errno);
+  }
+  return fd;
+}
+
+size_t FileSize(int fd, const std::string &file) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    MMAP_KV_THROW("Stat", file, errno);
+  }
+  return st.st_size;
+}
+
+void ResizeFile(int fd, size_t size, const std::string &file) {
+  if (ftruncate(fd, size) != 0) {
+    MMAP_KV_THROW("Resize", file, errno);
+  }
+}
+
+void SyncFile(int fd, const std::string &file) {
+  if (fsync(fd) != 0) {
+    MMAP_KV_THROW("Sync", file, errno);
+  }
+}
+
+char *MapFile(int fd, size_t size, bool writable, const std::string &file) {
+  if (size == 0) {
+    return nullptr;
+  }
+  void *ret = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                   MAP_SHARED, fd, 0);
+  if (ret == MAP_FAILED) {
+    MMAP_KV_THROW("Mmap", file, errno);
+  }
+  return static_cast<char *>(ret);
+}
+
+void UnmapFile(char **data, size_t size) {
+  if (*data != nullptr) {
+    munmap(*data, size);
+    *data = nullptr;
+  }
+}
+
+// grow file to size and remap it, old mapping is kept if failed.
+void GrowFile(int fd, char **data, size_t *capacity, size_t size,
+              const std::string &file) {
+  ResizeFile(fd, size, file);
+  char *new_data = MapFile(fd, size, true, file);
+  UnmapFile(data, *capacity);
+  *data = new_data;
+  *capacity = size;
+}
+
+}  // namespace
+
+MmapKVStore::MmapKVStore(bool is_temp, const std::string &path)
+    : path_(path), is_temp_(is_temp) {
+  if (path_.empty()) {
+    std::string dir =
+        (std::filesystem::temp_directory_path() / "yacl_mmap_kv.XXXXXX")
+            .string();
+    YACL_ENFORCE(mkdtemp(dir.data()) != nullptr,
+                 "create temp dir {} failed, error msg '{}'", dir,
+                 std::strerror(errno));
+    path_ = dir;
+  } else {
+    std::filesystem::create_directories(path_);
+  }
+
+  // truncate index first, so an old store is invalid from now on.
+  index_fd_ = OpenFile(IndexFile(path_), true);
+  data_fd_ = OpenFile(DataFile(path_), true);
+  size_t index_capacity = 0;
+  GrowFile(index_fd_, &index_, &index_capacity,
+           kHeaderSize + kMinSlotCapacity * sizeof(Slot), IndexFile(path_));
+  slot_capacity_ = kMinSlotCapacity;
+  GrowFile(data_fd_, &data_, &data_capacity_, kMinDataCapacity,
+           DataFile(path_));
+}
+
+std::shared_ptr<MmapKVStore> MmapKVStore::Open(const std::string &path) {
+  std::shared_ptr<MmapKVStore> store(new MmapKVStore());
+  store->path_ = path;
+  store->read_only_ = true;
+
+  const auto index_file = IndexFile(path);
+  const auto data_file = DataFile(path);
+  store->index_fd_ = OpenFile(index_file, false);
+  store->data_fd_ = OpenFile(data_file, false);
+
+  const size_t index_size = FileSize(store->index_fd_, index_file);
+  if (index_size < kHeaderSize) {
+    YACL_THROW_INVALID_FORMAT("index file {} too small, size {}", index_file,
+                              index_size);
+  }
+  store->index_ = MapFile(store->index_fd_, index_size, false, index_file);
+  store->slot_capacity_ = (index_size - kHeaderSize) / sizeof(Slot);
+
+  MmapKVHeader header;
+  std::memcpy(&header, store->index_, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    YACL_THROW_INVALID_FORMAT("store {} is not finalized or corrupted", path);
+  }
+  if (header.version != kVersion) {
+    YACL_THROW_INVALID_FORMAT("store {} version {} not supported", path,
+                              header.version);
+  }
+  if (header.num_slots > kMaxSlots ||
+      index_size != kHeaderSize + header.num_slots * sizeof(Slot) ||
+      header.count > header.num_slots) {
+    YACL_THROW_INVALID_FORMAT(
+        "index file {} corrupted, size {}, num_slots {}, count {}",
+        index_file, index_size, header.num_slots, header.count);
+  }
+  const size_t data_size = FileSize(store->data_fd_, data_file);
+  if (data_size != header.data_size) {
+    YACL_THROW_INVALID_FORMAT("data file {} size mismatch, {} vs {}",
+                              data_file, data_size, header.data_size);
+  }
+  store->data_ = MapFile(store->data_fd_, data_size, false, data_file);
+  store->data_capacity_ = data_size;
+  store->data_size_ = data_size;
+  store->num_slots_ = header.num_slots;
+  store->count_ = header.count;
+  return store;
+}
+
+MmapKVStore::~MmapKVStore() {
+  if (!read_only_ && !is_temp_ && index_ != nullptr) {
+    try {
+      Finalize();
+    } catch (const std::exception &e) {
+      // Nothing we can do here.
+      SPDLOG_ERROR("Finalize mmap kvstore:{} exception {}", path_,
+                   std::string(e.what()));
+    }
+  }
+  Close();
+  if (is_temp_) {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+    if (ec) {
+      SPDLOG_INFO("Delete tmp dir:{} error {}", path_, ec.message());
+    }
+  }
+}
+
+void MmapKVStore::Close() {
+  UnmapFile(&data_, data_capacity_);
+  UnmapFile(&index_, kHeaderSize + slot_capacity_ * sizeof(Slot));
+  if (data_fd_ >= 0) {
+    close(data_fd_);
+    data_fd_ = -1;
+  }
+  if (index_fd_ >= 0) {
+    close(index_fd_);
+    index_fd_ = -1;
+  }
+}
+
+void MmapKVStore::Reserve(size_t num_slots, size_t data_size) {
+  if (num_slots > slot_capacity_) {
+    size_t index_capacity = kHeaderSize + slot_capacity_ * sizeof(Slot);
+    const size_t capacity =
+        std::min(std::max(num_slots, slot_capacity_ * 2), kMaxSlots);
+    // new slots are zero filled, i.e. not exist.
+    GrowFile(index_fd_, &index_, &index_capacity,
+             kHeaderSize + capacity * sizeof(Slot), IndexFile(path_));
+    slot_capacity_ = capacity;
+  }
+  if (data_size > data_capacity_) {
+    GrowFile(data_fd_, &data_, &data_capacity_,
+             std::max(data_size, data_capacity_ * 2), DataFile(path_));
+  }
+}
+
+void MmapKVStore::Append(size_t index, ByteContainerView value) {
+  auto *slot = reinterpret_cast<Slot *>(index_ + kHeaderSize) + index;
+  if (!value.empty()) {
+    std::memcpy(data_ + data_size_, value.data(), value.size());
+  }
+  if (slot->size == 0) {
+    count_++;
+  }
+  slot->offset = data_size_;
+  slot->size = value.size() + 1;
+  data_size_ += value.size();
+  num_slots_ = std::max(num_slots_, index + 1);
+}
+
+void MmapKVStore::Put(absl::string_view key, ByteContainerView value) {
+  YACL_ENFORCE(!read_only_, "mmap kvstore {} is read-only", path_);
+  const size_t index = IndexStore::KeyToIndex(key);
+  YACL_ENFORCE(index < kMaxSlots, "index {} out of range, max {}", index,
+               kMaxSlots - 1);
+  Reserve(std::max(num_slots_, index + 1), data_size_ + value.size());
+  Append(index, value);
+}
+
+void MmapKVStore::PutBatch(absl::Span<const absl::string_view> keys,
+                           absl::Span<const ByteContainerView> values) {
+  YACL_ENFORCE(!read_only_, "mmap kvstore {} is read-only", path_);
+  YACL_ENFORCE(keys.size() == values.size());
+  std::vector<size_t> indexes(keys.size());
+  size_t num_slots = num_slots_;
+  size_t data_size = data_size_;
+  for (size_t i = 0; i < keys.size(); i++) {
+    indexes[i] = IndexStore::KeyToIndex(keys[i]);
+    YACL_ENFORCE(indexes[i] < kMaxSlots, "index {} out of range, max {}",
+                 indexes[i], kMaxSlots - 1);
+    num_slots = std::max(num_slots, indexes[i] + 1);
+    data_size += values[i].size();
+  }
+  Reserve(num_slots, data_size);
+  for (size_t i = 0; i < keys.size(); i++) {
+    Append(indexes[i], values[i]);
+  }
+}
+
+const MmapKVStore::Slot *MmapKVStore::GetSlot(size_t index) const {
+  if (index >= num_slots_) {
+    return nullptr;
+  }
+  const auto *slot =
+      reinterpret_cast<const Slot *>(index_ + kHeaderSize) + index;
+  if (slot->size == 0) {
+    return nullptr;
+  }
+  if (slot->offset > data_size_ || slot->size - 1 > data_size_ - slot->offset) {
+    YACL_THROW_INVALID_FORMAT(
+        "mmap kvstore {} corrupted, index {} offset {} size {} out of {}",
+        path_, index, slot->offset, slot->size - 1, data_size_);
+  }
+  return slot;
+}
+
+bool MmapKVStore::Get(size_t index, ByteContainerView *value) const {
+  const auto *slot = GetSlot(index);
+  if (slot == nullptr) {
+    return false;
+  }
+  if (slot->size == 1) {
+    *value = ByteContainerView();
+  } else {
+    *value = ByteContainerView(data_ + slot->offset, slot->size - 1);
+  }
+  return true;
+}
+
+bool MmapKVStore::Get(absl::string_view key, std::string *value) const {
+  ByteContainerView view;
+  if (!Get(IndexStore::KeyToIndex(key), &view)) {
+    return false;
+  }
+  value->assign(reinterpret_cast<const char *>(view.data()), view.size());
+  return true;
+}
+
+void MmapKVStore::Finalize() {
+  if (read_only_) {
+    return;
+  }
+  const auto index_file = IndexFile(path_);
+  const auto data_file = DataFile(path_);
+
+  // data: drop reserved tail & flush.
+  UnmapFile(&data_, data_capacity_);
+  ResizeFile(data_fd_, data_size_, data_file);
+  SyncFile(data_fd_, data_file);
+  data_ = MapFile(data_fd_, data_size_, false, data_file);
+  data_capacity_ = data_size_;
+
+  // index: header without magic, slots, then magic.
+  auto *header = reinterpret_cast<MmapKVHeader *>(index_);
+  header->version = kVersion;
+  header->num_slots = num_slots_;
+  header->count = count_;
+  header->data_size = data_size_;
+  const size_t index_size = kHeaderSize + num_slots_ * sizeof(Slot);
+  UnmapFile(&index_, kHeaderSize + slot_capacity_ * sizeof(Slot));
+  ResizeFile(index_fd_, index_size, index_file);
+  SyncFile(index_fd_, index_file);
+  if (pwrite(index_fd_, kMagic, sizeof(kMagic), 0) !=
+      static_cast<ssize_t>(sizeof(kMagic))) {
+    MMAP_KV_THROW("Write", index_file, errno);
+  }
+  SyncFile(index_fd_, index_file);
+  index_ = MapFile(index_fd_, index_size, false, index_file);
+  slot_capacity_ = num_slots_;
+
+  read_only_ = true;
+}
+
+namespace {
+
+class MmapKVIterator : public KVIterator {
+ public:
+  MmapKVIterator(const MmapKVStore *store, size_t begin, size_t end)
+      : store_(store), index_(begin), end_(std::min(end, store->Slots())) {
+    Skip();
+  }
+
+  bool Valid() const override { return index_ < end_; }
+
+  void Next() override {
+    index_++;
+    Skip();
+  }
+
+  absl::string_view Key() const override { return {key_.data(), key_.size()}; }
+
+  ByteContainerView Value() const override { return value_; }
+
+ private:
+  // move to the first existing index from index_.
+  void Skip() {
+    while (index_ < end_ && !store_->Get(index_, &value_)) {
+      index_++;
+    }
+    if (index_ < end_) {
+      key_ = IndexStore::IndexToKey(index_);
+    }
+  }
+
+  const MmapKVStore *store_;
+  size_t index_;
+  const size_t end_;
+  IndexStore::Key key_;
+  ByteContainerView value_;
+};
+
+}  // namespace
+
+std::unique_ptr<KVIterator> MmapKVStore::NewIterator(
+    absl::string_view begin, absl::string_view end) const {
+  return std::make_unique<MmapKVIterator>(
+      this, begin.empty() ? 0 : IndexStore::KeyToIndex(begin),
+      end.empty() ? SIZE_MAX : IndexStore::KeyToIndex(end));
+}
+
+}  // namespace yacl::io
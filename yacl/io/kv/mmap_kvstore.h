@@ -0,0 +1,118 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "yacl/io/kv/kvstore.h"
+
+namespace yacl::io {
+
+// Append-only store for dense index keys (0..N-1), e.g. under IndexStore.
+//
+// A store is a directory of two mmapped files:
+//  - data:  values appended in Put order.
+//  - index: header + fixed width slot {offset, size} of every index.
+// so Get is one slot lookup & memcpy without syscall.
+//
+// Keys must be IndexStore keys (8 bytes big endian index), and the index file
+// has a slot for every index below the max one, so keep indexes dense.
+// Put of an existing index appends the new value, the old one is not
+// reclaimed. Not thread safe for writes.
+//
+// Finalize flushes both files and then marks the header valid, so a store
+// that crashed before Finalize is rejected by Open.
+class MmapKVStore : public KVStore {
+ public:
+  // max index + 1 of a store, i.e. 64GB index file.
+  static constexpr uint64_t kMaxSlots = 1ULL << 32;
+
+  // create an empty store in directory path, existing store is replaced.
+  // give empty path create a temp store, temp store (directory) is removed by
+  // destructor, others are finalized by destructor.
+  explicit MmapKVStore(bool is_temp, const std::string &path = "");
+
+  // open a finalized store read-only.
+  static std::shared_ptr<MmapKVStore> Open(const std::string &path);
+
+  ~MmapKVStore() override;
+
+  MmapKVStore(const MmapKVStore &) = delete;
+  MmapKVStore &operator=(const MmapKVStore &) = delete;
+
+  void Put(absl::string_view key, ByteContainerView value) override;
+
+  // data file grows once for the whole batch.
+  void PutBatch(absl::Span<const absl::string_view> keys,
+                absl::Span<const ByteContainerView> values) override;
+
+  bool Get(absl::string_view key, std::string *value) const override;
+
+  // zero copy get, value is valid until next Put or destruction.
+  bool Get(size_t index, ByteContainerView *value) const;
+
+  // iterate existing indexes in order.
+  std::unique_ptr<KVIterator> NewIterator(
+      absl::string_view begin = {}, absl::string_view end = {}) const override;
+
+  size_t Count() const override { return count_; }
+
+  // max index + 1
+  size_t Slots() const { return num_slots_; }
+
+  // flush data & index to disk and mark store valid, store is read-only after
+  // this. no-op if already finalized.
+  void Finalize();
+
+  bool IsFinalized() const { return read_only_; }
+
+  const std::string &GetPath() const { return path_; }
+
+ private:
+  struct Slot {
+    uint64_t offset;
+    // value size + 1, 0 if index not exists (zero filled by ftruncate).
+    uint64_t size;
+  };
+
+  MmapKVStore() = default;
+
+  const Slot *GetSlot(size_t index) const;
+  // grow (mapped) files to hold num_slots slots & data_size bytes.
+  void Reserve(size_t num_slots, size_t data_size);
+  void Append(size_t index, ByteContainerView value);
+  void Close();
+
+  std::string path_;
+  bool is_temp_ = false;
+  bool read_only_ = false;
+
+  int data_fd_ = -1;
+  char *data_ = nullptr;
+  size_t data_capacity_ = 0;
+  size_t data_size_ = 0;
+
+  int index_fd_ = -1;
+  // header & slots
+  char *index_ = nullptr;
+  size_t slot_capacity_ = 0;
+  size_t num_slots_ = 0;
+
+  size_t count_ = 0;
+};
+
+}  // namespace yacl::io
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "yacl/base/buffer.h"
 
 namespace yacl::io {
@@ -27,6 +29,7 @@ class StreamBuffer {
 
   void write(const char *str, size_t len) {
     auto old_sz = buf_->size();
+    Grow(len);
     buf_->resize(buf_->size() + len);
     std::memcpy(buf_->data<char>() + old_sz, str, len);
   }
@@ -39,12 +42,28 @@ class StreamBuffer {
   }
 
   char *PosLoc() const { return buf_->data<char>() + buf_->size(); }
-  void IncPos(int64_t delta) { buf_->resize(buf_->size() + delta); }
+  void IncPos(int64_t delta) {
+    if (delta > 0) {
+      Grow(delta);
+    }
+    buf_->resize(buf_->size() + delta);
+  }
 
   size_t WrittenSize() { return buf_->size(); }
   size_t FreeSize() const { return buf_->capacity() - buf_->size(); }
 
  private:
+  // grow capacity geometrically, so that n small writes cost O(n) copies
+  // instead of O(n^2).
+  void Grow(size_t len) {
+    auto need = buf_->size() + static_cast<int64_t>(len);
+    if (need > buf_->capacity()) {
+      buf_->reserve(std::max({need, buf_->capacity() * 2, kMinCapacity}));
+    }
+  }
+
+  static constexpr int64_t kMinCapacity = 64;
+
   Buffer *buf_;
 };
 
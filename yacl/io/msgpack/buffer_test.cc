@@ -14,7 +14,13 @@
 
 #include "yacl/io/msgpack/buffer.h"
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "msgpack.hpp"
+
+#include "yacl/io/msgpack/spec_traits.h"
 
 namespace yacl::io::test {
 
@@ -31,4 +37,71 @@ TEST(TestStreamBuffer, SimpleWorks) {
   EXPECT_EQ(std::string(buffer.data<char>(), buffer.size()), "abcd");
 }
 
+TEST(TestStreamBuffer, GrowWorks) {
+  Buffer buffer;
+  StreamBuffer sbuf(&buffer);
+
+  std::string expected;
+  for (int i = 0; i < 1000; ++i) {
+    auto str = std::to_string(i);
+    sbuf.write(str);
+    expected += str;
+  }
+  EXPECT_EQ(std::string(buffer.data<char>(), buffer.size()), expected);
+  // grows geometrically
+  EXPECT_LT(buffer.capacity(), static_cast<int64_t>(expected.size()) * 2);
+  EXPECT_GE(sbuf.FreeSize(), 0);
+}
+
+TEST(TestSpecTraits, StrArrayWorks) {
+  std::vector<std::string> strs;
+  for (size_t len : {0, 1, 31, 32, 255, 256, 65535, 65536}) {
+    strs.emplace_back(len, static_cast<char>('a' + len % 26));
+  }
+  for (size_t array_len : {0, 3, 15, 16, 65536}) {
+    std::vector<std::string> items(array_len);
+    for (size_t i = 0; i < array_len; ++i) {
+      items[i] = strs[i % strs.size()];
+    }
+
+    Buffer expected;
+    StreamBuffer sbuf(&expected);
+    msgpack::pack(sbuf, items);
+
+    // write heads & payloads
+    size_t size = msgpack_traits::HeadSizeOfArray(items.size());
+    for (const auto& item : items) {
+      size += msgpack_traits::HeadSizeOfStr(item.size()) + item.size();
+    }
+    ASSERT_EQ(size, expected.size());
+    std::string packed(size, '\0');
+    size_t pos = msgpack_traits::WriteArrayHead(items.size(), packed.data());
+    for (const auto& item : items) {
+      pos += msgpack_traits::WriteStrHead(item.size(), packed.data() + pos);
+      std::memcpy(packed.data() + pos, item.data(), item.size());
+      pos += item.size();
+    }
+    EXPECT_EQ(packed, std::string_view(expected));
+
+    // zero-copy read
+    pos = 0;
+    ByteContainerView view(expected.data<uint8_t>(), expected.size());
+    ASSERT_EQ(msgpack_traits::ReadArrayHead(view, &pos), items.size());
+    for (const auto& item : items) {
+      auto str = msgpack_traits::ReadStr(view, &pos);
+      EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(str.data()),
+                                 str.size()),
+                item);
+    }
+    EXPECT_EQ(pos, expected.size());
+  }
+
+  // truncated & wrong type
+  size_t pos = 0;
+  std::string bad = "\xda\x01";
+  EXPECT_ANY_THROW(msgpack_traits::ReadStr(bad, &pos));
+  pos = 0;
+  EXPECT_ANY_THROW(msgpack_traits::ReadArrayHead(bad, &pos));
+}
+
 }  // namespace yacl::io::test
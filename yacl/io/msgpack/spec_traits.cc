@@ -14,8 +14,35 @@
 
 #include "yacl/io/msgpack/spec_traits.h"
 
+#include <algorithm>
+#include <cstdint>
+
+#include "yacl/base/exception.h"
+
 namespace yacl::io::msgpack_traits {
 
+namespace {
+
+// msgpack stores lengths in big endian.
+void StoreBigEndian(uint64_t value, size_t bytes, char *buf) {
+  for (size_t i = 0; i < bytes; ++i) {
+    buf[i] = static_cast<char>(value >> (8 * (bytes - 1 - i)));
+  }
+}
+
+uint64_t LoadBigEndian(ByteContainerView buf, size_t pos, size_t bytes) {
+  YACL_ENFORCE(pos + bytes <= buf.size(),
+               "msgpack object truncated, pos={}, need={}, buf_len={}", pos,
+               bytes, buf.size());
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value = (value << 8) | buf[pos + i];
+  }
+  return value;
+}
+
+}  // namespace
+
 size_t HeadSizeOfStr(size_t str_len) {
   // Str format family stores a byte array in 1, 2, 3, or 5 bytes of extra bytes
   // in addition to the size of the byte array.
@@ -75,4 +102,93 @@ size_t HeadSizeOfArray(size_t array_len) {
   }
 }
 
+size_t WriteStrHead(size_t str_len, char *buf) {
+  if (str_len < 32) {
+    buf[0] = static_cast<char>(0xa0 | str_len);
+    return 1;
+  } else if (str_len < 256) {
+    buf[0] = static_cast<char>(0xd9);
+    StoreBigEndian(str_len, 1, buf + 1);
+    return 2;
+  } else if (str_len < 65536) {
+    buf[0] = static_cast<char>(0xda);
+    StoreBigEndian(str_len, 2, buf + 1);
+    return 3;
+  } else {
+    YACL_ENFORCE(str_len <= UINT32_MAX, "str too long for msgpack, len={}",
+                 str_len);
+    buf[0] = static_cast<char>(0xdb);
+    StoreBigEndian(str_len, 4, buf + 1);
+    return 5;
+  }
+}
+
+size_t WriteArrayHead(size_t array_len, char *buf) {
+  if (array_len < 16) {
+    buf[0] = static_cast<char>(0x90 | array_len);
+    return 1;
+  } else if (array_len < 65536) {
+    buf[0] = static_cast<char>(0xdc);
+    StoreBigEndian(array_len, 2, buf + 1);
+    return 3;
+  } else {
+    YACL_ENFORCE(array_len <= UINT32_MAX,
+                 "array too long for msgpack, len={}", array_len);
+    buf[0] = static_cast<char>(0xdd);
+    StoreBigEndian(array_len, 4, buf + 1);
+    return 5;
+  }
+}
+
+size_t ReadArrayHead(ByteContainerView buf, size_t *pos) {
+  const uint8_t type = LoadBigEndian(buf, *pos, 1);
+  size_t len;
+  if ((type & 0xf0) == 0x90) {  // fixarray
+    len = type & 0x0f;
+    *pos += 1;
+  } else if (type == 0xdc) {  // array 16
+    len = LoadBigEndian(buf, *pos + 1, 2);
+    *pos += 3;
+  } else if (type == 0xdd) {  // array 32
+    len = LoadBigEndian(buf, *pos + 1, 4);
+    *pos += 5;
+  } else {
+    YACL_THROW("msgpack object at pos {} is not an array, type=0x{:x}", *pos,
+               type);
+  }
+  // every element takes 1 byte at least.
+  YACL_ENFORCE(len <= buf.size() - std::min(*pos, buf.size()),
+               "msgpack array truncated, pos={}, len={}, buf_len={}", *pos,
+               len, buf.size());
+  return len;
+}
+
+ByteContainerView ReadStr(ByteContainerView buf, size_t *pos) {
+  const uint8_t type = LoadBigEndian(buf, *pos, 1);
+  size_t head;
+  size_t len;
+  if ((type & 0xe0) == 0xa0) {  // fixstr
+    head = 1;
+    len = type & 0x1f;
+  } else if (type == 0xd9 || type == 0xc4) {  // str 8 / bin 8
+    head = 2;
+    len = LoadBigEndian(buf, *pos + 1, 1);
+  } else if (type == 0xda || type == 0xc5) {  // str 16 / bin 16
+    head = 3;
+    len = LoadBigEndian(buf, *pos + 1, 2);
+  } else if (type == 0xdb || type == 0xc6) {  // str 32 / bin 32
+    head = 5;
+    len = LoadBigEndian(buf, *pos + 1, 4);
+  } else {
+    YACL_THROW("msgpack object at pos {} is not a str/bin, type=0x{:x}", *pos,
+               type);
+  }
+  YACL_ENFORCE(*pos + head + len <= buf.size(),
+               "msgpack str truncated, pos={}, len={}, buf_len={}", *pos, len,
+               buf.size());
+  ByteContainerView ret(buf.data() + *pos + head, len);
+  *pos += head + len;
+  return ret;
+}
+
 }  // namespace yacl::io::msgpack_traits
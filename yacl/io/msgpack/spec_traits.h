@@ -16,6 +16,8 @@
 
 #include <cstdlib>
 
+#include "yacl/base/byte_container_view.h"
+
 namespace yacl::io::msgpack_traits {
 
 // The msgpack spec:
@@ -27,4 +29,23 @@ size_t HeadSizeOfStr(size_t str_len);
 // get the head size of array according to msgpack spec
 size_t HeadSizeOfArray(size_t array_len);
 
+// write the head of str to buf, buf must have HeadSizeOfStr(str_len) bytes.
+// @return: the head size
+size_t WriteStrHead(size_t str_len, char *buf);
+
+// write the head of array to buf, buf must have HeadSizeOfArray(array_len)
+// bytes.
+// @return: the head size
+size_t WriteArrayHead(size_t array_len, char *buf);
+
+// Zero-copy readers, parse the object at buf[*pos] and move *pos to the next
+// object. Throw if the object is truncated or has an unexpected type.
+
+// @return: the element count of array
+size_t ReadArrayHead(ByteContainerView buf, size_t *pos);
+
+// read a str or bin object.
+// @return: the payload, pointing into buf
+ByteContainerView ReadStr(ByteContainerView buf, size_t *pos);
+
 }  // namespace yacl::io::msgpack_traits
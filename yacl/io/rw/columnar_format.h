@@ -0,0 +1,86 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/crc/crc32c.h"
+#include "absl/strings/string_view.h"
+
+namespace yacl::io {
+
+// Columnar binary file layout (host byte order, i.e. little endian):
+/*
+  ┌──────────────────┬───────────────────────┬────────┬─────┬──────────┬───
+  │ColumnarFileHeader│ColumnarColumnMeta * N │ names  │ pad │ column 0 │...
+  └──────────────────┴───────────────────────┴────────┴─────┴──────────┴───
+*/
+// Every column starts at a kColumnarAlign aligned offset, so it can be used
+// in place after the file is mmapped.
+//   FLOAT  column: float[rows]
+//   DOUBLE column: double[rows]
+//   STRING column: uint64_t offsets[rows + 1], then all bytes.
+//                  the i-th string is bytes[offsets[i], offsets[i + 1]).
+
+inline constexpr char kColumnarMagic[8] = {'Y', 'A', 'C', 'L',
+                                           'C', 'O', 'L', '\0'};
+inline constexpr uint32_t kColumnarVersion = 1;
+inline constexpr size_t kColumnarAlign = 64;
+
+struct ColumnarFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_cols;
+  uint64_t num_rows;
+  // bytes of ColumnarColumnMeta * N + names.
+  uint64_t meta_size;
+  // crc32c of ColumnarColumnMeta * N + names.
+  uint32_t meta_crc;
+  // crc32c of all fields above.
+  uint32_t header_crc;
+};
+
+struct ColumnarColumnMeta {
+  // Schema::Type
+  uint32_t type;
+  uint32_t name_size;
+  // from file begin.
+  uint64_t offset;
+  uint64_t size;
+  // crc32c of column data.
+  uint32_t crc;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(ColumnarFileHeader) == 40);
+static_assert(sizeof(ColumnarColumnMeta) == 32);
+
+inline uint32_t ColumnarCrc(const void* data, size_t size,
+                            uint32_t init = 0) {
+  return static_cast<uint32_t>(absl::ExtendCrc32c(
+      absl::crc32c_t{init},
+      absl::string_view(static_cast<const char*>(data), size)));
+}
+
+inline uint32_t ColumnarHeaderCrc(const ColumnarFileHeader& header) {
+  return ColumnarCrc(&header, offsetof(ColumnarFileHeader, header_crc));
+}
+
+inline constexpr size_t ColumnarAlignUp(size_t n) {
+  return (n + kColumnarAlign - 1) / kColumnarAlign * kColumnarAlign;
+}
+
+}  // namespace yacl::io
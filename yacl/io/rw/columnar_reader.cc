@@ -0,0 +1,275 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/io/rw/columnar_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "yacl/base/exception.h"
+
+namespace yacl::io {
+
+ColumnarReader::ColumnarReader(ReaderOptions options, std::string path,
+                               bool verify_checksum)
+    : options_(std::move(options)),
+      path_(std::move(path)),
+      verify_checksum_(verify_checksum),
+      inited_(false),
+      current_index_(0),
+      total_rows_(0) {}
+
+void ColumnarReader::Init() {
+  YACL_ENFORCE(!inited_, "DO NOT call init multiply times");
+
+  file_ = std::make_shared<MmappedFile>(path_);
+  const char* data = file_->data();
+  const size_t size = file_->size();
+
+  // header
+  ColumnarFileHeader header;
+  if (size < sizeof(header)) {
+    YACL_THROW_INVALID_FORMAT("Columnar file '{}' is too short", path_);
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, kColumnarMagic, sizeof(header.magic)) != 0 ||
+      header.version != kColumnarVersion) {
+    YACL_THROW_INVALID_FORMAT("'{}' is not a columnar file (version {})",
+                              path_, kColumnarVersion);
+  }
+  if (header.header_crc != ColumnarHeaderCrc(header)) {
+    YACL_THROW_INVALID_FORMAT("Columnar file '{}' header checksum error",
+                              path_);
+  }
+  if (header.meta_size > size - sizeof(header) ||
+      header.meta_size <
+          uint64_t{header.num_cols} * sizeof(ColumnarColumnMeta)) {
+    YACL_THROW_INVALID_FORMAT("Columnar file '{}' header error", path_);
+  }
+  const char* meta_data = data + sizeof(header);
+  if (header.meta_crc != ColumnarCrc(meta_data, header.meta_size)) {
+    YACL_THROW_INVALID_FORMAT("Columnar file '{}' meta checksum error",
+                              path_);
+  }
+  total_rows_ = header.num_rows;
+
+  // column metas & names
+  metas_.resize(header.num_cols);
+  std::memcpy(metas_.data(), meta_data,
+              metas_.size() * sizeof(ColumnarColumnMeta));
+  const char* names = meta_data + metas_.size() * sizeof(ColumnarColumnMeta);
+  const char* names_end = meta_data + header.meta_size;
+  headers_.reserve(metas_.size());
+  for (const auto& meta : metas_) {
+    if (meta.name_size > static_cast<size_t>(names_end - names) ||
+        meta.offset % kColumnarAlign != 0 || meta.offset > size ||
+        meta.size > size - meta.offset) {
+      YACL_THROW_INVALID_FORMAT("Columnar file '{}' column meta error", path_);
+    }
+    headers_.emplace_back(names, meta.name_size);
+    names += meta.name_size;
+  }
+
+  // select features
+  const auto& schema = options_.file_schema;
+  YACL_ENFORCE(schema.feature_names.size() == schema.feature_types.size());
+  const size_t f_size = schema.feature_names.size();
+  // col reader do not support empty feature.
+  YACL_ENFORCE(options_.column_reader == false || f_size > 0);
+  selected_features_.reserve(f_size);
+  for (size_t i = 0; i < f_size; i++) {
+    const auto& f_name = schema.feature_names[i];
+    auto it = std::find(headers_.begin(), headers_.end(), f_name);
+    if (it == headers_.end()) {
+      YACL_THROW_ARGUMENT_ERROR(
+          "Columnar read options error: "
+          "can't find feature names '{}' in file '{}'",
+          f_name, path_);
+    }
+    size_t idx = std::distance(headers_.begin(), it);
+    if (metas_[idx].type != static_cast<uint32_t>(schema.feature_types[i])) {
+      YACL_THROW_ARGUMENT_ERROR(
+          "Columnar read options error: "
+          "feature '{}' type {} != file's type {}, file '{}'",
+          f_name, static_cast<int>(schema.feature_types[i]),
+          metas_[idx].type, path_);
+    }
+    selected_features_.emplace_back(idx, schema.feature_types[i]);
+  }
+
+  if (options_.use_header_order) {
+    std::sort(selected_features_.begin(), selected_features_.end(),
+              [](auto& a, auto& b) { return a.first < b.first; });
+  }
+
+  // check selected columns only.
+  for (const auto& [idx, type] : selected_features_) {
+    const auto& meta = metas_[idx];
+    const char* col = data + meta.offset;
+    switch (type) {
+      case Schema::FLOAT:
+      case Schema::DOUBLE: {
+        const size_t width =
+            type == Schema::FLOAT ? sizeof(float) : sizeof(double);
+        if (meta.size % width != 0 || meta.size / width != total_rows_) {
+          YACL_THROW_INVALID_FORMAT(
+              "Columnar file '{}' column '{}' size error", path_,
+              headers_[idx]);
+        }
+        break;
+      }
+      case Schema::STRING: {
+        const auto* offsets = reinterpret_cast<const uint64_t*>(col);
+        if (meta.size / sizeof(uint64_t) <= total_rows_ || offsets[0] != 0 ||
+            offsets[total_rows_] !=
+                meta.size - (total_rows_ + 1) * sizeof(uint64_t)) {
+          YACL_THROW_INVALID_FORMAT(
+              "Columnar file '{}' column '{}' size error", path_,
+              headers_[idx]);
+        }
+        break;
+      }
+      default:
+        YACL_THROW("unknow Schema::type {}", static_cast<int>(type));
+    }
+    if (verify_checksum_ && meta.crc != ColumnarCrc(col, meta.size)) {
+      YACL_THROW_INVALID_FORMAT("Columnar file '{}' column '{}' checksum error",
+                                path_, headers_[idx]);
+    }
+  }
+
+  inited_ = true;
+  Seek(0);
+}
+
+absl::string_view ColumnarReader::GetString(size_t col, size_t row) const {
+  YACL_ENFORCE(inited_, "Please Call Init before use reader");
+  const auto& meta = Meta(col);
+  YACL_ENFORCE(meta.type == Schema::STRING, "column {} type mismatch", col);
+  YACL_ENFORCE(row < total_rows_);
+  const char* data = file_->data() + meta.offset;
+  const auto* offsets = reinterpret_cast<const uint64_t*>(data);
+  const char* bytes = data + (total_rows_ + 1) * sizeof(uint64_t);
+  // offsets are not checked one by one in Init.
+  YACL_ENFORCE(offsets[row] <= offsets[row + 1] &&
+               offsets[row + 1] <= offsets[total_rows_]);
+  return {bytes + offsets[row], offsets[row + 1] - offsets[row]};
+}
+
+ColumnType ColumnarReader::CopyColumn(size_t col, size_t begin,
+                                      size_t end) const {
+  switch (selected_features_[col].second) {
+    case Schema::FLOAT: {
+      auto values = ColumnData<float>(col).subspan(begin, end - begin);
+      return FloatColumnVector(values.begin(), values.end());
+    }
+    case Schema::DOUBLE: {
+      auto values = ColumnData<double>(col).subspan(begin, end - begin);
+      return DoubleColumnVector(values.begin(), values.end());
+    }
+    case Schema::STRING: {
+      StringColumnVector values;
+      values.reserve(end - begin);
+      for (size_t r = begin; r < end; r++) {
+        values.emplace_back(GetString(col, r));
+      }
+      return values;
+    }
+    default:
+      YACL_THROW("unknow Schema::type {}",
+                 static_cast<int>(selected_features_[col].second));
+  }
+}
+
+bool ColumnarReader::Next(ColumnVectorBatch* data) {
+  YACL_ENFORCE(inited_, "Please Call Init before use reader");
+  data->Clear();
+  if (options_.column_reader) {
+    return NextCol(data);
+  } else {
+    return NextRow(data, options_.batch_size);
+  }
+}
+
+bool ColumnarReader::Next(size_t size, ColumnVectorBatch* data) {
+  YACL_ENFORCE(size != 0);
+  YACL_ENFORCE(inited_, "Please Call Init before use reader");
+  data->Clear();
+  if (options_.column_reader) {
+    size_t count = 0;
+    while (count < size) {
+      if (!NextCol(data)) {
+        break;
+      }
+      count++;
+    }
+    return count != 0;
+  } else {
+    return NextRow(data, size);
+  }
+}
+
+bool ColumnarReader::NextCol(ColumnVectorBatch* data) {
+  if (current_index_ == selected_features_.size()) {
+    return false;
+  }
+  data->AppendCol(CopyColumn(current_index_, 0, total_rows_));
+  current_index_++;
+  return true;
+}
+
+bool ColumnarReader::NextRow(ColumnVectorBatch* data, size_t batch_size) {
+  if (current_index_ == total_rows_) {
+    return false;
+  }
+  const size_t end = std::min(total_rows_, current_index_ + batch_size);
+  if (!selected_features_.empty()) {
+    data->Reserve(selected_features_.size());
+    for (size_t i = 0; i < selected_features_.size(); i++) {
+      data->AppendCol(CopyColumn(i, current_index_, end));
+    }
+  } else {
+    *data = ColumnVectorBatch::EmptyBatch(end - current_index_);
+  }
+  current_index_ = end;
+  return true;
+}
+
+void ColumnarReader::Seek(size_t index) {
+  YACL_ENFORCE(inited_, "Please Call Init before use reader");
+  const size_t limit =
+      options_.column_reader ? selected_features_.size() : total_rows_;
+  // seek to the end (EOF) is allowed if there is no data.
+  YACL_ENFORCE(index < limit || index == 0,
+               "seek out of range, try {} max {}", index, limit);
+  current_index_ = index;
+}
+
+std::unique_ptr<Reader> ColumnarReader::Spawn() {
+  YACL_ENFORCE(inited_, "CAN NOT Spawn before init");
+  std::unique_ptr<ColumnarReader> ret(
+      new ColumnarReader(options_, path_, verify_checksum_));
+  // share the mapped file, checks are done already.
+  ret->file_ = file_;
+  ret->headers_ = headers_;
+  ret->metas_ = metas_;
+  ret->selected_features_ = selected_features_;
+  ret->current_index_ = current_index_;
+  ret->total_rows_ = total_rows_;
+  ret->inited_ = true;
+  return ret;
+}
+
+}  // namespace yacl::io
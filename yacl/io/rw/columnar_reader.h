@@ -0,0 +1,135 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+#include "yacl/io/rw/columnar_format.h"
+#include "yacl/io/rw/mmapped_file.h"
+#include "yacl/io/rw/reader.h"
+
+namespace yacl::io {
+
+// Read columnar binary file (see columnar_format.h) written by
+// ColumnarWriter.
+//
+// The file is mmapped, only features in options.file_schema are checked &
+// read (column projection). Besides the Reader interface (which copies data
+// into ColumnVectorBatch), columns can be accessed in place by
+// ColumnData/GetString without any copy.
+class ColumnarReader : public Reader {
+ public:
+  // verify_checksum: verify crc of all selected columns in Init.
+  ColumnarReader(ReaderOptions options, std::string path,
+                 bool verify_checksum = true);
+
+  ~ColumnarReader() override = default;
+
+  void Init() override;
+
+  const std::vector<std::string>& Headers() const override {
+    YACL_ENFORCE(inited_, "Please Call Init before use reader");
+    return headers_;
+  }
+
+  bool Next(ColumnVectorBatch* data) override;
+
+  bool Next(size_t size, ColumnVectorBatch* data) override;
+
+  size_t Tell() const override {
+    YACL_ENFORCE(inited_, "Please Call Init before use reader");
+    return current_index_;
+  }
+
+  void Seek(size_t index) override;
+
+  size_t Rows() const override {
+    YACL_ENFORCE(inited_, "Please Call Init before use reader");
+    return total_rows_;
+  }
+
+  size_t Cols() const override {
+    YACL_ENFORCE(inited_, "Please Call Init before use reader");
+    return selected_features_.size();
+  }
+
+  size_t GetLength() const override {
+    YACL_ENFORCE(inited_, "Please Call Init before use reader");
+    return file_->size();
+  }
+
+  // columnar file has no row position in bytes.
+  size_t Tellg() override {
+    YACL_THROW("Not callable for columnar file");
+  }
+
+  std::unique_ptr<Reader> Spawn() override;
+
+  // columnar file has no row position in bytes, use Seek or ColumnData
+  // instead.
+  std::vector<std::unique_ptr<Reader>> Split(size_t) override {
+    YACL_THROW("Not callable for columnar file");
+  }
+
+  // Zero copy access, col is index of selected features.
+  // FLOAT / DOUBLE column values.
+  template <typename T>
+  absl::Span<const T> ColumnData(size_t col) const {
+    YACL_ENFORCE(inited_, "Please Call Init before use reader");
+    const auto& meta = Meta(col);
+    constexpr auto kType =
+        std::is_same_v<T, float> ? Schema::FLOAT : Schema::DOUBLE;
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>);
+    YACL_ENFORCE(meta.type == kType, "column {} type mismatch", col);
+    return {reinterpret_cast<const T*>(file_->data() + meta.offset),
+            total_rows_};
+  }
+
+  // STRING column value.
+  absl::string_view GetString(size_t col, size_t row) const;
+
+ private:
+  const ColumnarColumnMeta& Meta(size_t col) const {
+    YACL_ENFORCE(col < selected_features_.size());
+    return metas_[selected_features_[col].first];
+  }
+
+  ColumnType CopyColumn(size_t col, size_t begin, size_t end) const;
+
+  bool NextCol(ColumnVectorBatch*);
+  bool NextRow(ColumnVectorBatch*, size_t);
+
+  const ReaderOptions options_;
+  const std::string path_;
+  const bool verify_checksum_;
+  bool inited_;
+  std::shared_ptr<MmappedFile> file_;
+  std::vector<std::string> headers_;
+  std::vector<ColumnarColumnMeta> metas_;
+  // selected_features' index & type.
+  std::vector<std::pair<size_t, Schema::Type>> selected_features_;
+  // current row or col.
+  size_t current_index_;
+  size_t total_rows_;
+};
+
+}  // namespace yacl::io
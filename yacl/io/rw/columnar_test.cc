@@ -0,0 +1,187 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+#include "yacl/base/exception.h"
+#include "yacl/io/rw/columnar_reader.h"
+#include "yacl/io/rw/columnar_writer.h"
+#include "yacl/io/rw/csv_reader.h"
+#include "yacl/io/stream/mem_io.h"
+
+namespace yacl::io {
+
+class ColumnarTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = fmt::format("columnar_test.{}.bin", getpid());
+
+    std::string input = "id , f1 , f2 , label\n";
+    for (size_t i = 0; i < kRows; i++) {
+      input += fmt::format("u{}, {} , {} , {}\n", std::string(i % 7, 'x'),
+                           i * 0.5, -1.25 * i, i % 2);
+    }
+    ReaderOptions r_ops;
+    r_ops.file_schema = schema_;
+    r_ops.batch_size = 7;
+    CsvReader reader(r_ops, std::make_unique<MemInputStream>(input));
+    reader.Init();
+    EXPECT_EQ(ConvertToColumnar(&reader, schema_, path_), kRows);
+  }
+
+  void TearDown() override { std::filesystem::remove(path_); }
+
+  static constexpr size_t kRows = 100;
+  std::string path_;
+  Schema schema_{{Schema::STRING, Schema::FLOAT, Schema::DOUBLE,
+                  Schema::DOUBLE},
+                 {"id", "f1", "f2", "label"}};
+};
+
+TEST_F(ColumnarTest, RowReaderWorks) {
+  ReaderOptions r_ops;
+  r_ops.file_schema = {{Schema::DOUBLE, Schema::STRING}, {"f2", "id"}};
+  r_ops.batch_size = 30;
+
+  ColumnarReader reader(r_ops, path_);
+  reader.Init();
+  EXPECT_EQ(reader.Rows(), kRows);
+  EXPECT_EQ(reader.Cols(), 2);
+  EXPECT_EQ(reader.Headers(),
+            std::vector<std::string>({"id", "f1", "f2", "label"}));
+
+  ColumnVectorBatch batch;
+  size_t row = 0;
+  while (reader.Next(&batch)) {
+    EXPECT_EQ(batch.Shape().cols, 2);
+    for (size_t r = 0; r < batch.Shape().rows; r++, row++) {
+      EXPECT_EQ(batch.At<double>(r, 0), -1.25 * row);
+      EXPECT_EQ(batch.At<std::string>(r, 1), "u" + std::string(row % 7, 'x'));
+    }
+  }
+  EXPECT_EQ(row, kRows);
+  EXPECT_EQ(reader.Tell(), kRows);
+
+  reader.Seek(95);
+  auto spawned = reader.Spawn();
+  EXPECT_TRUE(spawned->Next(&batch));
+  EXPECT_EQ(batch.Shape().rows, 5);
+  EXPECT_EQ(batch.At<double>(0, 0), -1.25 * 95);
+  EXPECT_FALSE(spawned->Next(&batch));
+
+  // in place access
+  auto f2 = reader.ColumnData<double>(0);
+  ASSERT_EQ(f2.size(), kRows);
+  EXPECT_EQ(f2[42], -1.25 * 42);
+  EXPECT_EQ(reader.GetString(1, 13), "uxxxxxx");
+  EXPECT_THROW(reader.ColumnData<float>(0), yacl::EnforceNotMet);
+}
+
+TEST_F(ColumnarTest, ColReaderWorks) {
+  ReaderOptions r_ops;
+  r_ops.file_schema = {{Schema::DOUBLE, Schema::FLOAT}, {"label", "f1"}};
+  r_ops.column_reader = true;
+  r_ops.use_header_order = true;
+
+  ColumnarReader reader(r_ops, path_);
+  reader.Init();
+
+  ColumnVectorBatch batch;
+  EXPECT_TRUE(reader.Next(&batch));
+  EXPECT_EQ(batch.Shape().rows, kRows);
+  EXPECT_EQ(batch.At<float>(9, 0), 4.5);
+  EXPECT_TRUE(reader.Next(&batch));
+  EXPECT_EQ(batch.At<double>(9, 0), 1);
+  EXPECT_FALSE(reader.Next(&batch));
+
+  reader.Seek(0);
+  EXPECT_TRUE(reader.Next(2, &batch));
+  EXPECT_EQ(batch.Shape().cols, 2);
+}
+
+TEST_F(ColumnarTest, ErrorWorks) {
+  {  // schema error
+    ReaderOptions r_ops;
+    r_ops.file_schema = {{Schema::FLOAT}, {"f2"}};
+    ColumnarReader reader(r_ops, path_);
+    EXPECT_THROW(reader.Init(), yacl::ArgumentError);
+  }
+  {  // not exist
+    ReaderOptions r_ops;
+    r_ops.file_schema = {{Schema::FLOAT}, {"f3"}};
+    ColumnarReader reader(r_ops, path_);
+    EXPECT_THROW(reader.Init(), yacl::ArgumentError);
+  }
+  {  // data corruption, only checked if the column is selected.
+    const auto size = std::filesystem::file_size(path_);
+    std::fstream f(path_, std::ios::in | std::ios::out | std::ios::binary);
+    // last value of label column.
+    f.seekp(static_cast<std::streamoff>(size - kColumnarAlign + 1));
+    f.put('\x7f');
+    f.close();
+
+    ReaderOptions r_ops;
+    r_ops.file_schema = {{Schema::FLOAT}, {"f1"}};
+    ColumnarReader good(r_ops, path_);
+    good.Init();
+
+    r_ops.file_schema = {{Schema::DOUBLE}, {"label"}};
+    ColumnarReader bad(r_ops, path_);
+    EXPECT_THROW(bad.Init(), yacl::InvalidFormat);
+    ColumnarReader no_check(r_ops, path_, false);
+    no_check.Init();
+  }
+}
+
+TEST_F(ColumnarTest, SpillRemoved) {
+  auto count_spills = [] {
+    size_t n = 0;
+    for (const auto& e : std::filesystem::directory_iterator(
+             std::filesystem::temp_directory_path())) {
+      if (e.path().filename().string().rfind("yacl_columnar.", 0) == 0) {
+        n++;
+      }
+    }
+    return n;
+  };
+  const size_t before = count_spills();
+
+  WriterOptions w_op;
+  w_op.file_schema = schema_;
+  std::string out;
+  {  // removed by Close.
+    ColumnarWriter writer(w_op, std::make_unique<MemOutputStream>(&out));
+    writer.Init();
+    EXPECT_EQ(count_spills(), before + 1);
+    writer.Close();
+    EXPECT_EQ(count_spills(), before);
+  }
+  {  // removed by destructor.
+    out.clear();
+    ColumnarWriter writer(w_op, std::make_unique<MemOutputStream>(&out));
+    writer.Init();
+    EXPECT_EQ(count_spills(), before + 1);
+  }
+  EXPECT_EQ(count_spills(), before);
+}
+
+}  // namespace yacl::io
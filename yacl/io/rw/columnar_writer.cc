@@ -0,0 +1,278 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/io/rw/columnar_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/crc/crc32c.h"
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include "yacl/base/exception.h"
+#include "yacl/io/rw/columnar_format.h"
+#include "yacl/io/stream/file_io.h"
+
+namespace yacl::io {
+
+namespace {
+
+constexpr size_t kCopyBufferSize = 1 << 20;
+
+void SpillWrite(OutputStream* out, const void* data, size_t size,
+                uint64_t* total, uint32_t* crc) {
+  out->Write(data, size);
+  *total += size;
+  *crc = ColumnarCrc(data, size, *crc);
+}
+
+template <typename T>
+void SpillValues(const ColumnVector<T>& col, OutputStream* out,
+                 uint64_t* total, uint32_t* crc) {
+  SpillWrite(out, col.data(), col.size() * sizeof(T), total, crc);
+}
+
+void CopySpill(const std::string& path, size_t size, OutputStream* out) {
+  FileInputStream in(path);
+  YACL_ENFORCE(in.GetLength() == size, "spill {} size {} != expected {}",
+               path, in.GetLength(), size);
+  std::string buf(std::min(size, kCopyBufferSize), '\0');
+  while (size > 0) {
+    const size_t n = std::min(size, buf.size());
+    in.Read(buf.data(), n);
+    out->Write(buf.data(), n);
+    size -= n;
+  }
+}
+
+void WritePadding(OutputStream* out, size_t size) {
+  static const char kZeros[kColumnarAlign] = {};
+  YACL_ENFORCE(size <= kColumnarAlign);
+  out->Write(kZeros, size);
+}
+
+}  // namespace
+
+ColumnarWriter::ColumnarWriter(WriterOptions op,
+                               std::unique_ptr<OutputStream> out)
+    : options_(std::move(op)),
+      inited_(false),
+      flushed_(false),
+      rows_(0),
+      out_(std::move(out)) {
+  YACL_ENFORCE(!options_.file_schema.feature_names.empty());
+  YACL_ENFORCE(options_.file_schema.feature_names.size() ==
+               options_.file_schema.feature_types.size());
+  YACL_ENFORCE(out_->Tellp() == 0);
+}
+
+ColumnarWriter::~ColumnarWriter() { RemoveSpillDir(); }
+
+void ColumnarWriter::RemoveSpillDir() {
+  // close spills before remove them.
+  cols_.clear();
+  if (spill_dir_.empty()) {
+    return;
+  }
+  std::error_code ec;
+  std::filesystem::remove_all(spill_dir_, ec);
+  if (ec) {
+    SPDLOG_INFO("Delete tmp dir:{} error {}", spill_dir_, ec.message());
+  }
+  spill_dir_.clear();
+}
+
+void ColumnarWriter::Init() {
+  YACL_ENFORCE(!inited_, "DO NOT call init multiply times");
+  std::string dir =
+      (std::filesystem::temp_directory_path() / "yacl_columnar.XXXXXX")
+          .string();
+  YACL_ENFORCE(mkdtemp(dir.data()) != nullptr,
+               "create temp dir {} failed, error msg '{}'", dir,
+               std::strerror(errno));
+  spill_dir_ = dir;
+
+  const auto& types = options_.file_schema.feature_types;
+  cols_.resize(types.size());
+  for (size_t c = 0; c < types.size(); c++) {
+    auto& spill = cols_[c];
+    spill.data_path = fmt::format("{}/{}.data", spill_dir_, c);
+    spill.data =
+        std::make_unique<FileOutputStream>(spill.data_path, true, false);
+    if (types[c] == Schema::STRING) {
+      spill.offsets_path = fmt::format("{}/{}.offsets", spill_dir_, c);
+      spill.offsets =
+          std::make_unique<FileOutputStream>(spill.offsets_path, true, false);
+      const uint64_t zero = 0;
+      SpillWrite(spill.offsets.get(), &zero, sizeof(zero),
+                 &spill.offsets_size, &spill.offsets_crc);
+    }
+  }
+  inited_ = true;
+}
+
+bool ColumnarWriter::Add(const ColumnVectorBatch& data) {
+  YACL_ENFORCE(inited_, "Please Call Init before use writer");
+  YACL_ENFORCE(!flushed_, "ColumnarWriter can not Add after Flush");
+  const size_t rows = data.Shape().rows;
+  const size_t cols = data.Shape().cols;
+  YACL_ENFORCE(cols == options_.file_schema.feature_names.size());
+  const auto& types = options_.file_schema.feature_types;
+
+  std::string bytes;
+  std::vector<uint64_t> offsets;
+  for (size_t c = 0; c < cols; c++) {
+    auto& spill = cols_[c];
+    switch (types[c]) {
+      case Schema::FLOAT: {
+        SpillValues(data.Col<float>(c), spill.data.get(), &spill.data_size,
+                    &spill.data_crc);
+        break;
+      }
+      case Schema::DOUBLE: {
+        SpillValues(data.Col<double>(c), spill.data.get(), &spill.data_size,
+                    &spill.data_crc);
+        break;
+      }
+      case Schema::STRING: {
+        bytes.clear();
+        offsets.clear();
+        for (const auto& s : data.Col<std::string>(c)) {
+          bytes.append(s);
+          offsets.push_back(spill.data_size + bytes.size());
+        }
+        SpillWrite(spill.data.get(), bytes.data(), bytes.size(),
+                   &spill.data_size, &spill.data_crc);
+        SpillWrite(spill.offsets.get(), offsets.data(),
+                   offsets.size() * sizeof(uint64_t), &spill.offsets_size,
+                   &spill.offsets_crc);
+        break;
+      }
+      default:
+        YACL_THROW("unknow Schema::type {}", static_cast<int>(types[c]));
+    }
+  }
+  rows_ += rows;
+  return true;
+}
+
+void ColumnarWriter::Flush() {
+  YACL_ENFORCE(inited_, "Please Call Init before use writer");
+  if (flushed_) {
+    out_->Flush();
+    return;
+  }
+  const auto& names = options_.file_schema.feature_names;
+  const auto& types = options_.file_schema.feature_types;
+
+  for (auto& spill : cols_) {
+    spill.data->Close();
+    if (spill.offsets) {
+      spill.offsets->Close();
+    }
+  }
+
+  // metas & names.
+  std::vector<ColumnarColumnMeta> metas(cols_.size());
+  std::string all_names;
+  for (const auto& name : names) {
+    all_names.append(name);
+  }
+  const size_t meta_size =
+      metas.size() * sizeof(ColumnarColumnMeta) + all_names.size();
+  size_t offset = ColumnarAlignUp(sizeof(ColumnarFileHeader) + meta_size);
+  for (size_t c = 0; c < cols_.size(); c++) {
+    const auto& spill = cols_[c];
+    auto& meta = metas[c];
+    std::memset(&meta, 0, sizeof(meta));
+    meta.type = static_cast<uint32_t>(types[c]);
+    meta.name_size = names[c].size();
+    meta.offset = offset;
+    if (types[c] == Schema::STRING) {
+      meta.size = spill.offsets_size + spill.data_size;
+      // crc of offsets then bytes, as they are laid out in the file.
+      meta.crc = static_cast<uint32_t>(absl::ConcatCrc32c(
+          absl::crc32c_t{spill.offsets_crc}, absl::crc32c_t{spill.data_crc},
+          spill.data_size));
+    } else {
+      meta.size = spill.data_size;
+      meta.crc = spill.data_crc;
+    }
+    offset = ColumnarAlignUp(offset + meta.size);
+  }
+
+  ColumnarFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kColumnarMagic, sizeof(header.magic));
+  header.version = kColumnarVersion;
+  header.num_cols = cols_.size();
+  header.num_rows = rows_;
+  header.meta_size = meta_size;
+  header.meta_crc = ColumnarCrc(metas.data(),
+                                metas.size() * sizeof(ColumnarColumnMeta));
+  header.meta_crc =
+      ColumnarCrc(all_names.data(), all_names.size(), header.meta_crc);
+  header.header_crc = ColumnarHeaderCrc(header);
+
+  out_->Write(&header, sizeof(header));
+  out_->Write(metas.data(), metas.size() * sizeof(ColumnarColumnMeta));
+  out_->Write(all_names.data(), all_names.size());
+  size_t pos = sizeof(header) + meta_size;
+  for (size_t c = 0; c < cols_.size(); c++) {
+    const auto& spill = cols_[c];
+    WritePadding(out_.get(), metas[c].offset - pos);
+    if (types[c] == Schema::STRING) {
+      CopySpill(spill.offsets_path, spill.offsets_size, out_.get());
+    }
+    CopySpill(spill.data_path, spill.data_size, out_.get());
+    pos = metas[c].offset + metas[c].size;
+  }
+  // so that every column offset is inside the file.
+  WritePadding(out_.get(), ColumnarAlignUp(pos) - pos);
+  out_->Flush();
+  flushed_ = true;
+  RemoveSpillDir();
+}
+
+void ColumnarWriter::Close() {
+  if (inited_) {
+    Flush();
+  }
+  out_->Close();
+}
+
+size_t ConvertToColumnar(Reader* reader, const Schema& schema,
+                         const std::string& path) {
+  WriterOptions w_op;
+  w_op.file_schema = schema;
+  ColumnarWriter writer(w_op, std::make_unique<FileOutputStream>(path));
+  writer.Init();
+  ColumnVectorBatch batch;
+  size_t rows = 0;
+  while (reader->Next(&batch)) {
+    rows += batch.Shape().rows;
+    writer.Add(batch);
+  }
+  writer.Close();
+  return rows;
+}
+
+}  // namespace yacl::io
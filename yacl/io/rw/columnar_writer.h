@@ -0,0 +1,86 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yacl/io/rw/reader.h"
+#include "yacl/io/rw/schema.h"
+#include "yacl/io/rw/writer.h"
+
+namespace yacl::io {
+
+// Write row batches into columnar binary format, see columnar_format.h
+//
+// Column sizes must be known before any column is written, so Add streams
+// every column into its own spill file (in final binary layout) under a temp
+// dir, and Flush/Close writes the header then concatenates the spills into
+// the output. Memory usage is bounded by one batch. Add after Flush is not
+// allowed.
+class ColumnarWriter : public Writer {
+ public:
+  ColumnarWriter(WriterOptions, std::unique_ptr<OutputStream>);
+
+  ~ColumnarWriter() override;
+
+  void Init() override;
+
+  bool Add(const ColumnVectorBatch&) override;
+
+  // write whole file.
+  void Flush() override;
+
+  void Close() override;
+
+  size_t Tellp() override {
+    YACL_ENFORCE(inited_, "Please Call Init before use writer");
+    return out_->Tellp();
+  }
+
+ private:
+  struct ColumnSpill {
+    // FLOAT / DOUBLE values, or STRING bytes.
+    std::string data_path;
+    std::unique_ptr<OutputStream> data;
+    uint64_t data_size = 0;
+    uint32_t data_crc = 0;
+    // STRING only, offsets[0] is written by Init.
+    std::string offsets_path;
+    std::unique_ptr<OutputStream> offsets;
+    uint64_t offsets_size = 0;
+    uint32_t offsets_crc = 0;
+  };
+
+  void RemoveSpillDir();
+
+  const WriterOptions options_;
+  bool inited_;
+  bool flushed_;
+  size_t rows_;
+  std::string spill_dir_;
+  std::vector<ColumnSpill> cols_;
+  std::unique_ptr<OutputStream> out_;
+};
+
+// Read all rows from an inited ROW reader (e.g. CsvReader) and write them into
+// a columnar binary file at path, so the csv is parsed only once.
+// schema: batches' columns returned by reader, in order.
+// return rows written.
+size_t ConvertToColumnar(Reader* reader, const Schema& schema,
+                         const std::string& path);
+
+}  // namespace yacl::io
@@ -17,36 +17,156 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cstring>
+#include <exception>
 #include <filesystem>
 #include <iterator>
+#include <limits>
+#include <mutex>
 #include <optional>
 #include <random>
 #include <string>
 #include <utility>
+#include <variant>
+#include <vector>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "absl/crc/crc32c.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_split.h"
 #include "fmt/format.h"
+#include "spdlog/spdlog.h"
 
 #include "yacl/base/exception.h"
 #include "yacl/io/rw/float.h"
 #include "yacl/io/rw/mmapped_file.h"
 #include "yacl/io/stream/file_io.h"
+#include "yacl/utils/parallel.h"
 
 namespace yacl::io {
 
 static const size_t kUnknowTotalRow = size_t(-1);
+// end_pos_ if read till EOF.
+static const size_t kNoEndPos = size_t(-1);
+
+namespace {
+
+// parallel_parse: bytes read from input each time.
+constexpr size_t kBlockSize = 4 * 1024 * 1024;
+// parallel_parse: min rows per parse task.
+constexpr int64_t kParseGrainSize = 256;
+
+// row index sidecar file:
+// | RowIndexHeader | (row, position) * num_entries |
+constexpr char kRowIndexMagic[8] = {'Y', 'A', 'C', 'L', 'R', 'I', 'D', 'X'};
+constexpr uint64_t kRowIndexVersion = 2;
+// bytes hashed from both the begin & the end of input as its fingerprint.
+constexpr size_t kRowIndexFingerprintBlock = 64 * 1024;
+
+struct RowIndexHeader {
+  char magic[8];
+  uint64_t version;
+  // the sidecar is valid only if these match the input & reader options.
+  uint64_t input_length;
+  // 0 if input is not a local file.
+  uint64_t input_mtime;
+  uint64_t input_fingerprint;
+  uint64_t line_delimiter;
+  uint64_t interval;
+  uint64_t total_rows;
+  uint64_t num_entries;
+};
+
+// Fill input_* of header. A cheap check instead of hashing the whole input:
+// appends & in place edits near either end change the length or fingerprint,
+// other rewrites of a local file change its mtime.
+void FingerprintInput(InputStream* in, RowIndexHeader* header) {
+  const size_t length = in->GetLength();
+  header->input_length = length;
+
+  std::error_code ec;
+  const auto mtime = std::filesystem::last_write_time(in->GetName(), ec);
+  header->input_mtime =
+      ec ? 0 : static_cast<uint64_t>(mtime.time_since_epoch().count());
+
+  const size_t pos = in->Tellg();
+  const size_t block = std::min(length, kRowIndexFingerprintBlock);
+  std::string buf(block, '\0');
+  in->Seekg(0);
+  in->Read(buf.data(), block);
+  auto crc = absl::ComputeCrc32c(buf);
+  in->Seekg(length - block);
+  in->Read(buf.data(), block);
+  YACL_ENFORCE(!!*in, "read input {} failed", in->GetName());
+  crc = absl::ExtendCrc32c(crc, buf);
+  header->input_fingerprint = static_cast<uint32_t>(crc);
+  in->Seekg(pos);
+}
+
+// Append offsets (plus base) of the first max_num char c in data[0, len) to
+// out, return bytes scanned, i.e. one past the last found c, or len if less
+// than max_num found.
+size_t FindChar(const char* data, size_t len, char c, size_t max_num,
+                size_t base, std::vector<size_t>* out) {
+  size_t found = 0;
+  size_t i = 0;
+#ifdef __AVX2__
+  // simdcsv-style: compare 64 bytes into one bitmap, then walk set bits.
+  const __m256i pattern = _mm256_set1_epi8(c);
+  for (; i + 64 <= len; i += 64) {
+    auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    auto hi =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+    uint64_t bits = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, pattern)));
+    bits |= static_cast<uint64_t>(static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, pattern))))
+            << 32;
+    while (bits != 0) {
+      const size_t pos = i + __builtin_ctzll(bits);
+      out->push_back(base + pos);
+      if (++found == max_num) {
+        return pos + 1;
+      }
+      bits &= bits - 1;
+    }
+  }
+#endif
+  while (i < len) {
+    const auto* p =
+        static_cast<const char*>(std::memchr(data + i, c, len - i));
+    if (p == nullptr) {
+      break;
+    }
+    const size_t pos = p - data;
+    out->push_back(base + pos);
+    if (++found == max_num) {
+      return pos + 1;
+    }
+    i = pos + 1;
+  }
+  return len;
+}
+
+}  // namespace
 
 CsvReader::CsvReader(ReaderOptions options, std::unique_ptr<InputStream> in,
                      char field_delimiter, char line_delimiter)
     : options_(std::move(options)),
       field_delimiter_(field_delimiter),
       line_delimiter_(line_delimiter),
+      row_index_interval_(options_.row_index_interval == 0
+                              ? options_.batch_size
+                              : options_.row_index_interval),
       inited_(false),
       in_(std::move(in)),
       current_index_(0),
-      total_rows_(kUnknowTotalRow) {}
+      total_rows_(kUnknowTotalRow),
+      end_pos_(kNoEndPos) {}
 
 CsvReader::MmapDirGuard::~MmapDirGuard() {
   if (!dir_.empty()) {
@@ -96,8 +216,9 @@ void CsvReader::Init() {
   } else {
     // init rows_map_, in_->Tell() is the point to ROW 0's start position.
     UpdateRowMap();
-    if (options_.row_reader_count_lines) {
+    if (options_.row_reader_count_lines && !LoadRowIndex()) {
       CountLines();
+      SaveRowIndex();
     }
   }
   inited_ = true;
@@ -105,16 +226,106 @@ void CsvReader::Init() {
 }
 
 void CsvReader::CountLines() {
+  if (options_.parallel_parse) {
+    CountLinesParallel();
+    return;
+  }
   while (in_->GetLine(&current_line_, line_delimiter_)) {
     current_index_++;
-    if (current_index_ % options_.batch_size == 0) {
+    if (current_index_ % row_index_interval_ == 0) {
       UpdateRowMap();
     }
   }
   total_rows_ = current_index_;
 }
 
+bool CsvReader::LoadRowIndex() {
+  const auto& path = options_.row_index_file;
+  if (path.empty() || !std::filesystem::exists(path)) {
+    return false;
+  }
+  FileInputStream in(path);
+  RowIndexHeader header;
+  // FileInputStream throws on short reads, check sizes before reading so a
+  // truncated sidecar is rebuilt instead of failing Init().
+  const size_t length = in.GetLength();
+  if (length < sizeof(header)) {
+    return false;
+  }
+  in.Read(&header, sizeof(header));
+  constexpr size_t kEntrySize = 2 * sizeof(uint64_t);
+  const size_t entries_bytes = length - sizeof(header);
+  if (std::memcmp(header.magic, kRowIndexMagic, 8) != 0 ||
+      header.version != kRowIndexVersion ||
+      header.line_delimiter != static_cast<uint8_t>(line_delimiter_) ||
+      header.interval != row_index_interval_ ||
+      entries_bytes % kEntrySize != 0 ||
+      header.num_entries != entries_bytes / kEntrySize) {
+    // corrupted or from other options, rebuild it.
+    return false;
+  }
+  // only hash the input once the sidecar itself looks valid.
+  RowIndexHeader input;
+  FingerprintInput(in_.get(), &input);
+  if (header.input_length != input.input_length ||
+      header.input_mtime != input.input_mtime ||
+      header.input_fingerprint != input.input_fingerprint) {
+    // stale, rebuild it.
+    return false;
+  }
+  std::vector<uint64_t> entries(header.num_entries * 2);
+  in.Read(entries.data(), entries_bytes);
+  for (size_t i = 0; i < entries.size(); i += 2) {
+    rows_map_[entries[i]] = entries[i + 1];
+  }
+  total_rows_ = header.total_rows;
+  return true;
+}
+
+void CsvReader::SaveRowIndex() {
+  const auto& path = options_.row_index_file;
+  if (path.empty()) {
+    return;
+  }
+  // the sidecar is only a cache, failing to save it (e.g. read only dir or
+  // disk full) must not fail the reader.
+  const auto tmp_path = fmt::format("{}.{}.tmp", path, getpid());
+  try {
+    RowIndexHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kRowIndexMagic, 8);
+    header.version = kRowIndexVersion;
+    FingerprintInput(in_.get(), &header);
+    header.line_delimiter = static_cast<uint8_t>(line_delimiter_);
+    header.interval = row_index_interval_;
+    header.total_rows = total_rows_;
+    header.num_entries = rows_map_.size();
+    std::vector<uint64_t> entries;
+    entries.reserve(rows_map_.size() * 2);
+    for (const auto& [row, pos] : rows_map_) {
+      entries.push_back(row);
+      entries.push_back(pos);
+    }
+    // write & rename, readers never see a partial sidecar.
+    {
+      FileOutputStream out(tmp_path, true, false);
+      out.Write(&header, sizeof(header));
+      out.Write(entries.data(), entries.size() * sizeof(uint64_t));
+      out.Close();
+    }
+    std::filesystem::rename(tmp_path, path);
+  } catch (const std::exception& e) {
+    SPDLOG_WARN("save row index of {} to {} failed, {}", in_->GetName(), path,
+                e.what());
+    std::error_code ec;
+    std::filesystem::remove(tmp_path, ec);
+  }
+}
+
 bool CsvReader::NextLine(std::vector<absl::string_view>* fields) {
+  if (end_pos_ != kNoEndPos && in_->Tellg() >= end_pos_) {
+    return false;
+  }
   if (!in_->GetLine(&current_line_, line_delimiter_)) {
     return false;
   }
@@ -150,13 +361,81 @@ void CsvReader::ParseHeader() {
   }
 }
 
-void CsvReader::UpdateRowMap() {
+void CsvReader::UpdateRowMap() { UpdateRowMap(StreamTellg()); }
+
+void CsvReader::UpdateRowMap(size_t pos) {
   auto it = rows_map_.upper_bound(current_index_);
   if (it != rows_map_.end()) {
     return;
   }
   YACL_ENFORCE(!options_.column_reader);
-  rows_map_.insert({current_index_, in_->Tellg()});
+  rows_map_.insert({current_index_, pos});
+}
+
+size_t CsvReader::StreamTellg() {
+  return in_->Tellg() - (block_buf_.size() - block_pos_);
+}
+
+bool CsvReader::StreamEof() {
+  if (options_.parallel_parse) {
+    return block_eof_;
+  }
+  return in_->Eof() || (end_pos_ != kNoEndPos && in_->Tellg() >= end_pos_);
+}
+
+bool CsvReader::ReadBlock() {
+  const size_t pos = in_->Tellg();
+  const size_t len = std::min(in_->GetLength(), end_pos_);
+  if (pos >= len) {
+    return false;
+  }
+  const size_t size = std::min(kBlockSize, len - pos);
+  const size_t old_size = block_buf_.size();
+  block_buf_.resize(old_size + size);
+  in_->Read(block_buf_.data() + old_size, size);
+  const size_t read = in_->Tellg() - pos;
+  YACL_ENFORCE(read <= size);
+  block_buf_.resize(old_size + read);
+  return read != 0;
+}
+
+void CsvReader::ResetBlock() {
+  if (block_pos_ != block_buf_.size()) {
+    in_->Seekg(StreamTellg());
+  }
+  block_buf_.clear();
+  block_pos_ = 0;
+  block_eof_ = false;
+}
+
+void CsvReader::CountLinesParallel() {
+  ResetBlock();
+  std::vector<size_t> ends;
+  size_t base = in_->Tellg();
+  bool tail = false;  // bytes after last line delimiter
+  while (ReadBlock()) {
+    ends.clear();
+    FindChar(block_buf_.data(), block_buf_.size(), line_delimiter_,
+             std::numeric_limits<size_t>::max(), 0, &ends);
+    for (auto end : ends) {
+      current_index_++;
+      if (current_index_ % row_index_interval_ == 0) {
+        UpdateRowMap(base + end + 1);
+      }
+    }
+    tail = ends.empty() ? (tail || !block_buf_.empty())
+                        : (ends.back() + 1 != block_buf_.size());
+    base += block_buf_.size();
+    block_buf_.clear();
+  }
+  if (tail) {
+    // last line without delimiter.
+    current_index_++;
+    if (current_index_ % row_index_interval_ == 0) {
+      UpdateRowMap(base);
+    }
+  }
+  total_rows_ = current_index_;
 }
 
 void CsvReader::BuildMmapFiles() {
@@ -382,15 +661,8 @@ void CsvReader::InitBatchCols(std::vector<ColumnType>* cols,
   }
 }
 
-bool CsvReader::NextRow(ColumnVectorBatch* data, size_t batch_size) {
-  if (in_->Eof()) {
-    // EOF
-    return false;
-  }
-
-  std::vector<ColumnType> cols;
-  InitBatchCols(&cols, batch_size);
-
+size_t CsvReader::ParseRows(std::vector<ColumnType>* cols,
+                            size_t batch_size) {
   size_t count = 0;
   std::vector<absl::string_view> fields;
   while (count < batch_size && NextLine(&fields)) {
@@ -410,7 +682,7 @@ bool CsvReader::NextRow(ColumnVectorBatch* data, size_t batch_size) {
       auto& field = fields[index];
       switch (type) {
         case Schema::STRING: {
-          auto& col = std::get<StringColumnVector>(cols.at(i));
+          auto& col = std::get<StringColumnVector>(cols->at(i));
           col.emplace_back(field.data(), field.size());
           break;
         }
@@ -424,7 +696,7 @@ bool CsvReader::NextRow(ColumnVectorBatch* data, size_t batch_size) {
                 in_->GetName());
           }
 
-          auto& col = std::get<FloatColumnVector>(cols.at(i));
+          auto& col = std::get<FloatColumnVector>(cols->at(i));
           col.push_back(value);
           break;
         }
@@ -438,7 +710,7 @@ bool CsvReader::NextRow(ColumnVectorBatch* data, size_t batch_size) {
                 in_->GetName());
           }
 
-          auto& col = std::get<DoubleColumnVector>(cols.at(i));
+          auto& col = std::get<DoubleColumnVector>(cols->at(i));
           col.push_back(value);
           break;
         }
@@ -447,12 +719,164 @@ bool CsvReader::NextRow(ColumnVectorBatch* data, size_t batch_size) {
       }
     }
   }
+  return count;
+}
+
+size_t CsvReader::ParseRowsParallel(std::vector<ColumnType>* cols,
+                                    size_t batch_size) {
+  // drop parsed bytes.
+  block_buf_.erase(0, block_pos_);
+  block_pos_ = 0;
+
+  // locate lines, the i-th line ends at line_ends[i].
+  std::vector<size_t> line_ends;
+  line_ends.reserve(std::min<size_t>(batch_size, 1 << 20));
+  size_t scan_pos = 0;
+  bool has_delimiter = true;  // if the last line ends with delimiter
+  while (line_ends.size() < batch_size) {
+    scan_pos += FindChar(block_buf_.data() + scan_pos,
+                         block_buf_.size() - scan_pos, line_delimiter_,
+                         batch_size - line_ends.size(), scan_pos, &line_ends);
+    if (line_ends.size() == batch_size || ReadBlock()) {
+      continue;
+    }
+    // no more data, same as std::getline: last line without delimiter is a
+    // line if not empty, and EOF is reached anyway.
+    size_t tail = line_ends.empty() ? 0 : line_ends.back() + 1;
+    if (tail < block_buf_.size()) {
+      line_ends.push_back(block_buf_.size());
+      has_delimiter = false;
+    }
+    block_eof_ = true;
+    break;
+  }
+
+  const size_t count = line_ends.size();
+  if (count == 0) {
+    return 0;
+  }
+
+  // fill cols in parallel, each row is written to its own slot.
+  std::vector<void*> col_ptrs(selected_features_.size());
+  for (size_t i = 0; i < selected_features_.size(); i++) {
+    std::visit(
+        [&](auto& col) {
+          col.resize(count);
+          col_ptrs[i] = col.data();
+        },
+        cols->at(i));
+  }
+
+  // first error of each task, by row.
+  std::mutex error_mutex;
+  size_t error_row = count;
+  size_t error_index = 0;
+  std::exception_ptr error;
+
+  const size_t base_index = current_index_;
+  parallel_for(0, count, kParseGrainSize, [&](int64_t begin, int64_t end) {
+    std::vector<size_t> field_ends;
+    for (int64_t row = begin; row < end; row++) {
+      // current_index_ when the error happened in serial mode.
+      size_t index = base_index + row;
+      try {
+        const size_t line_begin = row == 0 ? 0 : line_ends[row - 1] + 1;
+        const size_t line_end = line_ends[row];
+        const char* line = block_buf_.data() + line_begin;
+        const size_t line_size = line_end - line_begin;
+
+        field_ends.clear();
+        FindChar(line, line_size, field_delimiter_,
+                 std::numeric_limits<size_t>::max(), 0, &field_ends);
+        field_ends.push_back(line_size);
+        if (field_ends.size() != headers_.size()) {
+          YACL_THROW_INVALID_FORMAT(
+              "Input CSV file format error: "
+              "Line#{} fields size '{}' != header's size '{}'",
+              index, field_ends.size(), headers_.size());
+        }
+        index++;
+
+        for (size_t i = 0; i < selected_features_.size(); i++) {
+          auto f_index = selected_features_[i].first;
+          auto type = selected_features_[i].second;
+          const size_t f_begin = f_index == 0 ? 0 : field_ends[f_index - 1] + 1;
+          absl::string_view field(line + f_begin,
+                                  field_ends[f_index] - f_begin);
+          switch (type) {
+            case Schema::STRING: {
+              static_cast<std::string*>(col_ptrs[i])[row].assign(
+                  field.data(), field.size());
+              break;
+            }
+            case Schema::FLOAT: {
+              float value = 0;
+              if (!FastFloatFromString(field, &value)) {
+                YACL_THROW_INVALID_FORMAT(
+                    "Input CSV file format error: Cannot convert '{}' to "
+                    "float, column '{}', {}, file '{}'",
+                    std::string(field), headers_[f_index], index,
+                    in_->GetName());
+              }
+              static_cast<float*>(col_ptrs[i])[row] = value;
+              break;
+            }
+            case Schema::DOUBLE: {
+              double value = 0;
+              if (!FastFloatFromString(field, &value)) {
+                YACL_THROW_INVALID_FORMAT(
+                    "Input CSV file format error: Cannot convert '{}' to "
+                    "double, column '{}', {}, file '{}'",
+                    std::string(field), headers_[f_index], index,
+                    in_->GetName());
+              }
+              static_cast<double*>(col_ptrs[i])[row] = value;
+              break;
+            }
+            default:
+              YACL_THROW("unknow Schema::type {}", static_cast<int>(type));
+          }
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (static_cast<size_t>(row) < error_row) {
+          error_row = row;
+          error_index = index;
+          error = std::current_exception();
+        }
+        return;
+      }
+    }
+  });
+
+  if (error) {
+    // report the first bad row, as serial mode does.
+    current_index_ = error_index;
+    std::rethrow_exception(error);
+  }
+
+  current_index_ += count;
+  block_pos_ = has_delimiter ? line_ends.back() + 1 : line_ends.back();
+  return count;
+}
+
+bool CsvReader::NextRow(ColumnVectorBatch* data, size_t batch_size) {
+  if (StreamEof()) {
+    // EOF
+    return false;
+  }
+
+  std::vector<ColumnType> cols;
+  InitBatchCols(&cols, batch_size);
+
+  size_t count = options_.parallel_parse ? ParseRowsParallel(&cols, batch_size)
+                                         : ParseRows(&cols, batch_size);
 
   if (count == batch_size) {
     // for fast seek
     UpdateRowMap();
   }
-  if (in_->Eof()) {
+  if (StreamEof()) {
     // scan over, save rows.
     total_rows_ = current_index_;
   }
@@ -483,6 +907,7 @@ void CsvReader::Seek(size_t index) {
     auto it = rows_map_.upper_bound(index);
     YACL_ENFORCE(it != rows_map_.begin());
     std::advance(it, -1);
+    ResetBlock();
     in_->Seekg(it->second);
     current_index_ = it->first;
     while (current_index_ < index && NextLine(nullptr)) {
@@ -498,6 +923,10 @@ std::unique_ptr<Reader> CsvReader::Spawn() {
   YACL_ENFORCE(inited_, "CAN NOT Spawn before init");
   auto in = in_->Spawn();
   YACL_ENFORCE(in_->Tellg() == in->Tellg());
+  if (block_pos_ < block_buf_.size()) {
+    // the new reader starts from the logical position, without any buffer.
+    in->Seekg(StreamTellg());
+  }
   std::unique_ptr<CsvReader> ret(new CsvReader(
       options_, std::move(in), field_delimiter_, line_delimiter_));
   ret->inited_ = true;
@@ -506,10 +935,55 @@ std::unique_ptr<Reader> CsvReader::Spawn() {
   ret->current_index_ = current_index_;
   ret->total_rows_ = total_rows_;
   ret->rows_map_ = rows_map_;
+  ret->end_pos_ = end_pos_;
   ret->cols_mmap_file_ = cols_mmap_file_;
   // use shared_ptr as dir ref counter.
   ret->mmap_dir_ = mmap_dir_;
   return ret;
 }
 
+std::vector<std::unique_ptr<Reader>> CsvReader::Split(size_t num) {
+  YACL_ENFORCE(inited_, "CAN NOT Split before init");
+  YACL_ENFORCE(!options_.column_reader, "Not callable if read by column");
+  YACL_ENFORCE(num > 0, "split to zero shard");
+
+  // [row 0, end) of this reader, may be a shard itself.
+  const size_t begin = rows_map_.at(0);
+  const size_t end = std::min(in_->GetLength(), end_pos_);
+  std::vector<size_t> bounds = {begin};
+  auto in = in_->Spawn();
+  std::string line;
+  for (size_t i = 1; i < num; i++) {
+    size_t pos = std::max(begin + (end - begin) / num * i, bounds.back());
+    if (pos > begin && pos < end) {
+      // move to the beginning of the next line, pos itself if pos - 1 is a
+      // line delimiter.
+      in->Seekg(pos - 1);
+      in->GetLine(&line, line_delimiter_);
+      pos = in->Eof() ? end : std::min(in->Tellg(), end);
+    }
+    bounds.push_back(pos);
+  }
+  bounds.push_back(end);
+
+  std::vector<std::unique_ptr<Reader>> ret;
+  ret.reserve(num);
+  for (size_t i = 0; i < num; i++) {
+    auto shard_in = in_->Spawn();
+    shard_in->Seekg(bounds[i]);
+    std::unique_ptr<CsvReader> shard(new CsvReader(
+        options_, std::move(shard_in), field_delimiter_, line_delimiter_));
+    shard->inited_ = true;
+    shard->headers_ = headers_;
+    shard->selected_features_ = selected_features_;
+    shard->rows_map_.insert({0, bounds[i]});
+    shard->end_pos_ = bounds[i + 1];
+    if (bounds[i] == bounds[i + 1]) {
+      shard->total_rows_ = 0;
+    }
+    ret.push_back(std::move(shard));
+  }
+  return ret;
+}
+
 }  // namespace yacl::io
@@ -91,6 +91,13 @@ class CsvReader : public Reader {
 
   std::unique_ptr<Reader> Spawn() override;
 
+  /**
+   * ROW reader only.
+   * Split [row 0, end of input) into num byte ranges, each aligned to the
+   * next line beginning. Each shard reads its own spawned InputStream.
+   */
+  std::vector<std::unique_ptr<Reader>> Split(size_t num) override;
+
   size_t GetLength() const override {
     YACL_ENFORCE(inited_, "Please Call Init before use reader");
     return in_->GetLength();
@@ -99,15 +106,31 @@ class CsvReader : public Reader {
   size_t Tellg() override {
     YACL_ENFORCE(inited_, "Please Call Init before use reader");
     YACL_ENFORCE(!options_.column_reader, "Not callable if read by column");
-    return in_->Tellg();
+    return StreamTellg();
   }
 
  private:
   void CountLines();
+  // row index sidecar, see ReaderOptions::row_index_file.
+  bool LoadRowIndex();
+  void SaveRowIndex();
   void ParseHeader();
   void UpdateRowMap();
+  void UpdateRowMap(size_t pos);
   bool NextLine(std::vector<absl::string_view>*);
 
+  // for parallel_parse ROW reader.
+  // position of the next unread row, excluding bytes in block_buf_.
+  size_t StreamTellg();
+  bool StreamEof();
+  // append next block from in_ to block_buf_, return false if no more data.
+  bool ReadBlock();
+  // drop block_buf_, in_ is at StreamTellg() after this.
+  void ResetBlock();
+  void CountLinesParallel();
+  size_t ParseRows(std::vector<ColumnType>*, size_t);
+  size_t ParseRowsParallel(std::vector<ColumnType>*, size_t);
+
   void BuildMmapFiles();
 
   bool NextCol(ColumnVectorBatch*);
@@ -117,6 +140,8 @@ class CsvReader : public Reader {
   const ReaderOptions options_;
   const char field_delimiter_;
   const char line_delimiter_;
+  // see ReaderOptions::row_index_interval.
+  const size_t row_index_interval_;
   bool inited_;
   std::unique_ptr<InputStream> in_;
   std::vector<std::string> headers_;
@@ -130,10 +155,18 @@ class CsvReader : public Reader {
   // for ROW reader
   // rows -> file position.
   std::map<size_t, size_t> rows_map_;
+  // input position where rows end, for shards of Split().
+  size_t end_pos_;
   // for COL reader
   // index -> file name
   std::vector<std::string> cols_mmap_file_;
   std::shared_ptr<MmapDirGuard> mmap_dir_;
+  // for parallel_parse ROW reader
+  // bytes read from in_ but not parsed: block_buf_[block_pos_, end)
+  std::string block_buf_;
+  size_t block_pos_ = 0;
+  // same as in_->Eof() in serial mode.
+  bool block_eof_ = false;
 };
 
 }  // namespace yacl::io
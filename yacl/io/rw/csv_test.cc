@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cmath>
 #include <cstdint>
 #include <ctime>
 #include <filesystem>
+#include <numeric>
+#include <random>
 
 #include "fmt/format.h"
 #include "gtest/gtest.h"
@@ -22,9 +25,11 @@
 #include "yacl/base/exception.h"
 #include "yacl/io/rw/csv_reader.h"
 #include "yacl/io/rw/csv_writer.h"
+#include "yacl/io/rw/float.h"
 #include "yacl/io/rw/schema.h"
 #include "yacl/io/stream/file_io.h"
 #include "yacl/io/stream/mem_io.h"
+#include "yacl/utils/parallel.h"
 
 namespace yacl::io {
 
@@ -443,6 +448,366 @@ u2, 22 , 23 , 24 , 25 , 0
   }
 }
 
+TEST(CSV, parallel_parse) {
+  std::string body;
+  for (size_t i = 0; i < 2000; i++) {
+    body += fmt::format("u{}, {} , {}e-3 , {}\n", i, i % 97, i, -1.5 * i);
+  }
+  const std::string header = "id , f1 , f2 , f3\n";
+
+  Schema s;
+  s.feature_types = {Schema::STRING, Schema::FLOAT, Schema::DOUBLE,
+                     Schema::DOUBLE};
+  s.feature_names = {"id", "f1", "f2", "f3"};
+
+  auto read_all = [&](const std::string& input, size_t batch_size,
+                      bool parallel) {
+    ReaderOptions r_ops;
+    r_ops.file_schema = s;
+    r_ops.batch_size = batch_size;
+    r_ops.use_header_order = true;
+    r_ops.parallel_parse = parallel;
+    std::unique_ptr<InputStream> in(new MemInputStream(input));
+    CsvReader reader(r_ops, std::move(in));
+    reader.Init();
+    std::vector<ColumnVectorBatch> batches;
+    ColumnVectorBatch batch;
+    while (reader.Next(&batch)) {
+      batches.push_back(std::move(batch));
+    }
+    EXPECT_EQ(reader.Rows(), reader.Tell());
+    return batches;
+  };
+
+  // with & without the trailing line delimiter
+  const std::string inputs[] = {header + body,
+                                header + body.substr(0, body.size() - 1)};
+  for (const auto& input : inputs) {
+    for (size_t batch_size : {1, 7, 1000, 5000}) {
+      auto expect = read_all(input, batch_size, false);
+      auto got = read_all(input, batch_size, true);
+      ASSERT_EQ(expect.size(), got.size());
+      for (size_t b = 0; b < expect.size(); b++) {
+        ASSERT_EQ(expect[b].Shape(), got[b].Shape());
+        for (size_t r = 0; r < expect[b].Shape().rows; r++) {
+          EXPECT_EQ(expect[b].At<std::string>(r, 0),
+                    got[b].At<std::string>(r, 0));
+          EXPECT_EQ(expect[b].At<float>(r, 1), got[b].At<float>(r, 1));
+          EXPECT_EQ(expect[b].At<double>(r, 2), got[b].At<double>(r, 2));
+          EXPECT_EQ(expect[b].At<double>(r, 3), got[b].At<double>(r, 3));
+        }
+      }
+    }
+  }
+
+  {  // seek & count lines
+    ReaderOptions r_ops;
+    r_ops.file_schema = s;
+    r_ops.batch_size = 100;
+    r_ops.use_header_order = true;
+    r_ops.parallel_parse = true;
+    r_ops.row_reader_count_lines = true;
+    std::unique_ptr<InputStream> in(new MemInputStream(header + body));
+    CsvReader reader(r_ops, std::move(in));
+    reader.Init();
+    EXPECT_EQ(reader.Rows(), 2000);
+
+    ColumnVectorBatch batch;
+    reader.Seek(1234);
+    EXPECT_TRUE(reader.Next(&batch));
+    EXPECT_EQ(batch.At<std::string>(0, 0), "u1234");
+    EXPECT_EQ(reader.Tell(), 1334);
+    auto spawned = reader.Spawn();
+    EXPECT_TRUE(spawned->Next(&batch));
+    EXPECT_EQ(batch.At<std::string>(0, 0), "u1334");
+    EXPECT_TRUE(reader.Next(&batch));
+    EXPECT_EQ(batch.At<std::string>(0, 0), "u1334");
+  }
+
+  {  // format errors
+    for (const auto& bad : {std::string("u1, 1 , 2 , 3 , 4\n"),
+                            std::string("u1, x , 2 , 3\n")}) {
+      ReaderOptions r_ops;
+      r_ops.file_schema = s;
+      r_ops.batch_size = 5000;
+      r_ops.use_header_order = true;
+      r_ops.parallel_parse = true;
+      std::unique_ptr<InputStream> in(new MemInputStream(header + body + bad));
+      CsvReader reader(r_ops, std::move(in));
+      reader.Init();
+      ColumnVectorBatch batch;
+      EXPECT_THROW(reader.Next(&batch), yacl::InvalidFormat);
+    }
+  }
+}
+
+TEST(CSV, split) {
+  std::string body;
+  for (size_t i = 0; i < 1000; i++) {
+    body += fmt::format("u{}, {}\n", i, i);
+  }
+  const std::string header = "id , f1\n";
+
+  Schema s;
+  s.feature_types = {Schema::STRING, Schema::DOUBLE};
+  s.feature_names = {"id", "f1"};
+
+  const std::string inputs[] = {header + body,
+                                header + body.substr(0, body.size() - 1),
+                                header};
+  for (const auto& input : inputs) {
+    for (bool parallel : {false, true}) {
+      for (size_t num : {1, 3, 8, 2000}) {
+        ReaderOptions r_ops;
+        r_ops.file_schema = s;
+        r_ops.batch_size = 7;
+        r_ops.use_header_order = true;
+        r_ops.parallel_parse = parallel;
+        std::unique_ptr<InputStream> in(new MemInputStream(input));
+        CsvReader reader(r_ops, std::move(in));
+        reader.Init();
+        auto shards = reader.Split(num);
+        ASSERT_EQ(shards.size(), num);
+
+        // shards cover all rows in order, without overlap.
+        size_t next = 0;
+        for (auto& shard : shards) {
+          ColumnVectorBatch batch;
+          size_t rows = 0;
+          while (shard->Next(&batch)) {
+            for (size_t r = 0; r < batch.Shape().rows; r++) {
+              EXPECT_EQ(batch.At<std::string>(r, 0), fmt::format("u{}", next));
+              EXPECT_EQ(batch.At<double>(r, 1), next);
+              next++;
+              rows++;
+            }
+          }
+          EXPECT_EQ(shard->Rows(), rows);
+          EXPECT_EQ(shard->Tell(), rows);
+          if (rows > 1) {
+            // seek inside the shard.
+            shard->Seek(1);
+            EXPECT_TRUE(shard->Next(&batch));
+            EXPECT_EQ(batch.At<std::string>(0, 0),
+                      fmt::format("u{}", next - rows + 1));
+          }
+        }
+        EXPECT_EQ(next, input == header ? 0 : 1000);
+      }
+    }
+  }
+
+  {  // shards are read in parallel.
+    ReaderOptions r_ops;
+    r_ops.file_schema = s;
+    r_ops.batch_size = 10;
+    r_ops.use_header_order = true;
+    std::unique_ptr<InputStream> in(new MemInputStream(header + body));
+    CsvReader reader(r_ops, std::move(in));
+    reader.Init();
+    auto shards = reader.Split(4);
+    std::vector<double> sums(shards.size());
+    parallel_for(0, shards.size(), 1, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        ColumnVectorBatch batch;
+        while (shards[i]->Next(&batch)) {
+          for (size_t r = 0; r < batch.Shape().rows; r++) {
+            sums[i] += batch.At<double>(r, 1);
+          }
+        }
+      }
+    });
+    EXPECT_EQ(std::accumulate(sums.begin(), sums.end(), 0.0), 999 * 1000 / 2);
+  }
+}
+
+TEST(CSV, row_index) {
+  std::string input = "id , f1\n";
+  for (size_t i = 0; i < 1000; i++) {
+    input += fmt::format("u{}, {}\n", i, i);
+  }
+  Schema s;
+  s.feature_types = {Schema::STRING, Schema::DOUBLE};
+  s.feature_names = {"id", "f1"};
+
+  const std::string index_file = fmt::format(
+      "{}/csv_row_index_{}", std::filesystem::temp_directory_path().string(),
+      std::time(nullptr));
+  std::filesystem::remove(index_file);
+
+  auto make_reader = [&](const std::string& in_buf, bool parallel) {
+    ReaderOptions r_ops;
+    r_ops.file_schema = s;
+    r_ops.batch_size = 100;
+    r_ops.use_header_order = true;
+    r_ops.parallel_parse = parallel;
+    r_ops.row_reader_count_lines = true;
+    r_ops.row_index_interval = 16;
+    r_ops.row_index_file = index_file;
+    std::unique_ptr<InputStream> in(new MemInputStream(in_buf));
+    auto reader = std::make_unique<CsvReader>(r_ops, std::move(in));
+    reader->Init();
+    return reader;
+  };
+  auto check_seek = [](CsvReader* reader, size_t row) {
+    ColumnVectorBatch batch;
+    reader->Seek(row);
+    EXPECT_TRUE(reader->Next(&batch));
+    EXPECT_EQ(batch.At<std::string>(0, 0), fmt::format("u{}", row));
+  };
+
+  for (bool parallel : {false, true}) {
+    std::filesystem::remove(index_file);
+    // builds & saves the sidecar.
+    auto reader = make_reader(input, parallel);
+    EXPECT_EQ(reader->Rows(), 1000);
+    EXPECT_TRUE(std::filesystem::exists(index_file));
+    check_seek(reader.get(), 999);
+    check_seek(reader.get(), 17);
+
+    // loads the sidecar.
+    auto loaded = make_reader(input, !parallel);
+    EXPECT_EQ(loaded->Rows(), 1000);
+    check_seek(loaded.get(), 500);
+    check_seek(loaded.get(), 0);
+
+    // input changed, sidecar is rebuilt.
+    auto changed = make_reader(input + "u1000, 1000\n", parallel);
+    EXPECT_EQ(changed->Rows(), 1001);
+    check_seek(changed.get(), 1000);
+  }
+
+  {  // same length, content changed.
+    std::filesystem::remove(index_file);
+    make_reader(input, false);
+    std::string edited = input;
+    edited.replace(edited.size() - 10, 10, "u99\n99, 9\n");
+    ASSERT_EQ(edited.size(), input.size());
+    auto changed = make_reader(edited, false);
+    EXPECT_EQ(changed->Rows(), 1001);
+  }
+  {  // truncated sidecar (header or entries), rebuilt instead of throwing.
+    for (size_t size : {size_t(10), size_t(100)}) {
+      std::filesystem::remove(index_file);
+      make_reader(input, false);
+      std::filesystem::resize_file(index_file, size);
+      std::unique_ptr<CsvReader> rebuilt;
+      EXPECT_NO_THROW(rebuilt = make_reader(input, false));
+      EXPECT_EQ(rebuilt->Rows(), 1000);
+      check_seek(rebuilt.get(), 999);
+      EXPECT_GT(std::filesystem::file_size(index_file), size);
+    }
+  }
+  {  // sidecar can not be saved, reader still works.
+    const auto bad_file = index_file + "/sub/index";
+    ReaderOptions r_ops;
+    r_ops.file_schema = s;
+    r_ops.row_reader_count_lines = true;
+    r_ops.row_index_file = bad_file;
+    CsvReader reader(r_ops, std::make_unique<MemInputStream>(input));
+    EXPECT_NO_THROW(reader.Init());
+    EXPECT_EQ(reader.Rows(), 1000);
+    EXPECT_FALSE(std::filesystem::exists(bad_file));
+  }
+  std::filesystem::remove(index_file);
+}
+
+TEST(CSV, writer_format) {
+  Schema s;
+  s.feature_types = {Schema::STRING, Schema::FLOAT, Schema::DOUBLE};
+  s.feature_names = {"id", "f1", "f2"};
+
+  const size_t rows = 10000;
+  ColumnVectorBatch batch;
+  {
+    StringColumnVector ids(rows);
+    FloatColumnVector f1(rows);
+    DoubleColumnVector f2(rows);
+    std::mt19937_64 rng(rows);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (size_t i = 0; i < rows; i++) {
+      ids[i] = fmt::format("u{}", i);
+      f1[i] = static_cast<float>(dist(rng)) / (i + 1);
+      f2[i] = dist(rng) * std::pow(10.0, static_cast<int>(i % 40) - 20);
+    }
+    f1[0] = std::numeric_limits<float>::infinity();
+    f2[0] = -std::numeric_limits<double>::infinity();
+    f1[1] = 0;
+    f2[1] = 1e-300;
+    batch.AppendCol(std::move(ids));
+    batch.AppendCol(std::move(f1));
+    batch.AppendCol(std::move(f2));
+  }
+
+  // expected output by FloatToString.
+  std::string expect = "id,f1,f2\n";
+  for (size_t i = 0; i < rows; i++) {
+    expect += fmt::format(
+        "{},{},{}\n", batch.At<std::string>(i, 0),
+        FloatToString(batch.At<float>(i, 1), 7),
+        FloatToString(batch.At<double>(i, 2), 7));
+  }
+
+  auto write_all = [&](bool parallel, bool shortest) {
+    std::string out_buf;
+    std::unique_ptr<OutputStream> out(new MemOutputStream(&out_buf));
+    WriterOptions w_op;
+    w_op.file_schema = s;
+    w_op.float_precision = 7;
+    w_op.float_shortest = shortest;
+    w_op.parallel_format = parallel;
+    CsvWriter writer(w_op, std::move(out));
+    writer.Init();
+    writer.Add(batch);
+    writer.Add(batch);
+    writer.Close();
+    return out_buf;
+  };
+
+  const auto body = expect.substr(expect.find('\n') + 1);
+  EXPECT_EQ(write_all(false, false), expect + body);
+  EXPECT_EQ(write_all(true, false), expect + body);
+
+  // shortest repr round-trips.
+  const auto shortest = write_all(true, true);
+  EXPECT_EQ(shortest, write_all(false, true));
+  {
+    ReaderOptions r_ops;
+    r_ops.file_schema = s;
+    r_ops.batch_size = rows * 2;
+    r_ops.use_header_order = true;
+    std::unique_ptr<InputStream> in(new MemInputStream(shortest));
+    CsvReader reader(r_ops, std::move(in));
+    reader.Init();
+    ColumnVectorBatch got;
+    EXPECT_TRUE(reader.Next(&got));
+    ASSERT_EQ(got.Shape().rows, rows * 2);
+    for (size_t i = 0; i < rows * 2; i++) {
+      EXPECT_EQ(got.At<std::string>(i, 0), batch.At<std::string>(i % rows, 0));
+      EXPECT_EQ(got.At<float>(i, 1),
+                FloatNormalization(batch.At<float>(i % rows, 1)));
+      EXPECT_EQ(got.At<double>(i, 2),
+                FloatNormalization(batch.At<double>(i % rows, 2)));
+    }
+  }
+}
+
+TEST(CSV, float_to_chars) {
+  char buf[kMaxFloatChars<double>];
+  for (double v : {0.0, 1.5, -2.75e-10, 123456.789, 1e300}) {
+    // precision 0 is printf's "%.0g", not the shortest repr.
+    for (int precision : {0, 1, 7, 17}) {
+      auto* end = FloatToChars(v, precision, buf);
+      EXPECT_EQ(std::string(buf, end), FloatToString(v, precision));
+    }
+    auto* end = FloatToChars(v, kFloatShortest, buf);
+    double back = 0;
+    EXPECT_TRUE(FloatFromString(absl::string_view(buf, end - buf), &back));
+    EXPECT_EQ(back, v);
+  }
+  EXPECT_EQ(std::string(buf, FloatToChars(123456.789, 0, buf)), "1e+05");
+}
+
 TEST(BATCH, test) {
   {
     FloatColumnVector col;
@@ -26,9 +26,19 @@
 
 #include "yacl/base/exception.h"
 #include "yacl/io/rw/float.h"
+#include "yacl/utils/parallel.h"
 
 namespace yacl::io {
 
+namespace {
+
+// rows formatted into a buffer each time.
+constexpr size_t kFormatRows = 4096;
+// parallel_format: buffers formatted by each thread in a window.
+constexpr size_t kTasksPerThread = 4;
+
+}  // namespace
+
 CsvWriter::CsvWriter(WriterOptions op, std::unique_ptr<OutputStream> out,
                      char field_delimiter, char line_delimiter)
     : options_(std::move(op)),
@@ -60,41 +70,89 @@ void CsvWriter::Init() {
   inited_ = true;
 }
 
-bool CsvWriter::Add(const ColumnVectorBatch& data) {
-  YACL_ENFORCE(inited_, "Please Call Init before use writer");
-  const size_t rows = data.Shape().rows;
+void CsvWriter::FormatRows(const ColumnVectorBatch& data, size_t begin,
+                           size_t end, std::string* buf) const {
   const size_t cols = data.Shape().cols;
-  YACL_ENFORCE(cols == options_.file_schema.feature_names.size());
   const auto& types = options_.file_schema.feature_types;
+  const int precision =
+      options_.float_shortest ? kFloatShortest : options_.float_precision;
+  char float_buf[kMaxFloatChars<double>];
+
+  // check column types once, not for every value.
+  std::vector<const void*> col_ptrs(cols);
+  for (size_t c = 0; c < cols; c++) {
+    switch (types[c]) {
+      case Schema::FLOAT:
+        col_ptrs[c] = data.Col<float>(c).data();
+        break;
+      case Schema::DOUBLE:
+        col_ptrs[c] = data.Col<double>(c).data();
+        break;
+      case Schema::STRING:
+        col_ptrs[c] = data.Col<std::string>(c).data();
+        break;
+      default:
+        YACL_THROW("unknow Schema::type {}", static_cast<int>(types[c]));
+    }
+  }
 
-  for (size_t r = 0; r < rows; r++) {
+  for (size_t r = begin; r < end; r++) {
     for (size_t c = 0; c < cols; c++) {
       switch (types[c]) {
         case Schema::FLOAT: {
-          auto v =
-              FloatToString(data.At<float>(r, c), options_.float_precision);
-          out_->Write(v.c_str(), v.size());
+          auto v = static_cast<const float*>(col_ptrs[c])[r];
+          auto* v_end = FloatToChars(v, precision, float_buf);
+          buf->append(float_buf, v_end - float_buf);
           break;
         }
         case Schema::DOUBLE: {
-          auto v =
-              FloatToString(data.At<double>(r, c), options_.float_precision);
-          out_->Write(v.c_str(), v.size());
-          break;
-        }
-        case Schema::STRING: {
-          const auto& v = data.At<std::string>(r, c);
-          out_->Write(v.c_str(), v.size());
+          auto v = static_cast<const double*>(col_ptrs[c])[r];
+          auto* v_end = FloatToChars(v, precision, float_buf);
+          buf->append(float_buf, v_end - float_buf);
           break;
         }
         default:
-          YACL_THROW("unknow Schema::type {}", static_cast<int>(types[c]));
+          buf->append(static_cast<const std::string*>(col_ptrs[c])[r]);
       }
       if (c + 1 != cols) {
-        out_->Write(field_delimiter_.c_str(), field_delimiter_.size());
+        buf->append(field_delimiter_);
       }
     }
-    out_->Write(line_delimiter_.c_str(), line_delimiter_.size());
+    buf->append(line_delimiter_);
+  }
+}
+
+bool CsvWriter::Add(const ColumnVectorBatch& data) {
+  YACL_ENFORCE(inited_, "Please Call Init before use writer");
+  const size_t rows = data.Shape().rows;
+  const size_t cols = data.Shape().cols;
+  YACL_ENFORCE(cols == options_.file_schema.feature_names.size());
+
+  // format kFormatRows rows into each buffer, a window of buffers is
+  // formatted (in parallel) & then written in order, so memory is bounded
+  // by the window size rather than the batch size.
+  const size_t window =
+      options_.parallel_format ? kTasksPerThread * get_num_threads() : 1;
+  bufs_.resize(window);
+  for (size_t begin = 0; begin < rows; begin += window * kFormatRows) {
+    const size_t num_tasks =
+        std::min(window, (rows - begin + kFormatRows - 1) / kFormatRows);
+    auto format = [&](int64_t task_begin, int64_t task_end) {
+      for (int64_t t = task_begin; t < task_end; t++) {
+        const size_t row_begin = begin + t * kFormatRows;
+        bufs_[t].clear();
+        FormatRows(data, row_begin, std::min(rows, row_begin + kFormatRows),
+                   &bufs_[t]);
+      }
+    };
+    if (num_tasks > 1) {
+      parallel_for(0, num_tasks, 1, format);
+    } else {
+      format(0, num_tasks);
+    }
+    for (size_t t = 0; t < num_tasks; t++) {
+      out_->Write(bufs_[t].data(), bufs_[t].size());
+    }
   }
   return true;
 }
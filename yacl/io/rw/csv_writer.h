@@ -14,6 +14,8 @@
 
 #pragma once
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "yacl/io/rw/schema.h"
 #include "yacl/io/rw/writer.h"
@@ -41,11 +43,17 @@ class CsvWriter : public Writer {
   }
 
  private:
+  // append formatted rows [begin, end) of data to buf.
+  void FormatRows(const ColumnVectorBatch& data, size_t begin, size_t end,
+                  std::string* buf) const;
+
   const WriterOptions options_;
   const std::string field_delimiter_;
   const std::string line_delimiter_;
   bool inited_;
   std::unique_ptr<OutputStream> out_;
+  // format buffers, reused by Add.
+  std::vector<std::string> bufs_;
 };
 
 }  // namespace yacl::io
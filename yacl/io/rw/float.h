@@ -15,14 +15,18 @@
 #pragma once
 
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <cstdio>
 #include <limits>
 #include <string>
+#include <system_error>
 #include <type_traits>
 
 #include "absl/strings/numbers.h"
 
+#include "yacl/base/exception.h"
+
 namespace yacl::io {
 
 #define YACL_UNLIKELY(x) __builtin_expect((x), 0)
@@ -49,6 +53,36 @@ std::string FloatToString(S v, int precision) {
   return ret;
 }
 
+// max chars written by FloatToChars.
+template <class S>
+constexpr size_t kMaxFloatChars = std::numeric_limits<S>::max_digits10 + 10;
+
+// precision of FloatToChars: the shortest repr which round-trips to the same
+// S.
+inline constexpr int kFloatShortest = -1;
+
+// Same result as FloatToString, but write to [first, first + kMaxFloatChars)
+// by std::to_chars without locale & allocation, return the end of written
+// chars.
+template <class S>
+char* FloatToChars(S v, int precision, char* first) {
+  static_assert(std::is_floating_point_v<S>);
+  char* last = first + kMaxFloatChars<S>;
+  v = FloatNormalization(v);
+  std::to_chars_result ret;
+  if (precision == kFloatShortest) {
+    ret = std::to_chars(first, last, v);
+  } else {
+    ret = std::to_chars(
+        first, last, v, std::chars_format::general,
+        std::min(std::numeric_limits<S>::max_digits10, precision));
+  }
+  YACL_ENFORCE(ret.ec == std::errc(),
+               "format float {} with precision {} overflows {} chars", v,
+               precision, kMaxFloatChars<S>);
+  return ret.ptr;
+}
+
 template <class S>
 [[nodiscard]] bool FloatFromString(absl::string_view str, S* ret) {
   static_assert(std::is_floating_point_v<S>);
@@ -63,6 +97,25 @@ template <class S>
   return true;
 }
 
+// Same result as FloatFromString, but try std::from_chars first.
+// from_chars do not skip whitespaces or '+', and do not handle out of range
+// like absl::SimpleAtod, such inputs fall back to FloatFromString.
+template <class S>
+[[nodiscard]] bool FastFloatFromString(absl::string_view str, S* ret) {
+  static_assert(std::is_floating_point_v<S>);
+  double double_value = 0;
+  const char* end = str.data() + str.size();
+  auto [ptr, ec] = std::from_chars(str.data(), end, double_value);
+  if (ec == std::errc() && ptr == end) {
+    if (YACL_UNLIKELY(std::isnan(double_value))) {
+      return false;
+    }
+    *ret = FloatNormalization(static_cast<S>(double_value));
+    return true;
+  }
+  return FloatFromString(str, ret);
+}
+
 #undef YACL_UNLIKELY
 
 }  // namespace yacl::io
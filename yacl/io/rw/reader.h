@@ -15,7 +15,10 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "yacl/base/exception.h"
 #include "yacl/io/rw/schema.h"
 #include "yacl/io/stream/interface.h"
 
@@ -36,6 +39,22 @@ struct ReaderOptions {
   // keep this false if you do not need to get file lines before first full
   // scan.
   bool row_reader_count_lines = false;
+  // row reader (and count lines) parse input in parallel.
+  // input is read by large blocks, line & field boundaries are located by
+  // SIMD scanning, rows of one batch are split across threads.
+  // output & errors are the same as the default (serial) mode.
+  // only worth it if batch_size is large.
+  bool parallel_parse = false;
+  // row reader keeps the input position of every row_index_interval-th row
+  // (found by line counting or full scan), Seek skips at most
+  // row_index_interval - 1 lines. 0 means batch_size.
+  size_t row_index_interval = 0;
+  // row reader with row_reader_count_lines only.
+  // if not empty, the row index built by line counting is saved to this
+  // sidecar file, and later readers of the same input (checked by length,
+  // mtime and a fingerprint of its first & last blocks) load it in Init()
+  // instead of counting lines again. failing to save it only logs a warning.
+  std::string row_index_file;
 };
 
 // NOT thread safe. see Spawn().
@@ -122,6 +141,18 @@ class Reader {
    * Spawn() is not thread safe too. DO NOT call Spawn() parallel.
    */
   virtual std::unique_ptr<Reader> Spawn() = 0;
+
+  /**
+   * Split all rows into num shards by input byte range, each range starts
+   * at a line beginning. Shards are independent readers (inited), and can
+   * be read in parallel, one thread per shard.
+   * Tell()/Seek()/Rows() of shard count rows from the shard's first row.
+   * Split() is not thread safe, same as Spawn().
+   * throw if the reader does not support it.
+   */
+  virtual std::vector<std::unique_ptr<Reader>> Split(size_t /*num*/) {
+    YACL_THROW("Split not supported");
+  }
 };
 
 }  // namespace yacl::io
\ No newline at end of file
@@ -26,6 +26,13 @@ struct WriterOptions {
   // precision for format float.
   // assert( float_precision <= max_digits10 )
   int float_precision = std::numeric_limits<float>::max_digits10;
+  // format float by the shortest repr which round-trips to the same value,
+  // float_precision is ignored.
+  bool float_shortest = false;
+  // format rows of a batch by multi threads into per-task buffers, then
+  // write them in row order. output is the same as the default mode.
+  // only worth it if batches are large.
+  bool parallel_format = false;
 };
 
 // NOT thread safe and append only.
@@ -0,0 +1,307 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/io/stream/prefetch_file_io.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include "yacl/base/exception.h"
+
+namespace yacl::io {
+
+namespace {
+
+// buffer alignment, fits O_DIRECT & avx loads.
+constexpr size_t kBufferAlign = 4096;
+
+}  // namespace
+
+#define PREFETCH_IO_THROW(msg_prefix, err)                                \
+  YACL_THROW_IO_ERROR(                                                    \
+      msg_prefix " error on file '{}', error msg '{}', error code {}",    \
+      file_name_, std::strerror(err), err);
+
+PrefetchFileInputStream::PrefetchFileInputStream(std::string file_name,
+                                                 PrefetchOptions options)
+    : file_name_(std::move(file_name)), options_(options) {
+  YACL_ENFORCE(options_.block_size > 0 && options_.depth > 0,
+               "invalid prefetch options, block_size {} depth {}",
+               options_.block_size, options_.depth);
+
+  fd_ = open(file_name_.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0) {
+    PREFETCH_IO_THROW("Open for read", errno);
+  }
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    int err = errno;
+    close(fd_);
+    PREFETCH_IO_THROW("Stat", err);
+  }
+  file_len_ = st.st_size;
+#ifdef POSIX_FADV_SEQUENTIAL
+  // hint only, ignore error.
+  posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+  const size_t buf_size =
+      (options_.block_size + kBufferAlign - 1) / kBufferAlign * kBufferAlign;
+  blocks_.resize(options_.depth);
+  for (size_t i = 0; i < blocks_.size(); i++) {
+    blocks_[i].buf = {static_cast<char*>(std::aligned_alloc(kBufferAlign,
+                                                            buf_size)),
+                      std::free};
+    YACL_ENFORCE(blocks_[i].buf != nullptr, "alloc {} bytes failed",
+                 buf_size);
+    free_.push_back(i);
+  }
+}
+
+PrefetchFileInputStream::~PrefetchFileInputStream() { Close(); }
+
+void PrefetchFileInputStream::Stop() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void PrefetchFileInputStream::Close() {
+  Stop();
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  current_ = -1;
+  ready_.clear();
+  free_.clear();
+  blocks_.clear();
+  file_len_ = 0;
+}
+
+void PrefetchFileInputStream::Prefetch() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cond_.wait(lock, [&] {
+      return stop_ || (fetch_offset_ < file_len_ && !free_.empty());
+    });
+    if (stop_) {
+      return;
+    }
+    const size_t idx = free_.front();
+    free_.pop_front();
+    auto& block = blocks_[idx];
+    block.offset = fetch_offset_;
+    block.size = std::min(options_.block_size, file_len_ - fetch_offset_);
+    block.error = 0;
+    fetch_offset_ += block.size;
+    const uint64_t generation = generation_;
+    lock.unlock();
+
+    // block is owned by this thread until it is put back.
+    size_t done = 0;
+    while (done < block.size) {
+      auto ret = pread(fd_, block.buf.get() + done, block.size - done,
+                       block.offset + done);
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ret <= 0) {
+        // file is truncated if ret == 0.
+        block.error = ret < 0 ? errno : EIO;
+        break;
+      }
+      done += ret;
+    }
+    bytes_read_ += done;
+
+    lock.lock();
+    if (generation == generation_) {
+      ready_.push_back(idx);
+    } else {
+      // dropped by Seekg.
+      free_.push_back(idx);
+    }
+    cond_.notify_all();
+  }
+}
+
+void PrefetchFileInputStream::ReleaseBlock() {
+  if (current_ >= 0) {
+    free_.push_back(current_);
+    current_ = -1;
+    cond_.notify_all();
+  }
+}
+
+bool PrefetchFileInputStream::LoadBlock() {
+  if (current_ >= 0) {
+    const auto& block = blocks_[current_];
+    if (pos_ >= block.offset && pos_ < block.offset + block.size) {
+      return true;
+    }
+  }
+  if (pos_ >= file_len_) {
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  ReleaseBlock();
+  if (!worker_.joinable()) {
+    // start lazily, so Seekg right after open (e.g. Spawn) costs nothing.
+    worker_ = std::thread([this] { Prefetch(); });
+  }
+  while (true) {
+    if (ready_.empty()) {
+      auto start = std::chrono::steady_clock::now();
+      cond_.wait(lock, [&] { return !ready_.empty(); });
+      stall_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    }
+    const size_t idx = ready_.front();
+    ready_.pop_front();
+    const auto& block = blocks_[idx];
+    if (block.error != 0) {
+      const int err = block.error;
+      free_.push_back(idx);
+      cond_.notify_all();
+      PREFETCH_IO_THROW("Read", err);
+    }
+    YACL_ENFORCE(pos_ >= block.offset, "prefetch block out of order");
+    next_offset_ = block.offset + block.size;
+    if (pos_ < next_offset_) {
+      current_ = idx;
+      cond_.notify_all();
+      return true;
+    }
+    // skipped by Seekg.
+    free_.push_back(idx);
+    cond_.notify_all();
+  }
+}
+
+InputStream& PrefetchFileInputStream::GetLine(std::string* ret, char delim) {
+  if (fail_ || eof_) {
+    // same as std::istream, do nothing if not good.
+    fail_ = true;
+    return *this;
+  }
+  ret->clear();
+  bool extracted = false;
+  while (true) {
+    if (!LoadBlock()) {
+      eof_ = true;
+      fail_ = !extracted;
+      break;
+    }
+    const auto& block = blocks_[current_];
+    const char* begin = block.buf.get() + (pos_ - block.offset);
+    const size_t size = block.offset + block.size - pos_;
+    const auto* found =
+        static_cast<const char*>(std::memchr(begin, delim, size));
+    if (found != nullptr) {
+      ret->append(begin, found - begin);
+      pos_ += found - begin + 1;
+      break;
+    }
+    ret->append(begin, size);
+    pos_ += size;
+    extracted = true;
+  }
+  return *this;
+}
+
+InputStream& PrefetchFileInputStream::Read(void* buf, size_t length) {
+  if (fail_ || eof_) {
+    // same as std::istream, do nothing if not good.
+    fail_ = true;
+    return *this;
+  }
+  auto* out = static_cast<char*>(buf);
+  while (length > 0) {
+    if (!LoadBlock()) {
+      eof_ = true;
+      fail_ = true;
+      break;
+    }
+    const auto& block = blocks_[current_];
+    const size_t size = std::min(length, block.offset + block.size - pos_);
+    std::memcpy(out, block.buf.get() + (pos_ - block.offset), size);
+    out += size;
+    pos_ += size;
+    length -= size;
+  }
+  return *this;
+}
+
+InputStream& PrefetchFileInputStream::Seekg(size_t pos) {
+  // clear EOF/FAIL bit
+  eof_ = false;
+  fail_ = false;
+  pos_ = pos;
+  if (current_ >= 0) {
+    const auto& block = blocks_[current_];
+    if (pos >= block.offset && pos < block.offset + block.size) {
+      return *this;
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (pos >= next_offset_ && pos < fetch_offset_) {
+    // short jump ahead, blocks before pos are skipped in LoadBlock.
+    ReleaseBlock();
+    return *this;
+  }
+  // drop the ring & restart from block containing pos.
+  ReleaseBlock();
+  while (!ready_.empty()) {
+    free_.push_back(ready_.front());
+    ready_.pop_front();
+  }
+  generation_++;
+  fetch_offset_ = pos / options_.block_size * options_.block_size;
+  next_offset_ = fetch_offset_;
+  cond_.notify_all();
+  return *this;
+}
+
+std::unique_ptr<InputStream> PrefetchFileInputStream::Spawn() {
+  std::unique_ptr<InputStream> ret(
+      new PrefetchFileInputStream(file_name_, options_));
+  ret->Seekg(Tellg());
+  return ret;
+}
+
+PrefetchStats PrefetchFileInputStream::GetStats() const {
+  PrefetchStats stats;
+  stats.bytes_read = bytes_read_;
+  stats.stall_ns = stall_ns_;
+  return stats;
+}
+
+}  // namespace yacl::io
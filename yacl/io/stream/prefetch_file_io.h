@@ -0,0 +1,142 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "yacl/io/stream/interface.h"
+
+namespace yacl::io {
+
+struct PrefetchOptions {
+  // bytes of each disk read, blocks start at multiples of block_size.
+  size_t block_size = 4 * 1024 * 1024;
+  // max blocks read ahead of the reader (ring size).
+  size_t depth = 4;
+};
+
+struct PrefetchStats {
+  // bytes read from disk, including blocks dropped by Seekg.
+  uint64_t bytes_read = 0;
+  // time the reader waited for blocks not ready yet.
+  uint64_t stall_ns = 0;
+};
+
+// Drop-in replacement of FileInputStream for sequential scans.
+//
+// A background thread reads aligned blocks ahead of the current position
+// (pread) into a ring of `depth` buffers, so parsing overlaps disk io.
+// Seekg inside the current block is free, other Seekg drop the ring and
+// restart prefetching from the new position.
+class PrefetchFileInputStream : public InputStream {
+ public:
+  /**
+   * open {file_name} for read.
+   * raise exception if any error happend.
+   */
+  explicit PrefetchFileInputStream(std::string file_name,
+                                   PrefetchOptions options = {});
+
+  ~PrefetchFileInputStream() override;
+
+  bool operator!() const override { return fail_; }
+
+  explicit operator bool() const override { return !fail_; }
+
+  bool Eof() const override { return eof_; }
+
+  InputStream& GetLine(std::string* ret, char delim) override;
+
+  /**
+   * Read length bytes, if EOF is reached before length bytes, Eof() &
+   * operator!() are true after this.
+   */
+  InputStream& Read(void* buf, size_t length) override;
+
+  InputStream& Seekg(size_t pos) override;
+
+  size_t Tellg() override { return pos_; }
+
+  size_t GetLength() const override { return file_len_; }
+
+  const std::string& GetName() const override { return file_name_; }
+
+  void Close() override;
+
+  bool IsStreaming() override { return false; }
+
+  // new stream with the same options, at the same position.
+  std::unique_ptr<InputStream> Spawn() override;
+
+  PrefetchStats GetStats() const;
+
+ private:
+  struct Block {
+    std::unique_ptr<char, void (*)(void*)> buf{nullptr, nullptr};
+    // file offset of buf[0].
+    size_t offset = 0;
+    size_t size = 0;
+    // errno of pread, 0 if ok.
+    int error = 0;
+  };
+
+  // make sure current block contains pos_, return false if pos_ is EOF.
+  bool LoadBlock();
+  // return current block (if any) to the ring. need lock.
+  void ReleaseBlock();
+  void Prefetch();
+  void Stop();
+
+  const std::string file_name_;
+  const PrefetchOptions options_;
+  int fd_ = -1;
+  size_t file_len_ = 0;
+
+  // reader side.
+  size_t pos_ = 0;
+  bool eof_ = false;
+  bool fail_ = false;
+  // index of blocks_ used by reader, -1 if none.
+  int64_t current_ = -1;
+  // end of the last block taken by reader.
+  size_t next_offset_ = 0;
+
+  // shared with prefetch thread, guarded by mutex_.
+  std::vector<Block> blocks_;
+  std::deque<size_t> free_;
+  // ready blocks in file order.
+  std::deque<size_t> ready_;
+  // next block to read.
+  size_t fetch_offset_ = 0;
+  // increased by every Seekg that drops the ring.
+  uint64_t generation_ = 0;
+  bool stop_ = false;
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread worker_;
+
+  std::atomic<uint64_t> bytes_read_{0};
+  uint64_t stall_ns_ = 0;
+};
+
+}  // namespace yacl::io
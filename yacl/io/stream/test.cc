@@ -21,6 +21,7 @@
 #include "yacl/base/exception.h"
 #include "yacl/io/stream/file_io.h"
 #include "yacl/io/stream/mem_io.h"
+#include "yacl/io/stream/prefetch_file_io.h"
 
 namespace yacl::io {
 
@@ -129,4 +130,95 @@ TEST_P(IOTest, FileIO) {
   }
 }
 
+TEST_P(IOTest, PrefetchFileIO) {
+  auto param = GetParam();
+  std::filesystem::current_path(std::filesystem::temp_directory_path());
+  std::string file_name(fmt::format("{}.prefetch.test", std::time(nullptr)));
+  {
+    FileOutputStream out(file_name);
+    out.Write(param.data, strlen(param.data));
+  }
+  for (size_t block_size : {1, 3, 4096}) {
+    PrefetchOptions options;
+    options.block_size = block_size;
+    options.depth = 2;
+    std::unique_ptr<InputStream> in(
+        new PrefetchFileInputStream(file_name, options));
+    EXPECT_EQ(strlen(param.data), in->GetLength());
+    int count = 0;
+    std::string line;
+    EXPECT_EQ(in->Eof(), false);
+    while (in->GetLine(&line)) {
+      count++;
+    };
+    EXPECT_EQ(count, param.while_count);
+    EXPECT_EQ(line, param.last_line);
+    EXPECT_EQ(in->Tellg(), strlen(param.data));
+    EXPECT_EQ(in->operator bool(), false);
+    EXPECT_EQ(in->operator!(), true);
+    EXPECT_EQ(in->Eof(), true);
+
+    in->Seekg(1);  // <<<<
+    count = 0;
+    EXPECT_EQ(in->Eof(), false);
+    while (in->GetLine(&line)) {
+      count++;
+    };
+    EXPECT_EQ(count, param.while_count);
+    EXPECT_EQ(line, param.last_line);
+    EXPECT_EQ(in->Tellg(), strlen(param.data));
+    EXPECT_EQ(in->Eof(), true);
+  }
+  std::filesystem::remove(file_name);
+}
+
+TEST(PrefetchIOTest, ReadSeekWorks) {
+  std::filesystem::current_path(std::filesystem::temp_directory_path());
+  std::string file_name(fmt::format("{}.prefetch.test", std::time(nullptr)));
+  std::string data(100000, 0);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<char>(i * 131 + i / 7);
+  }
+  {
+    FileOutputStream out(file_name);
+    out.Write(data);
+  }
+
+  PrefetchOptions options;
+  options.block_size = 1000;
+  options.depth = 3;
+  PrefetchFileInputStream in(file_name, options);
+  std::string buf(3333, 0);
+  // sequential
+  for (size_t pos = 0; pos + buf.size() <= data.size(); pos += buf.size()) {
+    in.Read(buf.data(), buf.size());
+    ASSERT_TRUE(in);
+    EXPECT_EQ(buf, data.substr(pos, buf.size()));
+  }
+  EXPECT_EQ(in.GetStats().bytes_read, 100000);
+  // random seek, backward & forward
+  for (size_t pos : {5, 96000, 1234, 1500, 4100, 50000, 0, 96667}) {
+    in.Seekg(pos);
+    in.Read(buf.data(), buf.size());
+    ASSERT_TRUE(in);
+    EXPECT_EQ(in.Tellg(), pos + buf.size());
+    EXPECT_EQ(buf, data.substr(pos, buf.size()));
+  }
+  // spawn
+  in.Seekg(77777);
+  auto spawned = in.Spawn();
+  spawned->Read(buf.data(), buf.size());
+  EXPECT_EQ(buf, data.substr(77777, buf.size()));
+  // read over EOF
+  in.Seekg(99999);
+  in.Read(buf.data(), 2);
+  EXPECT_TRUE(in.Eof());
+  EXPECT_FALSE(in);
+  EXPECT_EQ(in.Tellg(), 100000);
+
+  in.Close();
+  std::filesystem::remove(file_name);
+  EXPECT_THROW(PrefetchFileInputStream{file_name}, yacl::IoError);
+}
+
 }  // namespace yacl::io
\ No newline at end of file
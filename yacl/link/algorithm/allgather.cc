@@ -14,6 +14,9 @@
 
 #include "yacl/link/algorithm/allgather.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "fmt/format.h"
 
 #include "yacl/base/exception.h"
@@ -23,15 +26,23 @@
 namespace yacl::link {
 namespace {
 const char* kType = "ALLGATHER";
-}  // namespace
-
-template <class ValueType>
-std::vector<Buffer> AllGatherImpl(const std::shared_ptr<Context>& ctx,
-                                  ValueType&& input, std::string_view tag) {
-  const auto event = fmt::format("{}:{}", ctx->NextId(), kType);
 
-  TraceLogger::LinkTrace(event, tag, input);
+CollectiveAlgo SelectAlgo(const std::shared_ptr<Context>& ctx,
+                          CollectiveAlgo algo) {
+  if (algo != CollectiveAlgo::kAuto) {
+    YACL_ENFORCE(algo == CollectiveAlgo::kDirect ||
+                     algo == CollectiveAlgo::kRing ||
+                     algo == CollectiveAlgo::kRecursiveDoubling,
+                 "unsupported allgather algo {}", static_cast<int>(algo));
+    return algo;
+  }
+  return ctx->WorldSize() <= kDirectMaxWorldSize
+             ? CollectiveAlgo::kDirect
+             : CollectiveAlgo::kRecursiveDoubling;
+}
 
+std::vector<Buffer> AllGatherDirect(const std::shared_ptr<Context>& ctx,
+                                    const std::string& event, Buffer input) {
   // broadcast to all
   for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
     if (idx == ctx->Rank()) {
@@ -45,7 +56,7 @@ std::vector<Buffer> AllGatherImpl(const std::shared_ptr<Context>& ctx,
   std::vector<Buffer> outputs(ctx->WorldSize());
   for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
     if (idx == ctx->Rank()) {
-      outputs[idx] = Buffer(std::forward<ValueType>(input));
+      outputs[idx] = std::move(input);
       continue;
     }
 
@@ -55,10 +66,80 @@ std::vector<Buffer> AllGatherImpl(const std::shared_ptr<Context>& ctx,
   return outputs;
 }
 
+std::vector<Buffer> AllGatherRing(const std::shared_ptr<Context>& ctx,
+                                  const std::string& event, Buffer input) {
+  // step s: send the block received at step s - 1 to next rank, so block of
+  // rank r reaches all ranks after n - 1 steps.
+  const size_t world_size = ctx->WorldSize();
+  std::vector<Buffer> outputs(world_size);
+  outputs[ctx->Rank()] = std::move(input);
+  for (size_t step = 0; step + 1 < world_size; step++) {
+    const auto key = fmt::format("{}:{}", event, step);
+    const size_t send_idx = (ctx->Rank() + world_size - step) % world_size;
+    const size_t recv_idx = (send_idx + world_size - 1) % world_size;
+    ctx->SendAsyncInternal(ctx->NextRank(), key, outputs[send_idx]);
+    outputs[recv_idx] = ctx->RecvInternal(ctx->PrevRank(), key);
+  }
+  return outputs;
+}
+
+std::vector<Buffer> AllGatherRecursiveDoubling(
+    const std::shared_ptr<Context>& ctx, const std::string& event,
+    Buffer input) {
+  // Bruck's algorithm, blocks[i] is the block of rank (rank + i) % n.
+  // step with distance d: send blocks[0, d) to rank - d, receive
+  // blocks[d, 2d) from rank + d. the last step is cut to n blocks.
+  const size_t world_size = ctx->WorldSize();
+  std::vector<Buffer> blocks;
+  blocks.reserve(world_size);
+  blocks.push_back(std::move(input));
+  for (size_t dist = 1; dist < world_size; dist <<= 1) {
+    const auto key = fmt::format("{}:{}", event, dist);
+    const size_t count = std::min(dist, world_size - dist);
+    std::vector<ByteContainerView> sending(blocks.begin(),
+                                           blocks.begin() + count);
+    ctx->SendAsyncInternal(ctx->PrevRank(dist), key,
+                           SerializeArrayOfBuffers(sending));
+    auto received =
+        DeserializeArrayOfBuffers(ctx->RecvInternal(ctx->NextRank(dist), key));
+    YACL_ENFORCE(received.size() == count,
+                 "allgather expect {} blocks from rank {}, got {}", count,
+                 ctx->NextRank(dist), received.size());
+    std::move(received.begin(), received.end(), std::back_inserter(blocks));
+  }
+
+  std::vector<Buffer> outputs(world_size);
+  for (size_t i = 0; i < world_size; i++) {
+    outputs[(ctx->Rank() + i) % world_size] = std::move(blocks[i]);
+  }
+  return outputs;
+}
+
+}  // namespace
+
+template <class ValueType>
+std::vector<Buffer> AllGatherImpl(const std::shared_ptr<Context>& ctx,
+                                  ValueType&& input, std::string_view tag,
+                                  CollectiveAlgo algo) {
+  const auto event = fmt::format("{}:{}", ctx->NextId(), kType);
+
+  TraceLogger::LinkTrace(event, tag, input);
+
+  Buffer buf(std::forward<ValueType>(input));
+  switch (SelectAlgo(ctx, algo)) {
+    case CollectiveAlgo::kRing:
+      return AllGatherRing(ctx, event, std::move(buf));
+    case CollectiveAlgo::kRecursiveDoubling:
+      return AllGatherRecursiveDoubling(ctx, event, std::move(buf));
+    default:
+      return AllGatherDirect(ctx, event, std::move(buf));
+  }
+}
+
 template <typename ValueType>
 std::vector<std::vector<Buffer>> AllGatherVectorImpl(
     const std::shared_ptr<Context>& ctx, ValueType&& inputs,
-    std::string_view tag) {
+    std::string_view tag, CollectiveAlgo algo) {
   const auto inputs_size = inputs.size();
   std::vector<std::vector<Buffer>> outputs(inputs_size);
   if (inputs.empty()) {
@@ -73,9 +154,9 @@ std::vector<std::vector<Buffer>> AllGatherVectorImpl(
     // special path for inputs_size == 1, skip Serialize again.
     std::vector<Buffer> output_buffer;
     if constexpr (std::is_rvalue_reference_v<decltype(inputs)>) {
-      output_buffer = AllGatherImpl(ctx, std::move(inputs[0]), tag);
+      output_buffer = AllGatherImpl(ctx, std::move(inputs[0]), tag, algo);
     } else {
-      output_buffer = AllGatherImpl(ctx, inputs[0], tag);
+      output_buffer = AllGatherImpl(ctx, inputs[0], tag, algo);
     }
 
     YACL_ENFORCE(output_buffer.size() == ctx->WorldSize());
@@ -89,7 +170,7 @@ std::vector<std::vector<Buffer>> AllGatherVectorImpl(
       inputs.clear();
     }
     std::vector<Buffer> all_outputs_packed =
-        AllGatherImpl(ctx, std::move(ser_inputs), tag);
+        AllGatherImpl(ctx, std::move(ser_inputs), tag, algo);
 
     YACL_ENFORCE(all_outputs_packed.size() == ctx->WorldSize());
 
@@ -109,14 +190,16 @@ std::vector<std::vector<Buffer>> AllGatherVectorImpl(
 }
 
 std::vector<Buffer> AllGather(const std::shared_ptr<Context>& ctx,
-                              ByteContainerView input, std::string_view tag) {
-  return AllGatherImpl(ctx, input, tag);
+                              ByteContainerView input, std::string_view tag,
+                              CollectiveAlgo algo) {
+  return AllGatherImpl(ctx, input, tag, algo);
 }
 
 std::vector<std::vector<Buffer>> AllGather(
     const std::shared_ptr<Context>& ctx,
-    const std::vector<ByteContainerView>& inputs, std::string_view tag) {
-  return AllGatherVectorImpl(ctx, inputs, tag);
+    const std::vector<ByteContainerView>& inputs, std::string_view tag,
+    CollectiveAlgo algo) {
+  return AllGatherVectorImpl(ctx, inputs, tag, algo);
 }
 
 }  // namespace yacl::link
@@ -14,15 +14,19 @@
 
 #pragma once
 
+#include "yacl/link/algorithm/collective_algo.h"
 #include "yacl/link/context.h"
 
 namespace yacl::link {
 
+// algo: kDirect, kRing or kRecursiveDoubling.
 std::vector<Buffer> AllGather(const std::shared_ptr<Context>& ctx,
-                              ByteContainerView input, std::string_view tag);
+                              ByteContainerView input, std::string_view tag,
+                              CollectiveAlgo algo = CollectiveAlgo::kAuto);
 
 std::vector<std::vector<Buffer>> AllGather(
     const std::shared_ptr<Context>& ctx,
-    const std::vector<ByteContainerView>& inputs, std::string_view tag);
+    const std::vector<ByteContainerView>& inputs, std::string_view tag,
+    CollectiveAlgo algo = CollectiveAlgo::kAuto);
 
 }  // namespace yacl::link
@@ -95,9 +95,40 @@ TEST_P(AllGatherTest, VectorWorks) {
   }
 }
 
+TEST_P(AllGatherTest, AlgoWorks) {
+  const size_t n_rounds = GetParam().n_rounds;
+  const size_t world_size = GetParam().world_size;
+  auto contexts = SetupWorld(world_size);
+
+  auto proc = [&](const std::shared_ptr<Context>& ctx) {
+    for (auto algo : {CollectiveAlgo::kDirect, CollectiveAlgo::kRing,
+                      CollectiveAlgo::kRecursiveDoubling}) {
+      for (size_t round = 0; round < n_rounds; round++) {
+        std::vector<Buffer> result =
+            AllGather(ctx, MakeRoundData(ctx->Rank(), round), "test", algo);
+
+        EXPECT_EQ(result.size(), world_size);
+        for (size_t rank = 0; rank < world_size; rank++) {
+          EXPECT_EQ(result[rank], yacl::Buffer(MakeRoundData(rank, round)));
+        }
+      }
+    }
+  };
+
+  std::vector<std::future<void>> jobs(world_size);
+  for (size_t rank = 0; rank < world_size; rank++) {
+    jobs[rank] = std::async(proc, contexts[rank]);
+  }
+
+  for (size_t rank = 0; rank < world_size; rank++) {
+    jobs[rank].get();
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(Works_Instances, AllGatherTest,
                          testing::Values(TestParams{2, 20},  //
                                          TestParams{3, 20},  //
+                                         TestParams{8, 5},   //
                                          TestParams{9, 20}   //
                                          ));
 
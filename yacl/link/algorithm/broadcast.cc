@@ -14,6 +14,9 @@
 
 #include "yacl/link/algorithm/broadcast.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "absl/numeric/bits.h"
 #include "fmt/format.h"
 
@@ -25,14 +28,45 @@ namespace {
 
 const char* kType = "BCAST";
 
+// kBinomialTree: input is sent by chunks of this size, each rank forwards a
+// chunk as soon as it is received.
+constexpr size_t kChunkSize = 1024 * 1024;
+
 size_t RingOffset(size_t begin, size_t end, size_t size) {
   return (end - begin + size) % size;
 }
 
+Buffer BroadcastDirect(const std::shared_ptr<Context>& ctx,
+                       const std::string& event, ByteContainerView input,
+                       size_t root) {
+  if (root != ctx->Rank()) {
+    return ctx->RecvInternal(root, event);
+  }
+  for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
+    if (idx != ctx->Rank()) {
+      ctx->SendAsyncInternal(idx, event, input);
+    }
+  }
+  return Buffer(input);
+}
+
 }  // namespace
 
 Buffer Broadcast(const std::shared_ptr<Context>& ctx, ByteContainerView input,
-                 size_t root, std::string_view tag) {
+                 size_t root, std::string_view tag, CollectiveAlgo algo) {
+  YACL_ENFORCE(algo == CollectiveAlgo::kAuto ||
+                   algo == CollectiveAlgo::kDirect ||
+                   algo == CollectiveAlgo::kBinomialTree,
+               "unsupported broadcast algo {}", static_cast<int>(algo));
+
+  const auto event = fmt::format("{}:{}", ctx->NextId(), kType);
+
+  TraceLogger::LinkTrace(event, tag, input);
+
+  if (algo == CollectiveAlgo::kDirect) {
+    return BroadcastDirect(ctx, event, input, root);
+  }
+
   // Binomial tree broadcast impl.
   // see: https://en.wikipedia.org/wiki/Broadcast_(parallel_pattern)
   //
@@ -41,34 +75,78 @@ Buffer Broadcast(const std::shared_ptr<Context>& ctx, ByteContainerView input,
   // |-A-|---|---|---|-A-|---| level 1, 0=>4
   // |-A-|---|-B-|---|-A-|---| level 2, 0=>2, (4=>6)
   // |-A-|-C-|-B-|-C-|-A-|-C-| level 3, 0=>1, 2=>3, 4=>5
-
-  const auto event = fmt::format("{}:{}", ctx->NextId(), kType);
-  Buffer output = yacl::Buffer(input);
-
-  TraceLogger::LinkTrace(event, tag, input);
+  //
+  // The input is split into chunks, so ranks of different levels forward
+  // different chunks at the same time. The first chunk starts with the
+  // input size, so receivers know the number of chunks.
 
   // The algorithm writes in virtual rank space, (which take root as rank 0).
   // But the actual Send/Recv rank is constructed in physical rank space.
-  const size_t vrank = RingOffset(root, ctx->Rank(), ctx->WorldSize());
-  bool received = (vrank == 0);
-  for (size_t stride = absl::bit_floor(ctx->WorldSize()); stride > 0;
-       stride >>= 1) {
-    if (!received) {
-      if (vrank % stride) {
-        // waiting for my turn.
-        continue;
+  const size_t world_size = ctx->WorldSize();
+  const size_t vrank = RingOffset(root, ctx->Rank(), world_size);
+  // vrank receives from vrank - lowbit(vrank), and sends to vrank + stride
+  // for stride from lowbit(vrank) / 2 to 1.
+  const size_t lowbit = vrank & (~vrank + 1);
+  size_t top_stride = 0;
+  if (vrank == 0) {
+    top_stride = world_size > 1 ? absl::bit_floor(world_size - 1) : 0;
+  } else {
+    top_stride = lowbit >> 1;
+  }
+  auto forward = [&](const std::string& key, ByteContainerView chunk) {
+    for (size_t stride = top_stride; stride > 0; stride >>= 1) {
+      if (vrank + stride < world_size) {
+        ctx->SendAsyncInternal(ctx->NextRank(stride), key, chunk);
       }
-      output = ctx->RecvInternal(ctx->PrevRank(stride), event);
-      received = true;
+    }
+  };
 
-    } else {
-      if (vrank + stride < ctx->WorldSize()) {
-        ctx->SendAsyncInternal(ctx->NextRank(stride), event, output);
+  uint64_t size = input.size();
+  if (vrank == 0) {
+    const size_t num_chunks = std::max<size_t>(1, (size + kChunkSize - 1) /
+                                                      kChunkSize);
+    for (size_t i = 0; i < num_chunks; i++) {
+      const auto key = fmt::format("{}:{}", event, i);
+      const size_t offset = i * kChunkSize;
+      const size_t len = std::min<size_t>(kChunkSize, size - offset);
+      if (i == 0) {
+        Buffer first(sizeof(size) + len);
+        std::memcpy(first.data(), &size, sizeof(size));
+        std::memcpy(first.data<uint8_t>() + sizeof(size), input.data(), len);
+        forward(key, first);
+      } else {
+        forward(key, ByteContainerView(input.data() + offset, len));
       }
     }
+    return Buffer(input);
   }
 
+  const size_t parent = ctx->PrevRank(lowbit);
+  Buffer first = ctx->RecvInternal(parent, fmt::format("{}:0", event));
+  YACL_ENFORCE(first.size() >= static_cast<int64_t>(sizeof(size)),
+               "broadcast chunk too short, size {}", first.size());
+  std::memcpy(&size, first.data(), sizeof(size));
+  const size_t num_chunks =
+      std::max<size_t>(1, (size + kChunkSize - 1) / kChunkSize);
+  forward(fmt::format("{}:0", event), first);
+
+  Buffer output(size);
+  size_t offset = first.size() - sizeof(size);
+  YACL_ENFORCE(offset == std::min<size_t>(kChunkSize, size),
+               "broadcast chunk 0 size mismatch, got {}", offset);
+  std::memcpy(output.data(), first.data<uint8_t>() + sizeof(size), offset);
+  for (size_t i = 1; i < num_chunks; i++) {
+    const auto key = fmt::format("{}:{}", event, i);
+    Buffer chunk = ctx->RecvInternal(parent, key);
+    forward(key, chunk);
+    YACL_ENFORCE(offset + chunk.size() <= size,
+                 "broadcast chunk {} overflow, got {}", i, chunk.size());
+    std::memcpy(output.data<uint8_t>() + offset, chunk.data(), chunk.size());
+    offset += chunk.size();
+  }
+  YACL_ENFORCE(offset == size, "broadcast expect {} bytes, got {}", size,
+               offset);
   return output;
-}  // namespace link
+}
 
 }  // namespace yacl::link
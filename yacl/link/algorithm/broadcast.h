@@ -16,11 +16,14 @@
 
 #include "yacl/base/buffer.h"
 #include "yacl/base/byte_container_view.h"
+#include "yacl/link/algorithm/collective_algo.h"
 #include "yacl/link/context.h"
 
 namespace yacl::link {
 
+// algo: kDirect or kBinomialTree (kAuto).
 Buffer Broadcast(const std::shared_ptr<Context>& ctx, ByteContainerView input,
-                 size_t root, std::string_view tag);
+                 size_t root, std::string_view tag,
+                 CollectiveAlgo algo = CollectiveAlgo::kAuto);
 
 }  // namespace yacl::link
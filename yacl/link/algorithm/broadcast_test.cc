@@ -56,6 +56,41 @@ TEST_P(BroadcastTest, Works) {
   }
 }
 
+TEST_P(BroadcastTest, AlgoWorks) {
+  const size_t world_size = GetParam().world_size;
+  auto contexts = SetupWorld(world_size);
+
+  // empty, one chunk & several chunks (with a partial one) of the pipeline.
+  std::vector<std::string> inputs = {"", "abc",
+                                     std::string(2500 * 1024 + 3, 'x')};
+  for (size_t i = 0; i < inputs[2].size(); i++) {
+    inputs[2][i] = static_cast<char>(i * 7);
+  }
+
+  auto proc = [&](const std::shared_ptr<Context>& ctx) {
+    for (auto algo :
+         {CollectiveAlgo::kDirect, CollectiveAlgo::kBinomialTree}) {
+      for (const auto& data : inputs) {
+        auto root = world_size / 2;
+        auto input = ctx->Rank() == root ? yacl::Buffer(data) : Buffer();
+
+        auto output = Broadcast(ctx, input, root, "test", algo);
+
+        EXPECT_EQ(output, yacl::Buffer(data));
+      }
+    }
+  };
+
+  std::vector<std::future<void>> jobs(world_size);
+  for (size_t rank = 0; rank < world_size; rank++) {
+    jobs[rank] = std::async(proc, contexts[rank]);
+  }
+
+  for (size_t rank = 0; rank < world_size; rank++) {
+    jobs[rank].get();
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(Works_Instances, BroadcastTest,
                          testing::Values(TestParams{2},  //
                                          TestParams{3},  //
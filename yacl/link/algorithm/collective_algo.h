@@ -0,0 +1,47 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+namespace yacl::link {
+
+// Algorithms of collectives. A collective must be called with the same algo
+// by all ranks.
+//
+// Ranks do not know input sizes of each other, so kAuto selects by world
+// size only.
+enum class CollectiveAlgo {
+  // Broadcast: always kBinomialTree, its chunk pipelining also pays off for
+  // large inputs in small worlds, and it costs one round if world size <= 2.
+  // AllGather/Gather/Scatter: kDirect if world size <= kDirectMaxWorldSize,
+  // log(n) rounds algorithms otherwise.
+  kAuto,
+  // one round, each rank sends to all receivers. O(n^2) messages.
+  kDirect,
+  // AllGather only. n - 1 rounds, each rank sends to the next rank only.
+  kRing,
+  // AllGather only. log(n) rounds, data exchanged doubles each round.
+  // Bruck's variant, so any world size works.
+  kRecursiveDoubling,
+  // Broadcast/Gather/Scatter. log(n) rounds over a binomial tree rooted at
+  // root, Broadcast pipelines large inputs by chunks along the tree.
+  kBinomialTree,
+};
+
+// kAuto of AllGather/Gather/Scatter uses kDirect if world size <= this.
+inline constexpr size_t kDirectMaxWorldSize = 4;
+
+}  // namespace yacl::link
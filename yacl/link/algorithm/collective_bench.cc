@@ -0,0 +1,185 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "benchmark/benchmark.h"
+
+#include "yacl/link/algorithm/allgather.h"
+#include "yacl/link/algorithm/broadcast.h"
+#include "yacl/link/algorithm/gather.h"
+#include "yacl/link/algorithm/reduce.h"
+#include "yacl/link/algorithm/scatter.h"
+#include "yacl/link/test_util.h"
+
+// Collectives over FactoryMem, with an emulated network: the time of a
+// collective on a capped network is estimated from link statistics as
+//   rounds * latency + max egress bytes of a rank / bandwidth,
+// i.e. assume each rank has an uplink of kBandwidth, and reported as the
+// "emu_ms" counter. "max_egress" is the max bytes sent by a rank.
+//
+// args: world size, input size in bytes.
+
+namespace yacl::link::bench {
+
+// 1Gbps uplink, 1ms one-way latency.
+constexpr double kBandwidth = 125e6;
+constexpr double kLatency = 1e-3;
+
+size_t Rounds(CollectiveAlgo algo, size_t world_size) {
+  switch (algo) {
+    case CollectiveAlgo::kDirect:
+      return 1;
+    case CollectiveAlgo::kRing:
+      return world_size - 1;
+    default:
+      return absl::bit_width(world_size - 1);
+  }
+}
+
+template <typename Fn>
+void RunCollective(benchmark::State& state, size_t rounds, Fn&& fn) {
+  // a new world for each benchmark.
+  static size_t world_id = 0;
+  const size_t world_size = state.range(0);
+  auto contexts = test::SetupWorld(fmt::format("bench_{}", world_id++),
+                                   world_size);
+
+  std::vector<size_t> sent_before(world_size);
+  size_t max_egress = 0;
+  for (auto _ : state) {
+    for (size_t rank = 0; rank < world_size; rank++) {
+      sent_before[rank] = contexts[rank]->GetStats()->sent_bytes;
+    }
+    std::vector<std::future<void>> jobs(world_size);
+    for (size_t rank = 0; rank < world_size; rank++) {
+      jobs[rank] = std::async(std::launch::async, fn, contexts[rank]);
+    }
+    for (auto& job : jobs) {
+      job.get();
+    }
+    max_egress = 0;
+    for (size_t rank = 0; rank < world_size; rank++) {
+      const size_t sent = contexts[rank]->GetStats()->sent_bytes;
+      max_egress = std::max(max_egress, sent - sent_before[rank]);
+    }
+  }
+  // each rank waits for fin messages of others.
+  std::vector<std::future<void>> fins;
+  for (auto& ctx : contexts) {
+    fins.push_back(std::async(std::launch::async,
+                              [&ctx] { ctx->WaitLinkTaskFinish(); }));
+  }
+  for (auto& fin : fins) {
+    fin.get();
+  }
+
+  state.counters["max_egress"] = max_egress;
+  state.counters["emu_ms"] =
+      (rounds * kLatency + max_egress / kBandwidth) * 1e3;
+}
+
+void BM_AllGather(benchmark::State& state, CollectiveAlgo algo) {
+  const std::string input(state.range(1), 'x');
+  const size_t rounds = Rounds(algo, state.range(0));
+  RunCollective(state, rounds, [&](const std::shared_ptr<Context>& ctx) {
+    benchmark::DoNotOptimize(AllGather(ctx, input, "bench", algo));
+  });
+}
+
+void BM_Broadcast(benchmark::State& state, CollectiveAlgo algo) {
+  const std::string input(state.range(1), 'x');
+  const size_t rounds = Rounds(algo, state.range(0));
+  RunCollective(state, rounds, [&](const std::shared_ptr<Context>& ctx) {
+    benchmark::DoNotOptimize(Broadcast(ctx, input, 0, "bench", algo));
+  });
+}
+
+void BM_Gather(benchmark::State& state, CollectiveAlgo algo) {
+  const std::string input(state.range(1), 'x');
+  const size_t rounds = Rounds(algo, state.range(0));
+  RunCollective(state, rounds, [&](const std::shared_ptr<Context>& ctx) {
+    benchmark::DoNotOptimize(Gather(ctx, input, 0, "bench", algo));
+  });
+}
+
+void BM_Scatter(benchmark::State& state, CollectiveAlgo algo) {
+  const size_t world_size = state.range(0);
+  const std::vector<std::string> inputs(world_size,
+                                        std::string(state.range(1), 'x'));
+  const size_t rounds = Rounds(algo, state.range(0));
+  RunCollective(state, rounds, [&](const std::shared_ptr<Context>& ctx) {
+    benchmark::DoNotOptimize(
+        Scatter(ctx, {inputs.begin(), inputs.end()}, 0, "bench", algo));
+  });
+}
+
+// sum of uint64 shares, by AllReduce or by AllGather & local reduce.
+void BM_SumShares(benchmark::State& state, bool all_reduce) {
+  const size_t world_size = state.range(0);
+  // AllReduce is direct for small inputs, see reduce.cc.
+  const size_t bytes = state.range(1);
+  const bool ring =
+      all_reduce && world_size > 2 && bytes >= 64 * 1024 * world_size;
+  const size_t rounds = ring ? 2 * (world_size - 1) : 1;
+  const std::vector<uint64_t> input(bytes / sizeof(uint64_t), 1);
+  RunCollective(state, rounds, [&](const std::shared_ptr<Context>& ctx) {
+    if (all_reduce) {
+      benchmark::DoNotOptimize(
+          AllReduce<uint64_t>(ctx, input, RingAdd<uint64_t>(), "bench"));
+      return;
+    }
+    auto shares = AllGather(
+        ctx, ByteContainerView(input.data(), input.size() * sizeof(uint64_t)),
+        "bench", CollectiveAlgo::kDirect);
+    std::vector<uint64_t> sum(input.size());
+    for (const auto& share : shares) {
+      RingAdd<uint64_t>()(sum.data(), share.data<uint64_t>(), sum.size());
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+#define COLLECTIVE_ARGS                                               \
+  ArgsProduct({{4, 8, 16}, {1 << 10, 1 << 20}})                       \
+      ->UseRealTime()                                                 \
+      ->Unit(benchmark::kMillisecond)
+
+BENCHMARK_CAPTURE(BM_AllGather, direct, CollectiveAlgo::kDirect)
+    ->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_AllGather, ring, CollectiveAlgo::kRing)->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_AllGather, recursive_doubling,
+                  CollectiveAlgo::kRecursiveDoubling)
+    ->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_Broadcast, direct, CollectiveAlgo::kDirect)
+    ->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_Broadcast, binomial_tree, CollectiveAlgo::kBinomialTree)
+    ->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_Gather, direct, CollectiveAlgo::kDirect)->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_Gather, binomial_tree, CollectiveAlgo::kBinomialTree)
+    ->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_Scatter, direct, CollectiveAlgo::kDirect)
+    ->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_Scatter, binomial_tree, CollectiveAlgo::kBinomialTree)
+    ->COLLECTIVE_ARGS;
+
+BENCHMARK_CAPTURE(BM_SumShares, allgather, false)->COLLECTIVE_ARGS;
+BENCHMARK_CAPTURE(BM_SumShares, allreduce, true)->COLLECTIVE_ARGS;
+
+}  // namespace yacl::link::bench
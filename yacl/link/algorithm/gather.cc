@@ -14,6 +14,9 @@
 
 #include "yacl/link/algorithm/gather.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "fmt/format.h"
 
 #include "yacl/base/exception.h"
@@ -23,15 +26,71 @@
 namespace yacl::link {
 namespace {
 const char* kType = "GATHER";
+
+CollectiveAlgo SelectAlgo(const std::shared_ptr<Context>& ctx,
+                          CollectiveAlgo algo) {
+  if (algo != CollectiveAlgo::kAuto) {
+    YACL_ENFORCE(algo == CollectiveAlgo::kDirect ||
+                     algo == CollectiveAlgo::kBinomialTree,
+                 "unsupported gather algo {}", static_cast<int>(algo));
+    return algo;
+  }
+  return ctx->WorldSize() <= kDirectMaxWorldSize
+             ? CollectiveAlgo::kDirect
+             : CollectiveAlgo::kBinomialTree;
+}
+
+std::vector<Buffer> GatherTree(const std::shared_ptr<Context>& ctx,
+                               const std::string& event, Buffer input,
+                               size_t root) {
+  // in virtual rank space (root as 0), blocks[i] is the block of vrank + i.
+  // step with stride s: vrank with bit s sends its blocks to vrank - s and
+  // quits, others receive the blocks of [vrank + s, vrank + 2s).
+  const size_t world_size = ctx->WorldSize();
+  const size_t vrank = (ctx->Rank() + world_size - root) % world_size;
+  std::vector<Buffer> blocks;
+  blocks.push_back(std::move(input));
+  for (size_t stride = 1; stride < world_size; stride <<= 1) {
+    const auto key = fmt::format("{}:{}", event, stride);
+    if (vrank & stride) {
+      std::vector<ByteContainerView> sending(blocks.begin(), blocks.end());
+      ctx->SendAsyncInternal(ctx->PrevRank(stride), key,
+                             SerializeArrayOfBuffers(sending));
+      return {};
+    }
+    if (vrank + stride < world_size) {
+      const size_t count = std::min(stride, world_size - vrank - stride);
+      auto received = DeserializeArrayOfBuffers(
+          ctx->RecvInternal(ctx->NextRank(stride), key));
+      YACL_ENFORCE(received.size() == count,
+                   "gather expect {} blocks from rank {}, got {}", count,
+                   ctx->NextRank(stride), received.size());
+      std::move(received.begin(), received.end(), std::back_inserter(blocks));
+    }
+  }
+
+  // root only.
+  std::vector<Buffer> res(world_size);
+  for (size_t i = 0; i < world_size; i++) {
+    res[(root + i) % world_size] = std::move(blocks[i]);
+  }
+  return res;
+}
+
 }  // namespace
 
 template <typename ValueType>
 std::vector<Buffer> GatherImpl(const std::shared_ptr<Context>& ctx,
                                ValueType&& input, size_t root,
-                               std::string_view tag) {
+                               std::string_view tag, CollectiveAlgo algo) {
   const auto event = fmt::format("{}:{}", ctx->NextId(), kType);
   TraceLogger::LinkTrace(event, tag, input);
 
+  if (SelectAlgo(ctx, algo) == CollectiveAlgo::kBinomialTree) {
+    return GatherTree(ctx, event, Buffer(std::forward<ValueType>(input)),
+                      root);
+  }
+
   std::vector<Buffer> res;
 
   if (root == ctx->Rank()) {
@@ -53,7 +112,7 @@ std::vector<Buffer> GatherImpl(const std::shared_ptr<Context>& ctx,
 template <typename ValueType>
 std::vector<std::vector<Buffer>> GatherVectorImpl(
     const std::shared_ptr<Context>& ctx, ValueType&& inputs, size_t root,
-    std::string_view tag) {
+    std::string_view tag, CollectiveAlgo algo) {
   const auto inputs_size = inputs.size();
   std::vector<std::vector<Buffer>> outputs(inputs_size);
   if (inputs.empty()) {
@@ -70,9 +129,9 @@ std::vector<std::vector<Buffer>> GatherVectorImpl(
     // special path for inputs_size == 1, skip Serialize again.
     std::vector<Buffer> output_buffer;
     if constexpr (std::is_rvalue_reference_v<decltype(inputs)>) {
-      output_buffer = GatherImpl(ctx, std::move(inputs[0]), root, tag);
+      output_buffer = GatherImpl(ctx, std::move(inputs[0]), root, tag, algo);
     } else {
-      output_buffer = GatherImpl(ctx, inputs[0], root, tag);
+      output_buffer = GatherImpl(ctx, inputs[0], root, tag, algo);
     }
 
     if (root == ctx->Rank()) {
@@ -90,7 +149,7 @@ std::vector<std::vector<Buffer>> GatherVectorImpl(
       inputs.clear();
     }
     std::vector<Buffer> all_outputs_packed =
-        GatherImpl(ctx, std::move(ser_inputs), root, tag);
+        GatherImpl(ctx, std::move(ser_inputs), root, tag, algo);
 
     if (root == ctx->Rank()) {
       YACL_ENFORCE(all_outputs_packed.size() == ctx->WorldSize());
@@ -118,15 +177,15 @@ std::vector<std::vector<Buffer>> GatherVectorImpl(
 
 std::vector<Buffer> Gather(const std::shared_ptr<Context>& ctx,
                            ByteContainerView input, size_t root,
-                           std::string_view tag) {
-  return GatherImpl(ctx, input, root, tag);
+                           std::string_view tag, CollectiveAlgo algo) {
+  return GatherImpl(ctx, input, root, tag, algo);
 }
 
 std::vector<std::vector<Buffer>> Gather(
     const std::shared_ptr<Context>& ctx,
     const std::vector<ByteContainerView>& inputs, size_t root,
-    std::string_view tag) {
-  return GatherVectorImpl(ctx, inputs, root, tag);
+    std::string_view tag, CollectiveAlgo algo) {
+  return GatherVectorImpl(ctx, inputs, root, tag, algo);
 }
 
 }  // namespace yacl::link
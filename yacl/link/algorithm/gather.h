@@ -16,17 +16,20 @@
 
 #include "yacl/base/buffer.h"
 #include "yacl/base/byte_container_view.h"
+#include "yacl/link/algorithm/collective_algo.h"
 #include "yacl/link/context.h"
 
 namespace yacl::link {
 
+// algo: kDirect or kBinomialTree.
 std::vector<Buffer> Gather(const std::shared_ptr<Context>& ctx,
                            ByteContainerView input, size_t root,
-                           std::string_view tag);
+                           std::string_view tag,
+                           CollectiveAlgo algo = CollectiveAlgo::kAuto);
 
 std::vector<std::vector<Buffer>> Gather(
     const std::shared_ptr<Context>& ctx,
     const std::vector<ByteContainerView>& inputs, size_t root,
-    std::string_view tag);
+    std::string_view tag, CollectiveAlgo algo = CollectiveAlgo::kAuto);
 
 }  // namespace yacl::link
@@ -111,9 +111,45 @@ TEST_P(GatherTest, VectorWorks) {
   }
 }
 
+TEST_P(GatherTest, AlgoWorks) {
+  const size_t world_size = GetParam().world_size;
+  auto contexts = SetupWorld(world_size);
+
+  auto proc = [&](const std::shared_ptr<Context>& ctx) {
+    for (auto algo :
+         {CollectiveAlgo::kDirect, CollectiveAlgo::kBinomialTree}) {
+      for (size_t round = 0; round < world_size; round++) {
+        // each round take a different party as root.
+        size_t root = round;
+        auto result = Gather(ctx, MakeRoundData(ctx->Rank(), round), root,
+                             "test", algo);
+
+        if (ctx->Rank() == root) {
+          EXPECT_EQ(result.size(), world_size);
+          for (size_t rank = 0; rank < world_size; rank++) {
+            EXPECT_EQ(result[rank], yacl::Buffer(MakeRoundData(rank, round)));
+          }
+        } else {
+          EXPECT_TRUE(result.empty());
+        }
+      }
+    }
+  };
+
+  std::vector<std::future<void>> jobs(world_size);
+  for (size_t rank = 0; rank < world_size; rank++) {
+    jobs[rank] = std::async(proc, contexts[rank]);
+  }
+
+  for (size_t rank = 0; rank < world_size; rank++) {
+    jobs[rank].get();
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(Works_Instances, GatherTest,
                          testing::Values(TestParams{2},  //
                                          TestParams{3},  //
+                                         TestParams{6},  //
                                          TestParams{9}   //
                                          ));
 
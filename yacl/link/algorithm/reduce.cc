@@ -0,0 +1,254 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/algorithm/reduce.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "fmt/format.h"
+
+#include "yacl/base/exception.h"
+#include "yacl/link/trace.h"
+
+namespace yacl::link::internal {
+namespace {
+
+const char* kReduceType = "REDUCE";
+const char* kAllReduceType = "ALLREDUCE";
+const char* kReduceScatterType = "REDUCESCATTER";
+
+// ring algorithms are used if each segment has at least this many bytes,
+// i.e. the per round cost is dominated by bandwidth rather than latency.
+constexpr size_t kRingMinSegmentBytes = 64 * 1024;
+// ring algorithms send segments by chunks of this size.
+constexpr size_t kChunkBytes = 256 * 1024;
+
+// view of the vector as world_size segments.
+class Segments {
+ public:
+  Segments(size_t num, size_t elem_size, size_t world_size)
+      : num_(num), elem_size_(elem_size), world_size_(world_size) {}
+
+  // in bytes.
+  size_t Begin(size_t i) const {
+    return ReduceScatterRange(num_, world_size_, i).first * elem_size_;
+  }
+  size_t Size(size_t i) const {
+    auto [begin, end] = ReduceScatterRange(num_, world_size_, i);
+    return (end - begin) * elem_size_;
+  }
+
+  bool UseRing() const {
+    return world_size_ > 2 &&
+           num_ * elem_size_ >= kRingMinSegmentBytes * world_size_;
+  }
+
+ private:
+  const size_t num_;
+  const size_t elem_size_;
+  const size_t world_size_;
+};
+
+size_t ChunkBytes(size_t elem_size) {
+  return std::max<size_t>(1, kChunkBytes / elem_size) * elem_size;
+}
+
+size_t NumElements(ByteContainerView input, size_t elem_size) {
+  YACL_ENFORCE(elem_size > 0 && input.size() % elem_size == 0,
+               "input size {} is not a multiple of element size {}",
+               input.size(), elem_size);
+  return input.size() / elem_size;
+}
+
+// recv size bytes from src by chunks, and reduce (or copy if fn is null)
+// each chunk into data.
+void RecvChunks(const std::shared_ptr<Context>& ctx, size_t src,
+                const std::string& key, uint8_t* data, size_t size,
+                size_t elem_size, const ReduceFn* fn) {
+  const size_t chunk_bytes = ChunkBytes(elem_size);
+  for (size_t pos = 0, c = 0; pos < size; pos += chunk_bytes, c++) {
+    const size_t len = std::min(chunk_bytes, size - pos);
+    Buffer buf = ctx->RecvInternal(src, fmt::format("{}:{}", key, c));
+    YACL_ENFORCE(static_cast<size_t>(buf.size()) == len,
+                 "reduce expect {} bytes from rank {}, got {}, input sizes "
+                 "of ranks mismatch?",
+                 len, src, buf.size());
+    if (fn != nullptr) {
+      (*fn)(data + pos, buf.data(), len / elem_size);
+    } else {
+      std::memcpy(data + pos, buf.data(), len);
+    }
+  }
+}
+
+void SendChunks(const std::shared_ptr<Context>& ctx, size_t dst,
+                const std::string& key, const uint8_t* data, size_t size,
+                size_t elem_size) {
+  const size_t chunk_bytes = ChunkBytes(elem_size);
+  for (size_t pos = 0, c = 0; pos < size; pos += chunk_bytes, c++) {
+    const size_t len = std::min(chunk_bytes, size - pos);
+    ctx->SendAsyncInternal(dst, fmt::format("{}:{}", key, c),
+                           ByteContainerView(data + pos, len));
+  }
+}
+
+// data: the input, segment i of data is reduced over all ranks after this,
+// with i = rank.
+void RingReduceScatter(const std::shared_ptr<Context>& ctx,
+                       const std::string& event, const Segments& segs,
+                       size_t elem_size, const ReduceFn& fn, uint8_t* data) {
+  // step s: send segment rank - s - 1 (reduced by s + 1 ranks) to next rank,
+  // and reduce segment rank - s - 2 received from prev rank.
+  const size_t n = ctx->WorldSize();
+  for (size_t step = 0; step + 1 < n; step++) {
+    const auto key = fmt::format("{}:rs{}", event, step);
+    const size_t send_seg = (ctx->Rank() + 2 * n - step - 1) % n;
+    const size_t recv_seg = (ctx->Rank() + 2 * n - step - 2) % n;
+    SendChunks(ctx, ctx->NextRank(), key, data + segs.Begin(send_seg),
+               segs.Size(send_seg), elem_size);
+    RecvChunks(ctx, ctx->PrevRank(), key, data + segs.Begin(recv_seg),
+               segs.Size(recv_seg), elem_size, &fn);
+  }
+}
+
+// data: segment rank of data is reduced, all segments are after this.
+void RingAllGather(const std::shared_ptr<Context>& ctx,
+                   const std::string& event, const Segments& segs,
+                   size_t elem_size, uint8_t* data) {
+  const size_t n = ctx->WorldSize();
+  for (size_t step = 0; step + 1 < n; step++) {
+    const auto key = fmt::format("{}:ag{}", event, step);
+    const size_t send_seg = (ctx->Rank() + n - step) % n;
+    const size_t recv_seg = (ctx->Rank() + n - step - 1) % n;
+    SendChunks(ctx, ctx->NextRank(), key, data + segs.Begin(send_seg),
+               segs.Size(send_seg), elem_size);
+    RecvChunks(ctx, ctx->PrevRank(), key, data + segs.Begin(recv_seg),
+               segs.Size(recv_seg), elem_size, nullptr);
+  }
+}
+
+}  // namespace
+
+void AllReduceImpl(const std::shared_ptr<Context>& ctx,
+                   ByteContainerView input, size_t elem_size,
+                   const ReduceFn& fn, std::string_view tag, uint8_t* output) {
+  const size_t num = NumElements(input, elem_size);
+  const auto event = fmt::format("{}:{}", ctx->NextId(), kAllReduceType);
+  TraceLogger::LinkTrace(event, tag, input);
+
+  // output & input.data() may be null if input is empty.
+  if (!input.empty()) {
+    std::memcpy(output, input.data(), input.size());
+  }
+  const Segments segs(num, elem_size, ctx->WorldSize());
+  if (segs.UseRing()) {
+    RingReduceScatter(ctx, event, segs, elem_size, fn, output);
+    RingAllGather(ctx, event, segs, elem_size, output);
+    return;
+  }
+
+  // direct: send the whole vector to all.
+  for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
+    if (idx != ctx->Rank()) {
+      SendChunks(ctx, idx, event, input.data(), input.size(), elem_size);
+    }
+  }
+  for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
+    if (idx != ctx->Rank()) {
+      RecvChunks(ctx, idx, event, output, input.size(), elem_size, &fn);
+    }
+  }
+}
+
+void ReduceImpl(const std::shared_ptr<Context>& ctx, ByteContainerView input,
+                size_t elem_size, const ReduceFn& fn, size_t root,
+                std::string_view tag, uint8_t* output) {
+  const size_t num = NumElements(input, elem_size);
+  const auto event = fmt::format("{}:{}", ctx->NextId(), kReduceType);
+  TraceLogger::LinkTrace(event, tag, input);
+
+  const Segments segs(num, elem_size, ctx->WorldSize());
+  if (segs.UseRing()) {
+    // reduce-scatter, then gather the segments to root.
+    std::vector<uint8_t> data(input.begin(), input.end());
+    RingReduceScatter(ctx, event, segs, elem_size, fn, data.data());
+    const auto key = fmt::format("{}:gather", event);
+    const size_t rank = ctx->Rank();
+    if (rank != root) {
+      SendChunks(ctx, root, key, data.data() + segs.Begin(rank),
+                 segs.Size(rank), elem_size);
+      return;
+    }
+    std::memcpy(output + segs.Begin(rank), data.data() + segs.Begin(rank),
+                segs.Size(rank));
+    for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
+      if (idx != rank) {
+        RecvChunks(ctx, idx, key, output + segs.Begin(idx), segs.Size(idx),
+                   elem_size, nullptr);
+      }
+    }
+    return;
+  }
+
+  // direct: send the whole vector to root.
+  if (ctx->Rank() != root) {
+    SendChunks(ctx, root, event, input.data(), input.size(), elem_size);
+    return;
+  }
+  if (!input.empty()) {
+    std::memcpy(output, input.data(), input.size());
+  }
+  for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
+    if (idx != root) {
+      RecvChunks(ctx, idx, event, output, input.size(), elem_size, &fn);
+    }
+  }
+}
+
+void ReduceScatterImpl(const std::shared_ptr<Context>& ctx,
+                       ByteContainerView input, size_t elem_size,
+                       const ReduceFn& fn, std::string_view tag,
+                       uint8_t* output) {
+  const size_t num = NumElements(input, elem_size);
+  const auto event = fmt::format("{}:{}", ctx->NextId(), kReduceScatterType);
+  TraceLogger::LinkTrace(event, tag, input);
+
+  const size_t rank = ctx->Rank();
+  const Segments segs(num, elem_size, ctx->WorldSize());
+  if (segs.UseRing()) {
+    std::vector<uint8_t> data(input.begin(), input.end());
+    RingReduceScatter(ctx, event, segs, elem_size, fn, data.data());
+    std::memcpy(output, data.data() + segs.Begin(rank), segs.Size(rank));
+    return;
+  }
+
+  // direct: send segment i to rank i.
+  for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
+    if (idx != rank) {
+      SendChunks(ctx, idx, event, input.data() + segs.Begin(idx),
+                 segs.Size(idx), elem_size);
+    }
+  }
+  if (segs.Size(rank) > 0) {
+    std::memcpy(output, input.data() + segs.Begin(rank), segs.Size(rank));
+  }
+  for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
+    if (idx != rank) {
+      RecvChunks(ctx, idx, event, output, segs.Size(rank), elem_size, &fn);
+    }
+  }
+}
+
+}  // namespace yacl::link::internal
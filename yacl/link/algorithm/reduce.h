@@ -0,0 +1,209 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/types/span.h"
+
+#include "yacl/base/byte_container_view.h"
+#include "yacl/base/int128.h"
+#include "yacl/link/algorithm/reduce_avx2.h"
+#include "yacl/link/context.h"
+
+namespace yacl::link {
+
+// Typed reduction collectives, inputs of all ranks must have the same
+// number of elements. The reduce op must be associative and commutative,
+// ranks may combine inputs in different orders.
+//
+// Small inputs are sent directly (one round, O(n * size) traffic per rank).
+// Large inputs use ring reduce-scatter (+ ring allgather for AllReduce),
+// O(size) traffic per rank, chunked so that reducing a chunk overlaps
+// receiving the next one.
+
+// Reduce ops, acc[i] = acc[i] op in[i] for i in [0, n), acc and in never
+// overlap. 32/64-bit adds and xor use the AVX2 kernels of reduce_avx2.h if
+// the cpu has them, otherwise plain loops the compiler may vectorize.
+
+// a + b mod 2^k, k <= bits of T.
+template <typename T>
+class RingAdd {
+ public:
+  static_assert(std::is_unsigned_v<T> || std::is_same_v<T, uint128_t>);
+
+  explicit RingAdd(size_t k = sizeof(T) * 8)
+      : mask_(k >= sizeof(T) * 8 ? ~T(0) : (T(1) << k) - 1) {}
+
+  void operator()(T* __restrict acc, const T* __restrict in,
+                  size_t n) const {
+    if constexpr (std::is_same_v<T, uint32_t>) {
+      if (internal::ReduceAvx2Supported()) {
+        return internal::RingAdd32Avx2(acc, in, n, mask_);
+      }
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+      if (internal::ReduceAvx2Supported()) {
+        return internal::RingAdd64Avx2(acc, in, n, mask_);
+      }
+    }
+#pragma GCC ivdep
+    for (size_t i = 0; i < n; i++) {
+      acc[i] = (acc[i] + in[i]) & mask_;
+    }
+  }
+
+ private:
+  const T mask_;
+};
+
+// a ^ b, e.g. uint128_t xor shares.
+template <typename T>
+struct BitXor {
+  void operator()(T* __restrict acc, const T* __restrict in,
+                  size_t n) const {
+    auto* acc_bytes = reinterpret_cast<uint8_t*>(acc);
+    const auto* in_bytes = reinterpret_cast<const uint8_t*>(in);
+    const size_t size = n * sizeof(T);
+    if (internal::ReduceAvx2Supported()) {
+      return internal::XorAvx2(acc_bytes, in_bytes, size);
+    }
+    // by 64-bit lanes whatever T is, e.g. uint128_t is not vectorized.
+    size_t i = 0;
+#pragma GCC ivdep
+    for (; i + 8 <= size; i += 8) {
+      uint64_t a;
+      uint64_t b;
+      std::memcpy(&a, acc_bytes + i, 8);
+      std::memcpy(&b, in_bytes + i, 8);
+      a ^= b;
+      std::memcpy(acc_bytes + i, &a, 8);
+    }
+    for (; i < size; i++) {
+      acc_bytes[i] ^= in_bytes[i];
+    }
+  }
+};
+
+// a + b mod p, for a, b in [0, p).
+class FieldAdd {
+ public:
+  explicit FieldAdd(uint64_t p) : p_(p) {}
+
+  void operator()(uint64_t* __restrict acc, const uint64_t* __restrict in,
+                  size_t n) const {
+    if (internal::ReduceAvx2Supported()) {
+      return internal::FieldAddAvx2(acc, in, n, p_);
+    }
+#pragma GCC ivdep
+    for (size_t i = 0; i < n; i++) {
+      uint64_t s = acc[i] + in[i];
+      // branchless, s overflows only if p > 2^63.
+      acc[i] = (s < in[i] || s >= p_) ? s - p_ : s;
+    }
+  }
+
+ private:
+  const uint64_t p_;
+};
+
+namespace internal {
+
+// type erased reduce op over num elements.
+using ReduceFn = std::function<void(void* acc, const void* in, size_t num)>;
+
+// output size: input size for AllReduce & Reduce (root only), segment size
+// for ReduceScatter, see ReduceScatterRange.
+void AllReduceImpl(const std::shared_ptr<Context>& ctx,
+                   ByteContainerView input, size_t elem_size,
+                   const ReduceFn& fn, std::string_view tag, uint8_t* output);
+
+void ReduceImpl(const std::shared_ptr<Context>& ctx, ByteContainerView input,
+                size_t elem_size, const ReduceFn& fn, size_t root,
+                std::string_view tag, uint8_t* output);
+
+void ReduceScatterImpl(const std::shared_ptr<Context>& ctx,
+                       ByteContainerView input, size_t elem_size,
+                       const ReduceFn& fn, std::string_view tag,
+                       uint8_t* output);
+
+template <typename T, typename Op>
+ReduceFn MakeReduceFn(Op op) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  return [op = std::move(op)](void* acc, const void* in, size_t num) {
+    op(static_cast<T*>(acc), static_cast<const T*>(in), num);
+  };
+}
+
+template <typename T>
+ByteContainerView AsBytes(absl::Span<const T> input) {
+  return {reinterpret_cast<const uint8_t*>(input.data()),
+          input.size() * sizeof(T)};
+}
+
+}  // namespace internal
+
+// ReduceScatter: rank i gets elements [begin, end) of the reduced vector.
+inline std::pair<size_t, size_t> ReduceScatterRange(size_t num,
+                                                    size_t world_size,
+                                                    size_t rank) {
+  return {num * rank / world_size, num * (rank + 1) / world_size};
+}
+
+// all ranks get the reduced vector.
+template <typename T, typename Op>
+std::vector<T> AllReduce(const std::shared_ptr<Context>& ctx,
+                         absl::Span<const T> input, Op op,
+                         std::string_view tag) {
+  std::vector<T> output(input.size());
+  internal::AllReduceImpl(ctx, internal::AsBytes(input), sizeof(T),
+                          internal::MakeReduceFn<T>(std::move(op)), tag,
+                          reinterpret_cast<uint8_t*>(output.data()));
+  return output;
+}
+
+// root gets the reduced vector, others get an empty one.
+template <typename T, typename Op>
+std::vector<T> Reduce(const std::shared_ptr<Context>& ctx,
+                      absl::Span<const T> input, Op op, size_t root,
+                      std::string_view tag) {
+  std::vector<T> output(ctx->Rank() == root ? input.size() : 0);
+  internal::ReduceImpl(ctx, internal::AsBytes(input), sizeof(T),
+                       internal::MakeReduceFn<T>(std::move(op)), root, tag,
+                       reinterpret_cast<uint8_t*>(output.data()));
+  return output;
+}
+
+// rank i gets the i-th segment of the reduced vector, see ReduceScatterRange.
+template <typename T, typename Op>
+std::vector<T> ReduceScatter(const std::shared_ptr<Context>& ctx,
+                             absl::Span<const T> input, Op op,
+                             std::string_view tag) {
+  auto [begin, end] =
+      ReduceScatterRange(input.size(), ctx->WorldSize(), ctx->Rank());
+  std::vector<T> output(end - begin);
+  internal::ReduceScatterImpl(ctx, internal::AsBytes(input), sizeof(T),
+                              internal::MakeReduceFn<T>(std::move(op)), tag,
+                              reinterpret_cast<uint8_t*>(output.data()));
+  return output;
+}
+
+}  // namespace yacl::link
@@ -0,0 +1,125 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "yacl/link/algorithm/reduce_avx2.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "yacl/base/exception.h"
+#include "yacl/utils/platform_utils.h"
+
+namespace yacl::link::internal {
+
+#ifdef __AVX2__
+
+namespace {
+
+inline __m256i Load(const void* p) {
+  return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+}
+
+inline void Store(void* p, __m256i v) {
+  _mm256_storeu_si256(static_cast<__m256i*>(p), v);
+}
+
+}  // namespace
+
+bool ReduceAvx2Supported() { return hasAVX2(); }
+
+void XorAvx2(uint8_t* acc, const uint8_t* in, size_t size) {
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    Store(acc + i, _mm256_xor_si256(Load(acc + i), Load(in + i)));
+  }
+  for (; i < size; i++) {
+    acc[i] ^= in[i];
+  }
+}
+
+void RingAdd32Avx2(uint32_t* acc, const uint32_t* in, size_t n,
+                   uint32_t mask) {
+  const __m256i m = _mm256_set1_epi32(static_cast<int32_t>(mask));
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i s = _mm256_add_epi32(Load(acc + i), Load(in + i));
+    Store(acc + i, _mm256_and_si256(s, m));
+  }
+  for (; i < n; i++) {
+    acc[i] = (acc[i] + in[i]) & mask;
+  }
+}
+
+void RingAdd64Avx2(uint64_t* acc, const uint64_t* in, size_t n,
+                   uint64_t mask) {
+  const __m256i m = _mm256_set1_epi64x(static_cast<int64_t>(mask));
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256i s = _mm256_add_epi64(Load(acc + i), Load(in + i));
+    Store(acc + i, _mm256_and_si256(s, m));
+  }
+  for (; i < n; i++) {
+    acc[i] = (acc[i] + in[i]) & mask;
+  }
+}
+
+void FieldAddAvx2(uint64_t* acc, const uint64_t* in, size_t n, uint64_t p) {
+  // AVX2 only compares signed 64-bit, x < y unsigned iff
+  // (y ^ 2^63) > (x ^ 2^63) signed.
+  const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+  const __m256i ones = _mm256_set1_epi64x(-1);
+  const __m256i pv = _mm256_set1_epi64x(static_cast<int64_t>(p));
+  const __m256i p_flip = _mm256_xor_si256(pv, sign);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256i b = Load(in + i);
+    const __m256i s = _mm256_add_epi64(Load(acc + i), b);
+    const __m256i s_flip = _mm256_xor_si256(s, sign);
+    // s < b (overflow) or !(s < p).
+    const __m256i overflow =
+        _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), s_flip);
+    const __m256i below_p = _mm256_cmpgt_epi64(p_flip, s_flip);
+    const __m256i sub =
+        _mm256_or_si256(overflow, _mm256_xor_si256(below_p, ones));
+    Store(acc + i, _mm256_sub_epi64(s, _mm256_and_si256(sub, pv)));
+  }
+  for (; i < n; i++) {
+    uint64_t s = acc[i] + in[i];
+    acc[i] = (s < in[i] || s >= p) ? s - p : s;
+  }
+}
+
+#else
+
+bool ReduceAvx2Supported() { return false; }
+
+void XorAvx2(uint8_t*, const uint8_t*, size_t) {
+  YACL_THROW("XorAvx2 is not supported on this platform");
+}
+
+void RingAdd32Avx2(uint32_t*, const uint32_t*, size_t, uint32_t) {
+  YACL_THROW("RingAdd32Avx2 is not supported on this platform");
+}
+
+void RingAdd64Avx2(uint64_t*, const uint64_t*, size_t, uint64_t) {
+  YACL_THROW("RingAdd64Avx2 is not supported on this platform");
+}
+
+void FieldAddAvx2(uint64_t*, const uint64_t*, size_t, uint64_t) {
+  YACL_THROW("FieldAddAvx2 is not supported on this platform");
+}
+
+#endif
+
+}  // namespace yacl::link::internal
@@ -0,0 +1,41 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace yacl::link::internal {
+
+// AVX2 kernels of the reduce ops in reduce.h, acc[i] = acc[i] op in[i] for
+// i in [0, n). acc and in must not overlap. GCC before 12 does not
+// vectorize the plain loops at -O2, and the 64-bit unsigned compare of
+// FieldAdd has no direct AVX2 instruction.
+
+// whether the kernels are usable on this cpu, i.e. x86_64 with AVX2.
+bool ReduceAvx2Supported();
+
+// xor of size bytes.
+void XorAvx2(uint8_t* acc, const uint8_t* in, size_t size);
+
+// (a + b) & mask.
+void RingAdd32Avx2(uint32_t* acc, const uint32_t* in, size_t n,
+                   uint32_t mask);
+void RingAdd64Avx2(uint64_t* acc, const uint64_t* in, size_t n,
+                   uint64_t mask);
+
+// a + b mod p, for a, b in [0, p).
+void FieldAddAvx2(uint64_t* acc, const uint64_t* in, size_t n, uint64_t p);
+
+}  // namespace yacl::link::internal
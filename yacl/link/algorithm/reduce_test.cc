@@ -0,0 +1,180 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/algorithm/reduce.h"
+
+#include <future>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "yacl/link/test_util.h"
+
+namespace yacl::link::test {
+
+struct TestParams {
+  size_t world_size;
+};
+
+class ReduceTest : public ::testing::TestWithParam<TestParams> {};
+
+template <typename T>
+std::vector<T> MakeInput(size_t rank, size_t num, T mod) {
+  std::mt19937_64 rng(rank * 1000 + num);
+  std::vector<T> ret(num);
+  for (auto& v : ret) {
+    v = (static_cast<T>(rng()) << 32) ^ static_cast<T>(rng());
+    if (mod != 0) {
+      v %= mod;
+    }
+  }
+  return ret;
+}
+
+template <typename T, typename Op>
+void TestReduce(size_t world_size, Op op, T mod) {
+  auto contexts = SetupWorld(world_size);
+
+  // direct & ring, with segments of different sizes.
+  for (size_t num : {size_t{0}, size_t{1}, size_t{17}, size_t{100003}}) {
+    // expected
+    auto expect = MakeInput<T>(0, num, mod);
+    for (size_t rank = 1; rank < world_size; rank++) {
+      auto input = MakeInput<T>(rank, num, mod);
+      op(expect.data(), input.data(), num);
+    }
+
+    auto proc = [&](const std::shared_ptr<Context>& ctx) {
+      auto input = MakeInput<T>(ctx->Rank(), num, mod);
+
+      auto all = AllReduce<T>(ctx, input, op, "test");
+      EXPECT_EQ(all, expect);
+
+      const size_t root = num % world_size;
+      auto reduced = Reduce<T>(ctx, input, op, root, "test");
+      if (ctx->Rank() == root) {
+        EXPECT_EQ(reduced, expect);
+      } else {
+        EXPECT_TRUE(reduced.empty());
+      }
+
+      auto seg = ReduceScatter<T>(ctx, input, op, "test");
+      auto [begin, end] = ReduceScatterRange(num, world_size, ctx->Rank());
+      EXPECT_EQ(seg, std::vector<T>(expect.begin() + begin,
+                                    expect.begin() + end));
+    };
+
+    std::vector<std::future<void>> jobs(world_size);
+    for (size_t rank = 0; rank < world_size; rank++) {
+      jobs[rank] = std::async(proc, contexts[rank]);
+    }
+    for (size_t rank = 0; rank < world_size; rank++) {
+      jobs[rank].get();
+    }
+  }
+}
+
+TEST_P(ReduceTest, RingAddWorks) {
+  TestReduce<uint64_t>(GetParam().world_size, RingAdd<uint64_t>(), 0);
+  TestReduce<uint64_t>(GetParam().world_size, RingAdd<uint64_t>(40), 0);
+}
+
+TEST_P(ReduceTest, BitXorWorks) {
+  TestReduce<uint128_t>(GetParam().world_size, BitXor<uint128_t>(), 0);
+  TestReduce<uint64_t>(GetParam().world_size, BitXor<uint64_t>(), 0);
+}
+
+TEST_P(ReduceTest, FieldAddWorks) {
+  // mersenne prime 2^61 - 1 and a prime > 2^63.
+  for (uint64_t p : {(uint64_t{1} << 61) - 1, uint64_t{0xffffffffffffffc5}}) {
+    TestReduce<uint64_t>(GetParam().world_size, FieldAdd(p), p);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Works_Instances, ReduceTest,
+                         testing::Values(TestParams{2},  //
+                                         TestParams{3},  //
+                                         TestParams{5}   //
+                                         ));
+
+TEST(ReduceOpsTest, Avx2MatchesPlainLoop) {
+  if (!internal::ReduceAvx2Supported()) {
+    GTEST_SKIP() << "no AVX2";
+  }
+  std::mt19937_64 rng(0);
+  const uint64_t p = 0xffffffffffffffc5;
+  for (size_t n : {0, 1, 3, 4, 5, 8, 33}) {
+    std::vector<uint64_t> a(n);
+    std::vector<uint64_t> b(n);
+    for (size_t i = 0; i < n; i++) {
+      // hit both sides of p, with & without overflow.
+      a[i] = i % 3 == 0 ? p - 1 : rng() % p;
+      b[i] = i % 2 == 0 ? p - 1 - i : rng() % p;
+    }
+    std::vector<uint64_t> expect(n);
+    std::vector<uint64_t> got = a;
+    for (size_t i = 0; i < n; i++) {
+      uint64_t s = a[i] + b[i];
+      expect[i] = (s < b[i] || s >= p) ? s - p : s;
+    }
+    internal::FieldAddAvx2(got.data(), b.data(), n, p);
+    EXPECT_EQ(got, expect);
+
+    const uint64_t mask = (uint64_t{1} << 40) - 1;
+    got = a;
+    for (size_t i = 0; i < n; i++) {
+      expect[i] = (a[i] + b[i]) & mask;
+    }
+    internal::RingAdd64Avx2(got.data(), b.data(), n, mask);
+    EXPECT_EQ(got, expect);
+
+    std::vector<uint32_t> a32(a.begin(), a.end());
+    std::vector<uint32_t> b32(b.begin(), b.end());
+    std::vector<uint32_t> expect32(n);
+    for (size_t i = 0; i < n; i++) {
+      expect32[i] = a32[i] + b32[i];
+    }
+    internal::RingAdd32Avx2(a32.data(), b32.data(), n, ~uint32_t{0});
+    EXPECT_EQ(a32, expect32);
+
+    // odd byte sizes.
+    const size_t size = n * 8 + n % 7;
+    std::vector<uint8_t> x(size);
+    std::vector<uint8_t> y(size);
+    std::vector<uint8_t> expect8(size);
+    for (size_t i = 0; i < size; i++) {
+      x[i] = rng();
+      y[i] = rng();
+      expect8[i] = x[i] ^ y[i];
+    }
+    internal::XorAvx2(x.data(), y.data(), size);
+    EXPECT_EQ(x, expect8);
+  }
+}
+
+TEST(ReduceFailTest, ThrowExceptionIfSizeNotMatch) {
+  const size_t world_size = 2;
+  auto contexts = SetupWorld("SizeMissMatch", world_size);
+
+  auto proc = [&](const std::shared_ptr<Context>& ctx) {
+    std::vector<uint64_t> input(ctx->Rank() + 1);
+    return AllReduce<uint64_t>(ctx, input, RingAdd<uint64_t>(), "test");
+  };
+  auto job0 = std::async(proc, contexts[0]);
+  auto job1 = std::async(proc, contexts[1]);
+  EXPECT_THROW(job0.get(), ::yacl::EnforceNotMet);
+  EXPECT_THROW(job1.get(), ::yacl::EnforceNotMet);
+}
+
+}  // namespace yacl::link::test
@@ -14,19 +14,80 @@
 
 #include "yacl/link/algorithm/scatter.h"
 
+#include <algorithm>
+
+#include "absl/numeric/bits.h"
 #include "fmt/format.h"
 
 #include "yacl/base/exception.h"
 #include "yacl/link/trace.h"
+#include "yacl/utils/serialize.h"
 
 namespace yacl::link {
 namespace {
 const char* kType = "SCATTER";
+
+CollectiveAlgo SelectAlgo(const std::shared_ptr<Context>& ctx,
+                          CollectiveAlgo algo) {
+  if (algo != CollectiveAlgo::kAuto) {
+    YACL_ENFORCE(algo == CollectiveAlgo::kDirect ||
+                     algo == CollectiveAlgo::kBinomialTree,
+                 "unsupported scatter algo {}", static_cast<int>(algo));
+    return algo;
+  }
+  return ctx->WorldSize() <= kDirectMaxWorldSize
+             ? CollectiveAlgo::kDirect
+             : CollectiveAlgo::kBinomialTree;
+}
+
+Buffer ScatterTree(const std::shared_ptr<Context>& ctx,
+                   const std::string& event,
+                   const std::vector<ByteContainerView>& inputs, size_t root) {
+  // reverse of GatherTree, in virtual rank space (root as 0), blocks[i] is
+  // the block of vrank + i. vrank receives the blocks of its subtree
+  // [vrank, vrank + lowbit(vrank)) from vrank - lowbit(vrank), then sends
+  // [vrank + s, vrank + 2s) to vrank + s, for s from lowbit(vrank) / 2 to 1.
+  const size_t world_size = ctx->WorldSize();
+  const size_t vrank = (ctx->Rank() + world_size - root) % world_size;
+  std::vector<Buffer> received;
+  std::vector<ByteContainerView> blocks;
+  size_t stride = 0;
+  if (vrank == 0) {
+    for (size_t i = 0; i < world_size; i++) {
+      blocks.push_back(inputs[(root + i) % world_size]);
+    }
+    stride = world_size > 1 ? absl::bit_floor(world_size - 1) : 0;
+  } else {
+    const size_t lowbit = vrank & (~vrank + 1);
+    const size_t count = std::min(lowbit, world_size - vrank);
+    received = DeserializeArrayOfBuffers(ctx->RecvInternal(
+        ctx->PrevRank(lowbit), fmt::format("{}:{}", event, lowbit)));
+    YACL_ENFORCE(received.size() == count,
+                 "scatter expect {} blocks from rank {}, got {}", count,
+                 ctx->PrevRank(lowbit), received.size());
+    blocks.assign(received.begin(), received.end());
+    stride = lowbit >> 1;
+  }
+
+  for (; stride > 0; stride >>= 1) {
+    if (vrank + stride >= world_size) {
+      continue;
+    }
+    std::vector<ByteContainerView> sending(
+        blocks.begin() + stride,
+        blocks.begin() + std::min(2 * stride, blocks.size()));
+    ctx->SendAsyncInternal(ctx->NextRank(stride),
+                           fmt::format("{}:{}", event, stride),
+                           SerializeArrayOfBuffers(sending));
+  }
+  return Buffer(blocks[0]);
+}
+
 }  // namespace
 
 Buffer Scatter(const std::shared_ptr<Context>& ctx,
                const std::vector<ByteContainerView>& inputs, size_t root,
-               std::string_view tag) {
+               std::string_view tag, CollectiveAlgo algo) {
   const auto event = fmt::format("{}:{}", ctx->NextId(), kType);
 
   // TODO: record scatter inputs.
@@ -36,7 +97,13 @@ Buffer Scatter(const std::shared_ptr<Context>& ctx,
     YACL_ENFORCE(inputs.size() == ctx->WorldSize(),
                  "number of input={} does not match world_size={}",
                  inputs.size(), ctx->WorldSize());
+  }
+
+  if (SelectAlgo(ctx, algo) == CollectiveAlgo::kBinomialTree) {
+    return ScatterTree(ctx, event, inputs, root);
+  }
 
+  if (root == ctx->Rank()) {
     for (size_t idx = 0; idx < ctx->WorldSize(); idx++) {
       if (idx == ctx->Rank()) {
         continue;
@@ -15,12 +15,15 @@
 #pragma once
 
 #include "yacl/base/buffer.h"
+#include "yacl/link/algorithm/collective_algo.h"
 #include "yacl/link/context.h"
 
 namespace yacl::link {
 
+// algo: kDirect or kBinomialTree.
 Buffer Scatter(const std::shared_ptr<Context>& ctx,
                const std::vector<ByteContainerView>& inputs, size_t root,
-               std::string_view tag);
+               std::string_view tag,
+               CollectiveAlgo algo = CollectiveAlgo::kAuto);
 
 }  // namespace yacl::link
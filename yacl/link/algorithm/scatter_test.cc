@@ -62,9 +62,45 @@ TEST_P(ScatterTest, Works) {
   }
 }
 
+TEST_P(ScatterTest, AlgoWorks) {
+  const size_t world_size = GetParam().world_size;
+  auto contexts = SetupWorld(world_size);
+
+  auto proc = [&](const std::shared_ptr<Context>& ctx) {
+    for (auto algo :
+         {CollectiveAlgo::kDirect, CollectiveAlgo::kBinomialTree}) {
+      for (size_t round = 0; round < world_size; round++) {
+        // each round take a different party as root.
+        size_t root = round;
+        std::vector<std::string> inputs;
+        if (ctx->Rank() == root) {
+          for (size_t rank = 0; rank < world_size; rank++) {
+            inputs.push_back(MakeRoundData(rank, round));
+          }
+        }
+
+        auto data = Scatter(ctx, {inputs.begin(), inputs.end()}, root,
+                            "test_tag", algo);
+
+        EXPECT_EQ(data, yacl::Buffer(MakeRoundData(ctx->Rank(), round)));
+      }
+    }
+  };
+
+  std::vector<std::future<void>> jobs(world_size);
+  for (size_t rank = 0; rank < world_size; rank++) {
+    jobs[rank] = std::async(proc, contexts[rank]);
+  }
+
+  for (size_t rank = 0; rank < world_size; rank++) {
+    jobs[rank].get();
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(Works_Instances, ScatterTest,
                          testing::Values(TestParams{2},  //
                                          TestParams{3},  //
+                                         TestParams{6},  //
                                          TestParams{9}   //
                                          ));
 
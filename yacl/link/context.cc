@@ -63,6 +63,48 @@ void Context::PrintStats() { std::cout << *stats_; }
 
 std::shared_ptr<const Statistics> Context::GetStats() const { return stats_; }
 
+PeerStatsSnapshot Context::GetPeerStats(size_t peer_rank) const {
+  YACL_ENFORCE(peer_rank < channels_.size(), "rank={} out of range={}",
+               peer_rank, channels_.size());
+  if (channels_[peer_rank] == nullptr) {
+    return {};
+  }
+  return channels_[peer_rank]->GetPeerStats()->Snapshot();
+}
+
+std::vector<PeerStatsSnapshot> Context::GetAllPeerStats() const {
+  std::vector<PeerStatsSnapshot> ret(channels_.size());
+  for (size_t i = 0; i < channels_.size(); i++) {
+    ret[i] = GetPeerStats(i);
+  }
+  return ret;
+}
+
+void Context::DumpTimeline(const std::string& path) const {
+  timeline_->DumpChromeTrace(path, rank_);
+}
+
+void Context::OnSent(size_t dst_rank, const std::string& key, size_t bytes,
+                     Clock::time_point start) {
+  stats_->sent_actions++;
+  stats_->sent_bytes += bytes;
+  channels_[dst_rank]->GetPeerStats()->sent_msg_bytes.Record(bytes);
+
+  if (start != Clock::time_point()) {
+    const auto duration = Clock::now() - start;
+    const auto start_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            (std::chrono::system_clock::now() - duration).time_since_epoch())
+            .count();
+    auto tag = TraceLogger::CurrentTag();
+    timeline_->Add(
+        {tag.empty() ? key : std::string(tag), "send", key, dst_rank, bytes,
+         start_us,
+         std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+             .count()});
+  }
+}
+
 Context::Context(ContextDesc desc, size_t rank,
                  std::vector<std::shared_ptr<transport::IChannel>> channels,
                  std::shared_ptr<transport::IReceiverLoop> msg_loop,
@@ -88,6 +130,7 @@ Context::Context(ContextDesc desc, size_t rank,
   }
 
   stats_ = std::make_shared<Statistics>();
+  timeline_ = std::make_shared<Timeline>();
 }
 
 Context::Context(const ContextDescProto& desc_pb, size_t rank,
@@ -252,15 +295,23 @@ Buffer Context::Recv(size_t src_rank, std::string_view tag) {
   return RecvInternal(src_rank, event);
 }
 
+Future<Buffer> Context::RecvAsync(size_t src_rank, std::string_view tag) {
+  const auto event = NextP2PId(src_rank, rank_);
+
+  TraceLogger::LinkTrace(event, tag, "");
+
+  return RecvAsyncInternal(src_rank, event);
+}
+
 void Context::SendAsyncInternal(size_t dst_rank, const std::string& key,
                                 ByteContainerView value) {
   YACL_ENFORCE(dst_rank < static_cast<size_t>(channels_.size()),
                "rank={} out of range={}", dst_rank, channels_.size());
 
+  const auto start = SpanStart();
   channels_[dst_rank]->SendAsync(key, value);
 
-  stats_->sent_actions++;
-  stats_->sent_bytes += value.size();
+  OnSent(dst_rank, key, value.size(), start);
 }
 
 void Context::SendAsyncInternal(size_t dst_rank, const std::string& key,
@@ -270,10 +321,10 @@ void Context::SendAsyncInternal(size_t dst_rank, const std::string& key,
 
   const size_t value_length = value.size();
 
+  const auto start = SpanStart();
   channels_[dst_rank]->SendAsync(key, std::move(value));
 
-  stats_->sent_actions++;
-  stats_->sent_bytes += value_length;
+  OnSent(dst_rank, key, value_length, start);
 }
 
 void Context::SendAsyncThrottledInternal(size_t dst_rank,
@@ -282,10 +333,10 @@ void Context::SendAsyncThrottledInternal(size_t dst_rank,
   YACL_ENFORCE(dst_rank < static_cast<size_t>(channels_.size()),
                "rank={} out of range={}", dst_rank, channels_.size());
 
+  const auto start = SpanStart();
   channels_[dst_rank]->SendAsyncThrottled(key, value);
 
-  stats_->sent_actions++;
-  stats_->sent_bytes += value.size();
+  OnSent(dst_rank, key, value.size(), start);
 }
 
 void Context::SendAsyncThrottledInternal(size_t dst_rank,
@@ -296,10 +347,10 @@ void Context::SendAsyncThrottledInternal(size_t dst_rank,
 
   const size_t value_length = value.size();
 
+  const auto start = SpanStart();
   channels_[dst_rank]->SendAsyncThrottled(key, std::move(value));
 
-  stats_->sent_actions++;
-  stats_->sent_bytes += value_length;
+  OnSent(dst_rank, key, value_length, start);
 }
 
 void Context::SendInternal(size_t dst_rank, const std::string& key,
@@ -307,24 +358,62 @@ void Context::SendInternal(size_t dst_rank, const std::string& key,
   YACL_ENFORCE(dst_rank < static_cast<size_t>(channels_.size()),
                "rank={} out of range={}", dst_rank, channels_.size());
 
+  const auto start = SpanStart();
   channels_[dst_rank]->Send(key, value);
 
-  stats_->sent_actions++;
-  stats_->sent_bytes += value.size();
+  OnSent(dst_rank, key, value.size(), start);
 }
 
 Buffer Context::RecvInternal(size_t src_rank, const std::string& key) {
   YACL_ENFORCE(src_rank < static_cast<size_t>(channels_.size()),
                "rank={} out of range={}", src_rank, channels_.size());
 
+  const auto start = Clock::now();
   auto value = channels_[src_rank]->Recv(key);
+  const auto wait = Clock::now() - start;
 
   stats_->recv_actions++;
   stats_->recv_bytes += value.size();
 
+  auto& peer_stats = *channels_[src_rank]->GetPeerStats();
+  peer_stats.recv_msg_bytes.Record(value.size());
+  peer_stats.recv_wait_ns.Record(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count());
+
+  if (timeline_->Enabled()) {
+    const auto start_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            (std::chrono::system_clock::now() - wait).time_since_epoch())
+            .count();
+    auto tag = TraceLogger::CurrentTag();
+    timeline_->Add(
+        {tag.empty() ? key : std::string(tag), "recv", key, src_rank,
+         static_cast<size_t>(value.size()), start_us,
+         std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count()});
+  }
+
   return value;
 }
 
+Future<Buffer> Context::RecvAsyncInternal(size_t src_rank,
+                                          const std::string& key) {
+  YACL_ENFORCE(src_rank < static_cast<size_t>(channels_.size()),
+               "rank={} out of range={}", src_rank, channels_.size());
+
+  Future<Buffer> future;
+  // nobody waits, so no recv_wait_ns.
+  channels_[src_rank]->RecvAsync(
+      key, [future, stats = stats_,
+            peer_stats = channels_[src_rank]->GetPeerStats()](
+               Buffer&& value) mutable {
+        stats->recv_actions++;
+        stats->recv_bytes += value.size();
+        peer_stats->recv_msg_bytes.Record(value.size());
+        future.SetValue(std::move(value));
+      });
+  return future;
+}
+
 std::unique_ptr<Context> Context::Spawn(const std::string& id) {
   ContextDesc sub_desc = desc_;
   if (id.empty()) {
@@ -339,6 +428,7 @@ std::unique_ptr<Context> Context::Spawn(const std::string& id) {
 
   // share statistics with parent.
   sub_ctx->stats_ = this->stats_;
+  sub_ctx->timeline_ = this->timeline_;
 
   return sub_ctx;
 }
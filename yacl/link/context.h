@@ -17,6 +17,7 @@
 #include <spdlog/common.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <limits>
 #include <map>
@@ -24,8 +25,11 @@
 #include <vector>
 
 #include "yacl/base/byte_container_view.h"
+#include "yacl/link/emulation_options.h"
+#include "yacl/link/future.h"
 #include "yacl/link/retry_options.h"
 #include "yacl/link/ssl_options.h"
+#include "yacl/link/stats.h"
 #include "yacl/link/transport/channel.h"
 #include "yacl/utils/hash_combine.h"
 
@@ -142,6 +146,22 @@ struct ContextDesc {
 
   bool disable_msg_seq_id = false;
 
+  // network emulation of mem link, see EmulationOptions.
+  EmulationOptions mem_emulation;
+
+  // brpc link only, chunks of large message are striped across up to
+  // brpc_stripe_connections tcp connections to each peer, 1 means one
+  // connection. if brpc_stripe_adaptive, the number of connections in use is
+  // tuned by measured throughput.
+  uint32_t brpc_stripe_connections = 1;
+  bool brpc_stripe_adaptive = true;
+
+  // brpc links only, async msgs no larger than coalesce_max_msg_bytes are
+  // packed into one request, waiting at most coalesce_window_us for more
+  // msgs. 0 coalesce_max_msg_bytes disables coalescing.
+  uint32_t coalesce_max_msg_bytes = 0;
+  uint32_t coalesce_window_us = 50;
+
   bool operator==(const ContextDesc& other) const {
     return (id == other.id) && (parties == other.parties);
   }
@@ -199,6 +219,15 @@ struct ContextDescHasher {
                         desc.throttle_window_size, desc.brpc_channel_protocol,
                         desc.brpc_channel_connection_type, desc.link_type);
 
+    utils::hash_combine(seed, desc.mem_emulation.bandwidth_bps,
+                        desc.mem_emulation.burst_bytes,
+                        desc.mem_emulation.latency_us,
+                        desc.mem_emulation.jitter_us, desc.mem_emulation.seed);
+
+    utils::hash_combine(seed, desc.brpc_stripe_connections,
+                        desc.brpc_stripe_adaptive, desc.coalesce_max_msg_bytes,
+                        desc.coalesce_window_us);
+
     return seed;
   }
 };
@@ -260,6 +289,19 @@ class Context {
 
   Buffer Recv(size_t src_rank, std::string_view tag);
 
+  // non-blocking Recv, the future is resolved once message arrives. pair
+  // with Future::Then & EventLoop to drive many concurrent protocol
+  // instances by one thread, e.g.
+  //
+  //   EventLoop loop;
+  //   for (auto& bucket : buckets) {
+  //     ctx->RecvAsync(peer, "bucket").Then(&loop, [&](Buffer&& msg) {...});
+  //   }
+  //   loop.Run(ctx->GetRecvTimeout());
+  //
+  // like Recv, call it in order in the thread using this context.
+  Future<Buffer> RecvAsync(size_t src_rank, std::string_view tag);
+
   // Connect to mesh, you can also set the connect log level to any
   // spdlog::level
   void ConnectToMesh(
@@ -298,6 +340,7 @@ class Context {
   void SendInternal(size_t dst_rank, const std::string& key,
                     ByteContainerView value);
   Buffer RecvInternal(size_t src_rank, const std::string& key);
+  Future<Buffer> RecvAsyncInternal(size_t src_rank, const std::string& key);
 
   // next collective algorithm id.
   std::string NextId();
@@ -316,8 +359,34 @@ class Context {
   // get statistics
   std::shared_ptr<const Statistics> GetStats() const;
 
+  // histograms of messages exchanged with peer, see link/stats.h. shared by
+  // all contexts using the same channel. empty for self rank.
+  PeerStatsSnapshot GetPeerStats(size_t peer_rank) const;
+
+  // indexed by rank.
+  std::vector<PeerStatsSnapshot> GetAllPeerStats() const;
+
+  // message timeline, disabled by default, shared with spawned contexts.
+  // e.g.
+  //   ctx->GetTimeline()->Enable();
+  //   ...
+  //   ctx->DumpTimeline("rank0.trace.json");
+  std::shared_ptr<Timeline> GetTimeline() const { return timeline_; }
+
+  // dump timeline as Chrome trace JSON.
+  void DumpTimeline(const std::string& path) const;
+
  protected:
   using P2PDirection = std::pair<int, int>;
+  using Clock = std::chrono::steady_clock;
+
+  // start time of a send action if timeline is enabled.
+  Clock::time_point SpanStart() const {
+    return timeline_->Enabled() ? Clock::now() : Clock::time_point();
+  }
+
+  void OnSent(size_t dst_rank, const std::string& key, size_t bytes,
+              Clock::time_point start);
 
   const ContextDesc desc_;  // world description.
   const size_t rank_;       // my rank.
@@ -334,6 +403,9 @@ class Context {
   // sub-context will shared statistics with parent
   std::shared_ptr<Statistics> stats_;
 
+  // sub-context will shared timeline with parent
+  std::shared_ptr<Timeline> timeline_;
+
   const bool is_sub_world_;
 };
 
@@ -148,6 +148,21 @@ TEST_F(ContextConnectToMeshTest, SetRecvTimeoutShouldOk) {
   EXPECT_EQ(ctx->GetRecvTimeout(), 4800000000);
 }
 
+TEST_F(ContextConnectToMeshTest, RecvAsyncThrowIfNotSupported) {
+  // GIVEN
+  auto msg_loop = std::make_shared<transport::ReceiverLoopMem>();
+  ContextDesc ctx_desc;
+  for (size_t rank = 0; rank < world_size_; rank++) {
+    const auto id = fmt::format("id-{}", rank);
+    const auto host = fmt::format("host-{}", rank);
+    ctx_desc.parties.push_back({id, host});
+  }
+  Context ctx(ctx_desc, self_rank_, channels_, msg_loop);
+
+  // WHEN THEN
+  EXPECT_THROW(ctx.RecvAsync(0, "tag"), ::yacl::RuntimeError);
+}
+
 class ContextTest : public ::testing::Test {
  public:
   void SetUp() override {
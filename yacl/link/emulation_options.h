@@ -0,0 +1,65 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace yacl::link {
+
+// Network emulation for mem link (FactoryMem), ignored by other links.
+//
+// Each direction of a peer pair is emulated independently (full duplex):
+//  - bandwidth: token bucket, a message departs once the bucket has tokens for
+//    all its bytes, i.e. messages are serialized at bandwidth_bps after an
+//    allowed burst of burst_bytes.
+//  - latency: one way delay added to every message after departure.
+//  - jitter: extra delay uniformly drawn from [0, jitter_us], messages of a
+//    direction are still delivered in order, as if sent over tcp.
+//
+// Async sends return immediately, sync Send returns when the message is
+// delivered.
+struct EmulationOptions {
+  // bits per second of each direction, 0 for unlimited.
+  uint64_t bandwidth_bps = 0;
+  // token bucket depth, 0 for strict pacing.
+  uint64_t burst_bytes = 0;
+  // one way latency, i.e. half of round trip time.
+  uint32_t latency_us = 0;
+  uint32_t jitter_us = 0;
+  // seed of jitter, combined with ranks of the direction.
+  uint64_t seed = 0;
+
+  bool Enabled() const {
+    return bandwidth_bps != 0 || latency_us != 0 || jitter_us != 0;
+  }
+
+  // 10 Gbps, 0.1 ms RTT.
+  static EmulationOptions Lan() {
+    EmulationOptions ret;
+    ret.bandwidth_bps = 10'000'000'000ULL;
+    ret.latency_us = 50;
+    return ret;
+  }
+
+  // 100 Mbps, 80 ms RTT.
+  static EmulationOptions Wan() {
+    EmulationOptions ret;
+    ret.bandwidth_bps = 100'000'000ULL;
+    ret.latency_us = 40'000;
+    return ret;
+  }
+};
+
+}  // namespace yacl::link
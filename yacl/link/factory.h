@@ -15,6 +15,7 @@
 #pragma once
 
 #include "yacl/link/context.h"
+#include "yacl/link/transport/channel_shm.h"
 
 namespace yacl::link {
 
@@ -34,6 +35,20 @@ class FactoryMem : public ILinkFactory {
                                          size_t self_rank) override;
 };
 
+/// link context of parties on the same host, through shared memory rings.
+/// party hosts are not used, parties should ConnectToMesh as brpc link.
+class FactoryShm : public ILinkFactory {
+ public:
+  explicit FactoryShm(const transport::ShmOptions& options = {})
+      : options_(options) {}
+
+  std::shared_ptr<Context> CreateContext(const ContextDesc& desc,
+                                         size_t self_rank) override;
+
+ private:
+  transport::ShmOptions options_;
+};
+
 /// builtin link context type, brpc base link context.
 class FactoryBrpc : public ILinkFactory {
  public:
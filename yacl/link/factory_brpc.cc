@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 
 #include "absl/strings/match.h"
@@ -59,6 +60,8 @@ std::shared_ptr<Context> FactoryBrpc::CreateContext(const ContextDesc& desc,
 
     auto delegate =
         std::make_shared<transport::BrpcLink>(self_rank, rank, opts);
+    delegate->SetStripe(desc.brpc_stripe_connections,
+                        desc.brpc_stripe_adaptive);
     delegate->SetPeerHost(desc.parties[rank].host,
                           desc.enable_ssl ? &desc.client_ssl_opts : nullptr);
 
@@ -66,6 +69,10 @@ std::shared_ptr<Context> FactoryBrpc::CreateContext(const ContextDesc& desc,
         delegate, desc.recv_timeout_ms, desc.exit_if_async_error,
         desc.retry_opts);
     channel->SetThrottleWindowSize(desc.throttle_window_size);
+    channel->SetCoalesce(desc.coalesce_max_msg_bytes, desc.coalesce_window_us);
+    // keep enough chunks in flight to fill every striped connection.
+    channel->SetChunkParallelSendSize(std::max<size_t>(
+        desc.chunk_parallel_send_size, desc.brpc_stripe_connections));
     channel->SetDisableMsgSeqId(desc.disable_msg_seq_id);
     msg_loop->AddListener(rank, channel);
     channels[rank] = std::move(channel);
@@ -105,6 +105,7 @@ std::shared_ptr<Context> FactoryBrpcBlackBox::CreateContext(
     auto channel = std::make_shared<transport::Channel>(
         delegate, desc.recv_timeout_ms, false, desc.retry_opts);
     channel->SetThrottleWindowSize(desc.throttle_window_size);
+    channel->SetCoalesce(desc.coalesce_max_msg_bytes, desc.coalesce_window_us);
     msg_loop->AddLinkAndChannel(rank, channel, delegate);
 
     channels[rank] = std::move(channel);
@@ -64,6 +64,7 @@ std::shared_ptr<MemSession> CreateSession(const ContextDesc& desc) {
         }
         all_channels[self_rank][peer_rank]->SetPeer(
             all_channels[peer_rank][self_rank]);
+        all_channels[self_rank][peer_rank]->SetEmulation(desc.mem_emulation);
       }
     }
   }
@@ -0,0 +1,56 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fmt/format.h"
+
+#include "yacl/base/exception.h"
+#include "yacl/link/factory.h"
+#include "yacl/link/transport/channel_shm.h"
+#include "yacl/utils/hash_combine.h"
+
+namespace yacl::link {
+
+std::shared_ptr<Context> FactoryShm::CreateContext(const ContextDesc& desc,
+                                                   size_t self_rank) {
+  const size_t world_size = desc.parties.size();
+  if (self_rank >= world_size) {
+    YACL_THROW_LOGIC_ERROR("invalid self rank={}, world_size={}", self_rank,
+                           world_size);
+  }
+
+  // all parties derive the same session name from desc.
+  size_t seed = 0;
+  utils::hash_combine(seed, desc.id);
+  for (const auto& p : desc.parties) {
+    utils::hash_combine(seed, p.id, p.host);
+  }
+  const auto session = fmt::format("/yacl-{:016x}", seed);
+
+  auto msg_loop = std::make_unique<transport::ReceiverLoopShm>();
+  std::vector<std::shared_ptr<transport::IChannel>> channels(world_size);
+  for (size_t rank = 0; rank < world_size; rank++) {
+    if (rank == self_rank) {
+      continue;
+    }
+    auto channel = std::make_shared<transport::ChannelShm>(
+        session, self_rank, rank, options_, desc.recv_timeout_ms);
+    msg_loop->AddChannel(channel);
+    channels[rank] = std::move(channel);
+  }
+
+  return std::make_shared<Context>(desc, self_rank, std::move(channels),
+                                   std::move(msg_loop));
+}
+
+}  // namespace yacl::link
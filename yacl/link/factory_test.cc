@@ -66,7 +66,7 @@ class FactoryTest : public ::testing::Test {
   std::vector<std::shared_ptr<Context>> contexts_;
 };
 
-using FactoryTestTypes = ::testing::Types<FactoryMem, FactoryBrpc>;
+using FactoryTestTypes = ::testing::Types<FactoryMem, FactoryBrpc, FactoryShm>;
 TYPED_TEST_SUITE(FactoryTest, FactoryTestTypes);
 
 TYPED_TEST(FactoryTest, SendAsync) {
@@ -0,0 +1,83 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/future.h"
+
+namespace yacl::link {
+
+EventLoop::EventLoop() : core_(std::make_shared<Core>()) {}
+
+EventLoop::~EventLoop() {
+  std::deque<std::function<void()>> tasks;
+  {
+    std::unique_lock<std::mutex> lock(core_->mutex);
+    tasks.swap(core_->tasks);
+  }
+  // tasks are released out of lock, they may own other futures' states.
+}
+
+void EventLoop::Post(std::function<void()> task) {
+  {
+    std::unique_lock<std::mutex> lock(core_->mutex);
+    core_->tasks.push_back(std::move(task));
+  }
+  core_->cond.notify_all();
+}
+
+EventLoop::Poster EventLoop::Hold() {
+  {
+    std::unique_lock<std::mutex> lock(core_->mutex);
+    core_->waiting++;
+  }
+  return [weak = std::weak_ptr<Core>(core_)](std::function<void()> task) {
+    auto core = weak.lock();
+    if (core == nullptr) {
+      return;
+    }
+    {
+      std::unique_lock<std::mutex> lock(core->mutex);
+      core->waiting--;
+      core->tasks.push_back(std::move(task));
+    }
+    core->cond.notify_all();
+  };
+}
+
+size_t EventLoop::Waiting() const {
+  std::unique_lock<std::mutex> lock(core_->mutex);
+  return core_->waiting;
+}
+
+void EventLoop::Run(uint64_t timeout_ms) {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(core_->mutex);
+      if (!core_->cond.wait_for(
+              lock, std::chrono::milliseconds(timeout_ms),
+              [&] { return !core_->tasks.empty() || core_->waiting == 0; })) {
+        YACL_THROW_IO_ERROR("event loop wait timeout, {} continuations waiting",
+                            core_->waiting);
+      }
+      if (core_->tasks.empty()) {
+        return;
+      }
+      task = std::move(core_->tasks.front());
+      core_->tasks.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace yacl::link
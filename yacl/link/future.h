@@ -0,0 +1,216 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "yacl/base/exception.h"
+
+namespace yacl::link {
+
+// A single thread event loop, continuations registered by Future::Then are
+// run by Run in the calling thread, so one thread can drive many concurrent
+// protocol instances (each as a chain of continuations) on one Context.
+//
+// Post is thread safe, Run should be called by one thread.
+class EventLoop {
+ public:
+  // queues a continuation's task once its future is ready, see Hold.
+  using Poster = std::function<void(std::function<void()>)>;
+
+  EventLoop();
+  ~EventLoop();
+
+  EventLoop(const EventLoop&) = delete;
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  // queue task to be run by Run.
+  void Post(std::function<void()> task);
+
+  // run queued tasks until no continuation is waiting, tasks may register
+  // new continuations. throw IoError if no task becomes runnable within
+  // timeout_ms. exceptions from tasks are thrown to caller.
+  void Run(uint64_t timeout_ms);
+
+  // number of continuations waiting for their futures.
+  size_t Waiting() const;
+
+  // for Future::Then, register a waiting continuation. the returned poster
+  // may be called by any thread, at most once, even after the loop is
+  // destroyed (e.g. Run timed out and a late message resolves the future),
+  // then the task is dropped. it never throws.
+  Poster Hold();
+
+ private:
+  // shared with posters, so late ones never touch a destroyed loop.
+  struct Core {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<std::function<void()>> tasks;
+    size_t waiting = 0;
+  };
+
+  std::shared_ptr<Core> core_;
+};
+
+// A Future is a value resolved once by a producer, e.g. Context::RecvAsync
+// resolves by message arrival. copies share the same value, which is
+// consumed (moved out) by Get or Then, so consume it only once.
+template <typename T>
+class Future {
+ public:
+  Future() : state_(std::make_shared<State>()) {}
+
+  // resolve future, called once by producer.
+  void SetValue(T&& value) {
+    std::vector<std::function<void()>> listeners;
+    {
+      std::unique_lock<std::mutex> lock(state_->mutex);
+      YACL_ENFORCE(!state_->ready, "future is already resolved");
+      state_->value = std::move(value);
+      state_->ready = true;
+      listeners.swap(state_->listeners);
+    }
+    state_->cond.notify_all();
+    for (auto& listener : listeners) {
+      listener();
+    }
+  }
+
+  bool Ready() const {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return state_->ready;
+  }
+
+  // block until resolved, throw IoError after timeout_ms.
+  T Get(uint64_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    if (!state_->cond.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                               [&] { return state_->ready; })) {
+      YACL_THROW_IO_ERROR("future wait timeout, timeout_ms={}", timeout_ms);
+    }
+    return TakeValue();
+  }
+
+  // run fn(value) by loop once resolved.
+  void Then(EventLoop* loop, std::function<void(T&&)> fn) {
+    YACL_ENFORCE(loop != nullptr, "event loop should not be null");
+    OnReady([state = state_, post = loop->Hold(),
+             fn = std::move(fn)]() mutable {
+      post([state = std::move(state), fn = std::move(fn)]() {
+        fn(Future(state).TakeValue());
+      });
+    });
+  }
+
+  // call listener once resolved, in place if already resolved, otherwise by
+  // the resolving thread. listener should be short and not block.
+  void OnReady(std::function<void()> listener) const {
+    {
+      std::unique_lock<std::mutex> lock(state_->mutex);
+      if (!state_->ready) {
+        state_->listeners.push_back(std::move(listener));
+        return;
+      }
+    }
+    listener();
+  }
+
+ private:
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool ready = false;
+    std::optional<T> value;
+    std::vector<std::function<void()>> listeners;
+  };
+
+  explicit Future(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+  T TakeValue() {
+    YACL_ENFORCE(state_->value.has_value(), "future value is consumed");
+    T value = std::move(*state_->value);
+    state_->value.reset();
+    return value;
+  }
+
+  std::shared_ptr<State> state_;
+};
+
+// resolved by all values once all futures are resolved, values are in order
+// of futures.
+template <typename T>
+Future<std::vector<T>> WhenAll(std::vector<Future<T>> futures) {
+  struct AllState {
+    std::mutex mutex;
+    std::vector<Future<T>> futures;
+    size_t remaining;
+    Future<std::vector<T>> result;
+  };
+  auto ctx = std::make_shared<AllState>();
+  ctx->futures = std::move(futures);
+  ctx->remaining = ctx->futures.size();
+  auto result = ctx->result;
+  if (ctx->futures.empty()) {
+    result.SetValue({});
+    return result;
+  }
+  for (size_t i = 0; i < ctx->futures.size(); i++) {
+    ctx->futures[i].OnReady([ctx] {
+      {
+        std::unique_lock<std::mutex> lock(ctx->mutex);
+        if (--ctx->remaining != 0) {
+          return;
+        }
+      }
+      std::vector<T> values;
+      values.reserve(ctx->futures.size());
+      for (auto& future : ctx->futures) {
+        values.push_back(future.Get(0));
+      }
+      ctx->result.SetValue(std::move(values));
+    });
+  }
+  return result;
+}
+
+// resolved by index of the first resolved future, values of futures are not
+// consumed, so get the winner's (and others') by Get.
+template <typename T>
+Future<size_t> WhenAny(const std::vector<Future<T>>& futures) {
+  YACL_ENFORCE(!futures.empty(), "WhenAny of no future");
+  auto fired = std::make_shared<std::atomic<bool>>(false);
+  Future<size_t> result;
+  for (size_t i = 0; i < futures.size(); i++) {
+    futures[i].OnReady([fired, result, i]() mutable {
+      if (!fired->exchange(true)) {
+        result.SetValue(size_t{i});
+      }
+    });
+  }
+  return result;
+}
+
+}  // namespace yacl::link
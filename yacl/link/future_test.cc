@@ -0,0 +1,137 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/future.h"
+
+#include <algorithm>
+#include <future>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "yacl/link/test_util.h"
+
+namespace yacl::link::test {
+
+TEST(FutureTest, GetAndThen) {
+  Future<int> f;
+  EXPECT_FALSE(f.Ready());
+  EXPECT_THROW(f.Get(1), IoError);
+
+  auto t = std::thread([f]() mutable { f.SetValue(42); });
+  EXPECT_EQ(f.Get(10 * 1000), 42);
+  t.join();
+
+  EventLoop loop;
+  Future<int> g;
+  int got = 0;
+  g.Then(&loop, [&](int&& v) { got = v; });
+  EXPECT_EQ(loop.Waiting(), 1);
+  EXPECT_THROW(loop.Run(1), IoError);
+  g.SetValue(7);
+  loop.Run(1000);
+  EXPECT_EQ(got, 7);
+  EXPECT_EQ(loop.Waiting(), 0);
+}
+
+TEST(FutureTest, ResolvedAfterLoopGone) {
+  Future<int> f;
+  bool called = false;
+  {
+    EventLoop loop;
+    f.Then(&loop, [&](int&&) { called = true; });
+    EXPECT_THROW(loop.Run(1), IoError);
+  }
+  // e.g. a late message, the continuation is dropped with its loop.
+  auto t = std::thread([f]() mutable { f.SetValue(1); });
+  t.join();
+  EXPECT_FALSE(called);
+
+  // or the loop is still there, run it again.
+  EventLoop loop;
+  Future<int> g;
+  g.Then(&loop, [&](int&&) { called = true; });
+  EXPECT_THROW(loop.Run(1), IoError);
+  g.SetValue(2);
+  loop.Run(1000);
+  EXPECT_TRUE(called);
+}
+
+TEST(FutureTest, WhenAllWhenAny) {
+  std::vector<Future<int>> fs(3);
+  auto all = WhenAll(fs);
+  auto any = WhenAny(fs);
+  EXPECT_FALSE(any.Ready());
+
+  fs[1].SetValue(1);
+  EXPECT_EQ(any.Get(0), 1);
+  EXPECT_FALSE(all.Ready());
+
+  fs[2].SetValue(2);
+  fs[0].SetValue(0);
+  EXPECT_EQ(all.Get(0), std::vector<int>({0, 1, 2}));
+
+  EXPECT_TRUE(WhenAll(std::vector<Future<int>>()).Ready());
+}
+
+TEST(RecvAsyncTest, ManyInstancesOneThread) {
+  const size_t world_size = 2;
+  const size_t n = 200;
+  auto ctxs = SetupWorld("recv_async", world_size);
+
+  // instance i: rank 0 sends i, rank 1 replies i * 2 on arrival.
+  auto server = [&] {
+    auto& ctx = ctxs[1];
+    EventLoop loop;
+    for (size_t i = 0; i < n; i++) {
+      ctx->RecvAsync(0, "req").Then(&loop, [&](Buffer&& msg) {
+        auto v = std::stoul(std::string(msg.data<char>(), msg.size()));
+        ctx->SendAsync(0, std::to_string(v * 2), "rsp");
+      });
+    }
+    loop.Run(ctx->GetRecvTimeout());
+  };
+  auto client = [&] {
+    auto& ctx = ctxs[0];
+    std::vector<Future<Buffer>> rsps;
+    for (size_t i = 0; i < n; i++) {
+      rsps.push_back(ctx->RecvAsync(1, "rsp"));
+    }
+    for (size_t i = 0; i < n; i++) {
+      ctx->SendAsync(1, std::to_string(i), "req");
+    }
+    std::vector<size_t> got;
+    for (auto& rsp : WhenAll(rsps).Get(ctx->GetRecvTimeout())) {
+      got.push_back(std::stoul(std::string(rsp.data<char>(), rsp.size())));
+    }
+    return got;
+  };
+
+  auto f = std::async(server);
+  auto got = client();
+  f.get();
+
+  std::sort(got.begin(), got.end());
+  ASSERT_EQ(got.size(), n);
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_EQ(got[i], i * 2);
+  }
+
+  auto fin = std::async([&] { ctxs[0]->WaitLinkTaskFinish(); });
+  ctxs[1]->WaitLinkTaskFinish();
+  fin.get();
+}
+
+}  // namespace yacl::link::test
@@ -18,6 +18,7 @@
 #include "yacl/link/algorithm/barrier.h"
 #include "yacl/link/algorithm/broadcast.h"
 #include "yacl/link/algorithm/gather.h"
+#include "yacl/link/algorithm/reduce.h"
 #include "yacl/link/algorithm/scatter.h"
 #include "yacl/link/context.h"
 #include "yacl/link/factory.h"
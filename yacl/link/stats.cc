@@ -0,0 +1,211 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "fmt/format.h"
+
+#include "yacl/base/exception.h"
+
+namespace yacl::link {
+
+namespace {
+
+void AppendJsonString(std::string* out, std::string_view str) {
+  out->push_back('"');
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        out->append("\\\"");
+        break;
+      case '\\':
+        out->append("\\\\");
+        break;
+      case '\n':
+        out->append("\\n");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out->append(fmt::format("\\u{:04x}", c));
+        } else {
+          out->push_back(c);
+        }
+    }
+  }
+  out->push_back('"');
+}
+
+}  // namespace
+
+uint64_t HistogramSnapshot::Percentile(double q) const {
+  if (count == 0) {
+    return 0;
+  }
+  const auto target = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count)));
+  uint64_t acc = 0;
+  for (size_t i = 0; i < buckets.size(); i++) {
+    acc += buckets[i];
+    if (acc >= target) {
+      if (i == 0) {
+        return 0;
+      }
+      const uint64_t upper = i >= 64 ? max : (uint64_t(1) << i) - 1;
+      return std::min(upper, max);
+    }
+  }
+  return max;
+}
+
+HistogramSnapshot Histogram::Snapshot() const {
+  HistogramSnapshot ret;
+  ret.buckets.resize(kNumBuckets);
+  for (size_t i = 0; i < kNumBuckets; i++) {
+    ret.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    ret.count += ret.buckets[i];
+  }
+  ret.sum = sum_.load(std::memory_order_relaxed);
+  ret.max = max_.load(std::memory_order_relaxed);
+  // trim empty high buckets.
+  while (!ret.buckets.empty() && ret.buckets.back() == 0) {
+    ret.buckets.pop_back();
+  }
+  return ret;
+}
+
+void Histogram::Reset() {
+  for (auto& b : buckets_) {
+    b.store(0, std::memory_order_relaxed);
+  }
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+PeerStatsSnapshot PeerStats::Snapshot() const {
+  PeerStatsSnapshot ret;
+  ret.send_latency_ns = send_latency_ns.Snapshot();
+  ret.recv_wait_ns = recv_wait_ns.Snapshot();
+  ret.sent_msg_bytes = sent_msg_bytes.Snapshot();
+  ret.recv_msg_bytes = recv_msg_bytes.Snapshot();
+  ret.throttle_wait_ns = throttle_wait_ns.Snapshot();
+  ret.send_retries = send_retries.Snapshot();
+  return ret;
+}
+
+void PeerStats::Reset() {
+  send_latency_ns.Reset();
+  recv_wait_ns.Reset();
+  sent_msg_bytes.Reset();
+  recv_msg_bytes.Reset();
+  throttle_wait_ns.Reset();
+  send_retries.Reset();
+}
+
+std::ostream& operator<<(std::ostream& os, const HistogramSnapshot& h) {
+  os << "count=" << h.count << ",mean=" << h.Mean()
+     << ",p50=" << h.Percentile(0.5) << ",p99=" << h.Percentile(0.99)
+     << ",max=" << h.max;
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const PeerStatsSnapshot& st) {
+  os << "send_latency_ns{" << st.send_latency_ns << "}"     //
+     << ",recv_wait_ns{" << st.recv_wait_ns << "}"          //
+     << ",sent_msg_bytes{" << st.sent_msg_bytes << "}"      //
+     << ",recv_msg_bytes{" << st.recv_msg_bytes << "}"      //
+     << ",throttle_wait_ns{" << st.throttle_wait_ns << "}"  //
+     << ",send_retries{" << st.send_retries << "}" << std::endl;
+  return os;
+}
+
+void Timeline::Enable(size_t max_spans) {
+  std::unique_lock lock(mutex_);
+  max_spans_ = max_spans;
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Timeline::Add(TimelineSpan span) {
+  std::unique_lock lock(mutex_);
+  if (spans_.size() >= max_spans_) {
+    dropped_++;
+    return;
+  }
+  spans_.push_back(std::move(span));
+}
+
+std::vector<TimelineSpan> Timeline::Spans() const {
+  std::unique_lock lock(mutex_);
+  return spans_;
+}
+
+size_t Timeline::Dropped() const {
+  std::unique_lock lock(mutex_);
+  return dropped_;
+}
+
+void Timeline::Clear() {
+  std::unique_lock lock(mutex_);
+  spans_.clear();
+  dropped_ = 0;
+}
+
+std::string Timeline::ToChromeTrace(size_t self_rank) const {
+  auto spans = Spans();
+  std::vector<size_t> peers;
+  for (const auto& span : spans) {
+    peers.push_back(span.peer);
+  }
+  std::sort(peers.begin(), peers.end());
+  peers.erase(std::unique(peers.begin(), peers.end()), peers.end());
+
+  std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  out += fmt::format(
+      "{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{},"
+      "\"args\":{{\"name\":\"rank {}\"}}}}",
+      self_rank, self_rank);
+  for (size_t peer : peers) {
+    out += fmt::format(
+        ",{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+        "\"args\":{{\"name\":\"peer {}\"}}}}",
+        self_rank, peer, peer);
+  }
+  for (const auto& span : spans) {
+    out += ",{\"name\":";
+    AppendJsonString(&out, span.name);
+    out += fmt::format(
+        ",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{},\"dur\":{:.3f},\"pid\":{},"
+        "\"tid\":{},\"args\":{{\"bytes\":{},\"key\":",
+        span.category, span.start_us, span.duration_ns / 1000.0, self_rank,
+        span.peer, span.bytes);
+    AppendJsonString(&out, span.key);
+    out += "}}";
+  }
+  out += "]}";
+  return out;
+}
+
+void Timeline::DumpChromeTrace(const std::string& path,
+                               size_t self_rank) const {
+  std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+  YACL_ENFORCE(ofs.is_open(), "open timeline file {} failed", path);
+  ofs << ToChromeTrace(self_rank);
+  ofs.close();
+  YACL_ENFORCE(!ofs.fail(), "write timeline file {} failed", path);
+}
+
+}  // namespace yacl::link
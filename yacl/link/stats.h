@@ -0,0 +1,153 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace yacl::link {
+
+struct HistogramSnapshot {
+  uint64_t count = 0;
+  uint64_t sum = 0;
+  uint64_t max = 0;
+  // buckets[0] counts 0, buckets[i] counts values in [2^(i-1), 2^i).
+  std::vector<uint64_t> buckets;
+
+  double Mean() const { return count == 0 ? 0 : double(sum) / count; }
+
+  // upper bound of the bucket holding the q-quantile (q in [0, 1]), clamped
+  // to max, i.e. within 2x of the exact quantile.
+  uint64_t Percentile(double q) const;
+};
+
+// Lock free log2-bucketed histogram, Record costs a few relaxed atomic adds
+// so it is cheap enough to stay on in production.
+class Histogram {
+ public:
+  static constexpr size_t kNumBuckets = 65;
+
+  static size_t BucketIndex(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+  }
+
+  void Record(uint64_t value) {
+    buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t prev = max_.load(std::memory_order_relaxed);
+    while (prev < value && !max_.compare_exchange_weak(
+                               prev, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  HistogramSnapshot Snapshot() const;
+
+  void Reset();
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  std::atomic<uint64_t> sum_ = 0;
+  std::atomic<uint64_t> max_ = 0;
+};
+
+struct PeerStatsSnapshot {
+  HistogramSnapshot send_latency_ns;
+  HistogramSnapshot recv_wait_ns;
+  HistogramSnapshot sent_msg_bytes;
+  HistogramSnapshot recv_msg_bytes;
+  HistogramSnapshot throttle_wait_ns;
+  HistogramSnapshot send_retries;
+};
+
+// Statistics of the messages between self and one peer, owned by the channel
+// so that it is shared by all contexts (Spawn) using the channel.
+struct PeerStats {
+  // from message submitted to transport finished sending it (brpc: peer
+  // responded), in nanoseconds.
+  Histogram send_latency_ns;
+
+  // time blocked in Recv waiting for the message, in nanoseconds.
+  Histogram recv_wait_ns;
+
+  // message sizes in bytes, excluding key.
+  Histogram sent_msg_bytes;
+  Histogram recv_msg_bytes;
+
+  // time blocked by a full throttle window, only stalls are recorded.
+  Histogram throttle_wait_ns;
+
+  // retries of a transport request, only requests which retried (or failed
+  // after retries) are recorded.
+  Histogram send_retries;
+
+  PeerStatsSnapshot Snapshot() const;
+
+  void Reset();
+};
+
+std::ostream& operator<<(std::ostream& os, const HistogramSnapshot& h);
+std::ostream& operator<<(std::ostream& os, const PeerStatsSnapshot& st);
+
+// One message action, shown as a complete event ("ph": "X") in Chrome trace.
+struct TimelineSpan {
+  // tag of the link action (see TraceLogger::CurrentTag), or key if no tag.
+  std::string name;
+  // "send" or "recv"
+  const char* category;
+  std::string key;
+  size_t peer;
+  size_t bytes;
+  // wall clock start, in microseconds since epoch, so timelines dumped by
+  // different parties can be merged.
+  int64_t start_us;
+  int64_t duration_ns;
+};
+
+// Message timeline of a context (and its spawned children), disabled by
+// default. Dump it as Chrome trace JSON, which is loadable by
+// chrome://tracing and https://ui.perfetto.dev.
+class Timeline {
+ public:
+  static constexpr size_t kDefaultMaxSpans = 1U << 20;
+
+  // spans after max_spans are dropped (and counted).
+  void Enable(size_t max_spans = kDefaultMaxSpans);
+  void Disable() { enabled_.store(false, std::memory_order_relaxed); }
+  bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  void Add(TimelineSpan span);
+
+  std::vector<TimelineSpan> Spans() const;
+  size_t Dropped() const;
+  void Clear();
+
+  // pid is self rank and tid is peer rank.
+  std::string ToChromeTrace(size_t self_rank) const;
+  void DumpChromeTrace(const std::string& path, size_t self_rank) const;
+
+ private:
+  std::atomic<bool> enabled_ = false;
+  mutable std::mutex mutex_;
+  size_t max_spans_ = kDefaultMaxSpans;
+  size_t dropped_ = 0;
+  std::vector<TimelineSpan> spans_;
+};
+
+}  // namespace yacl::link
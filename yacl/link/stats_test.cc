@@ -0,0 +1,129 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/stats.h"
+
+#include <future>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "yacl/link/test_util.h"
+
+namespace yacl::link::test {
+
+TEST(HistogramTest, Works) {
+  Histogram h;
+  h.Record(0);
+  for (uint64_t i = 1; i <= 100; i++) {
+    h.Record(i);
+  }
+  h.Record(1000);
+
+  auto snap = h.Snapshot();
+  EXPECT_EQ(snap.count, 102);
+  EXPECT_EQ(snap.sum, 5050 + 1000);
+  EXPECT_EQ(snap.max, 1000);
+  // 1000 in [512, 1024)
+  EXPECT_EQ(snap.buckets.size(), 11);
+  EXPECT_EQ(snap.buckets[0], 1);
+  EXPECT_EQ(snap.buckets[1], 1);
+  EXPECT_EQ(snap.buckets[2], 2);
+  EXPECT_EQ(snap.buckets[10], 1);
+
+  // 51th value is 50, in [32, 64)
+  EXPECT_EQ(snap.Percentile(0.5), 63);
+  EXPECT_EQ(snap.Percentile(1.0), 1000);
+  EXPECT_EQ(snap.Percentile(0.0), 0);
+
+  h.Reset();
+  EXPECT_EQ(h.Snapshot().count, 0);
+  EXPECT_EQ(h.Snapshot().Percentile(0.5), 0);
+}
+
+TEST(TimelineTest, ChromeTrace) {
+  Timeline timeline;
+  timeline.Add({"t", "send", "k", 1, 10, 0, 0});
+  // disabled timeline is not recorded by context, but Add always works.
+  EXPECT_EQ(timeline.Spans().size(), 1);
+  timeline.Clear();
+
+  timeline.Enable(2);
+  timeline.Add({"tag\"1", "send", "key", 1, 10, 100, 2500});
+  timeline.Add({"tag2", "recv", "key", 2, 20, 200, 1000});
+  timeline.Add({"tag3", "recv", "key", 2, 20, 300, 1000});
+  EXPECT_EQ(timeline.Spans().size(), 2);
+  EXPECT_EQ(timeline.Dropped(), 1);
+
+  auto json = timeline.ToChromeTrace(0);
+  EXPECT_NE(json.find(R"("name":"tag\"1","cat":"send","ph":"X","ts":100,)"
+                      R"("dur":2.500,"pid":0,"tid":1)"),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find(R"("args":{"name":"peer 2"})"), std::string::npos);
+}
+
+TEST(PeerStatsTest, MemLink) {
+  const size_t kWorldSize = 2;
+  auto contexts = SetupWorld(kWorldSize);
+  contexts[0]->GetTimeline()->Enable();
+
+  auto proc = [&](size_t rank) {
+    auto ctx = contexts[rank];
+    for (size_t i = 0; i < 10; i++) {
+      if (rank == 0) {
+        ctx->SendAsync(1, std::string(100, 'a'), "ping");
+        ctx->Recv(1, "pong");
+      } else {
+        ctx->Recv(0, "ping");
+        ctx->SendAsync(0, std::string(200, 'b'), "pong");
+      }
+    }
+  };
+  auto f = std::async(proc, 1);
+  proc(0);
+  f.get();
+
+  auto stats = contexts[0]->GetAllPeerStats();
+  ASSERT_EQ(stats.size(), kWorldSize);
+  EXPECT_EQ(stats[0].sent_msg_bytes.count, 0);
+  EXPECT_EQ(stats[1].sent_msg_bytes.count, 10);
+  EXPECT_EQ(stats[1].sent_msg_bytes.sum, 1000);
+  EXPECT_EQ(stats[1].recv_msg_bytes.count, 10);
+  EXPECT_EQ(stats[1].recv_msg_bytes.max, 200);
+  EXPECT_EQ(stats[1].recv_wait_ns.count, 10);
+  EXPECT_EQ(stats[1].send_latency_ns.count, 10);
+  EXPECT_EQ(stats[1].throttle_wait_ns.count, 0);
+
+  // spawned context shares peer stats & timeline.
+  auto sub = contexts[0]->Spawn();
+  EXPECT_EQ(sub->GetPeerStats(1).sent_msg_bytes.count, 10);
+  EXPECT_EQ(sub->GetTimeline(), contexts[0]->GetTimeline());
+
+  auto spans = contexts[0]->GetTimeline()->Spans();
+  ASSERT_EQ(spans.size(), 20);
+  EXPECT_EQ(spans[0].name, "ping");
+  EXPECT_STREQ(spans[0].category, "send");
+  EXPECT_EQ(spans[1].name, "pong");
+  EXPECT_STREQ(spans[1].category, "recv");
+  EXPECT_EQ(spans[1].peer, 1);
+  EXPECT_EQ(spans[1].bytes, 200);
+  EXPECT_TRUE(contexts[1]->GetTimeline()->Spans().empty());
+
+  auto f1 = std::async([&] { contexts[1]->WaitLinkTaskFinish(); });
+  contexts[0]->WaitLinkTaskFinish();
+  f1.get();
+}
+
+}  // namespace yacl::link::test
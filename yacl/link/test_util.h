@@ -20,6 +20,7 @@
 #include "fmt/format.h"
 
 #include "yacl/base/buffer.h"
+#include "yacl/base/exception.h"
 #include "yacl/link/context.h"
 #include "yacl/link/factory.h"
 
@@ -62,10 +63,14 @@ inline std::vector<std::shared_ptr<Context>> SetupBrpcWorld(size_t world_size) {
   return SetupBrpcWorld(id, world_size);
 }
 
-inline std::vector<std::shared_ptr<Context>> SetupWorld(const std::string& id,
-                                                        size_t world_size) {
+// mem link world, messages go through an emulated network if emulation is
+// enabled, e.g. EmulationOptions::Wan().
+inline std::vector<std::shared_ptr<Context>> SetupWorld(
+    const std::string& id, size_t world_size,
+    const EmulationOptions& emulation) {
   ContextDesc ctx_desc;
   ctx_desc.id = id;
+  ctx_desc.mem_emulation = emulation;
   for (size_t rank = 0; rank < world_size; rank++) {
     ctx_desc.parties.push_back(
         {fmt::format("dummy_id:{}", rank), "dummy_host"});
@@ -88,11 +93,36 @@ inline std::vector<std::shared_ptr<Context>> SetupWorld(const std::string& id,
   return contexts;
 }
 
+inline std::vector<std::shared_ptr<Context>> SetupWorld(const std::string& id,
+                                                        size_t world_size) {
+  return SetupWorld(id, world_size, EmulationOptions());
+}
+
 inline std::vector<std::shared_ptr<Context>> SetupWorld(size_t world_size) {
   auto id = fmt::format("world_{}", world_size);
   return SetupWorld(id, world_size);
 }
 
+// network of a benchmark world, e.g. as a benchmark argument.
+enum BenchNetwork : int64_t {
+  kNetLocal = 0,  // instant delivery
+  kNetLan = 1,    // EmulationOptions::Lan()
+  kNetWan = 2,    // EmulationOptions::Wan()
+};
+
+inline EmulationOptions BenchEmulation(int64_t network) {
+  switch (network) {
+    case kNetLocal:
+      return EmulationOptions();
+    case kNetLan:
+      return EmulationOptions::Lan();
+    case kNetWan:
+      return EmulationOptions::Wan();
+    default:
+      YACL_THROW("unknown bench network {}", network);
+  }
+}
+
 inline std::string MakeRoundData(size_t rank, size_t round) {
   // result in different content/length for each rank/round.
   const auto spaces = std::string(rank, '_');
@@ -15,6 +15,7 @@
 #include "yacl/link/trace.h"
 
 #include <mutex>
+#include <string>
 
 #include "absl/strings/escaping.h"
 #include "spdlog/sinks/rotating_file_sink.h"
@@ -30,6 +31,8 @@ const char* kLoggerPath = "trace.log";
 const size_t kDefaultMaxLogFileSize = 500 * 1024 * 1024;
 const size_t kDefaultMaxLogFileCount = 3;
 
+thread_local std::string gCurrentTag;
+
 }  // namespace
 
 std::shared_ptr<TraceLogger> TraceLogger::logger_;
@@ -41,6 +44,8 @@ void TraceLogger::SetLogger(std::shared_ptr<TraceLogger> l) {
 
 void TraceLogger::LinkTrace(std::string_view event, std::string_view tag,
                             std::string_view content) {
+  gCurrentTag.assign(tag.data(), tag.size());
+
 #ifdef ENABLE_LINK_TRACE
   static std::once_flag gInitTrace;
   std::call_once(gInitTrace, []() {
@@ -56,6 +61,8 @@ void TraceLogger::LinkTrace(std::string_view event, std::string_view tag,
   }
 }
 
+std::string_view TraceLogger::CurrentTag() { return gCurrentTag; }
+
 DefaultLogger::DefaultLogger() {
   spdlog::rotating_logger_mt(kLoggerName, kLoggerPath, kDefaultMaxLogFileSize,
                              kDefaultMaxLogFileCount);
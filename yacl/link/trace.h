@@ -37,6 +37,10 @@ class TraceLogger {
   static void LinkTrace(std::string_view event, std::string_view tag,
                         std::string_view content);
 
+  // tag of the last link action traced by this thread, used to name spans of
+  // its messages in link timeline (see link/stats.h).
+  static std::string_view CurrentTag();
+
  private:
   static std::shared_ptr<TraceLogger> logger_;
 
@@ -18,6 +18,7 @@
 #include <memory>
 #include <utility>
 
+#include "fmt/format.h"
 #include "spdlog/spdlog.h"
 
 #include "yacl/base/exception.h"
@@ -104,9 +105,18 @@ std::string ReceiverLoopBrpc::Start(const std::string& host,
   return butil::endpoint2str(server_.listen_address()).c_str();
 }
 
+void BrpcLink::SetStripe(size_t max_connections, bool adaptive) {
+  YACL_ENFORCE(delegate_channel_ == nullptr,
+               "SetStripe should be called before SetPeerHost");
+  if (max_connections > 1) {
+    stripe_tuner_ = std::make_unique<StripeTuner>(max_connections, adaptive);
+  } else {
+    stripe_tuner_.reset();
+  }
+}
+
 void BrpcLink::SetPeerHost(const std::string& peer_host,
                            const SSLOptions* ssl_opts) {
-  auto brpc_channel = std::make_unique<brpc::Channel>();
   const auto load_balancer = "";
   brpc::ChannelOptions options;
   {
@@ -127,26 +137,52 @@ void BrpcLink::SetPeerHost(const std::string& peer_host,
           ssl_opts->verify.ca_file_path;
     }
   }
-  int res = brpc_channel->Init(peer_host.c_str(), load_balancer, &options);
-  if (res != 0) {
-    YACL_THROW_NETWORK_ERROR("Fail to initialize channel, host={}, err_code={}",
-                             peer_host, res);
+
+  const size_t num_channels = stripe_tuner_ ? stripe_tuner_->MaxStreams() : 1;
+  std::vector<std::shared_ptr<brpc::Channel>> channels(num_channels);
+  for (size_t i = 0; i < num_channels; i++) {
+    // channels of different groups never share connections.
+    options.connection_group = i == 0 ? "" : fmt::format("yacl_stripe_{}", i);
+    auto brpc_channel = std::make_shared<brpc::Channel>();
+    int res = brpc_channel->Init(peer_host.c_str(), load_balancer, &options);
+    if (res != 0) {
+      YACL_THROW_NETWORK_ERROR(
+          "Fail to initialize channel, host={}, err_code={}", peer_host, res);
+    }
+    channels[i] = std::move(brpc_channel);
   }
 
-  delegate_channel_ = std::move(brpc_channel);
+  delegate_channel_ = channels[0];
+  stripe_channels_ = std::move(channels);
   peer_host_ = peer_host;
 }
 
 void BrpcLink::SendRequest(const Request& request, uint32_t timeout) const {
+  // only chunks are striped, mono messages keep the primary connection.
+  brpc::Channel* channel = delegate_channel_.get();
+  const bool striped = stripe_tuner_ != nullptr && IsChunkedRequest(request);
+  size_t request_bytes = 0;
+  if (striped) {
+    const size_t idx = stripe_counter_.fetch_add(1, std::memory_order_relaxed) %
+                       stripe_tuner_->Streams();
+    channel = stripe_channels_[idx].get();
+    request_bytes = request.ByteSizeLong();
+    stripe_tuner_->OnRequestStart();
+  }
+
   ic_pb::PushResponse response;
   brpc::Controller cntl;
   cntl.ignore_eovercrowded();
   if (timeout != 0) {
     cntl.set_timeout_ms(timeout);
   }
-  ic_pb::ReceiverService::Stub stub(delegate_channel_.get());
+  ic_pb::ReceiverService::Stub stub(channel);
   stub.Push(&cntl, static_cast<const ic_pb::PushRequest*>(&request), &response,
             nullptr);
+  if (striped) {
+    // failed requests count as busy time without bytes.
+    stripe_tuner_->OnRequestDone(cntl.Failed() ? 0 : request_bytes);
+  }
   // handle failures.
   if (cntl.Failed()) {
     ThrowLinkErrorByBrpcCntl(cntl);
@@ -14,10 +14,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 #include "brpc/channel.h"
 #include "brpc/server.h"
@@ -28,6 +30,7 @@
 #include "yacl/link/ssl_options.h"
 #include "yacl/link/transport/channel.h"
 #include "yacl/link/transport/interconnection_link.h"
+#include "yacl/link/transport/stripe_tuner.h"
 
 namespace yacl::link::transport {
 
@@ -72,10 +75,26 @@ class BrpcLink final : public InterconnectionLink {
   void SetPeerHost(const std::string& peer_host,
                    const SSLOptions* ssl_opts = nullptr);
 
+  // stripe chunks of large messages across up to max_connections connections
+  // to peer, receiver reassembles chunks by offset. the number in use adapts
+  // to measured throughput if adaptive, see StripeTuner.
+  // should be called before SetPeerHost.
+  void SetStripe(size_t max_connections, bool adaptive);
+
+  // number of connections chunks are striped across now.
+  size_t StripeConnections() const {
+    return stripe_tuner_ ? stripe_tuner_->Streams() : 1;
+  }
+
  protected:
   // brpc channel related.
   std::string peer_host_;
   std::shared_ptr<brpc::Channel> delegate_channel_;
+
+  // striping related, stripe_channels_[0] is delegate_channel_.
+  std::vector<std::shared_ptr<brpc::Channel>> stripe_channels_;
+  std::unique_ptr<StripeTuner> stripe_tuner_;
+  mutable std::atomic<size_t> stripe_counter_ = 0;
 };
 
 }  // namespace yacl::link::transport
@@ -79,10 +79,15 @@ class BrpcLinkTest : public ::testing::Test {
     sender_loop_->AddListener(1, sender_);
     sender_host_ = sender_loop_->Start("127.0.0.1:0");
 
+    ConfigLink(sender_delegate.get());
+    ConfigLink(receive_delegate.get());
     sender_delegate->SetPeerHost(receiver_host_);
     receive_delegate->SetPeerHost(sender_host_);
   }
 
+  // called before SetPeerHost.
+  virtual void ConfigLink(BrpcLink* /*link*/) {}
+
   void TearDown() override {
     auto wait = [](std::shared_ptr<Channel>& l) {
       if (l) {
@@ -330,6 +335,52 @@ INSTANTIATE_TEST_SUITE_P(
       return name;
     });
 
+class BrpcLinkStripeTest : public BrpcLinkTest,
+                           public ::testing::WithParamInterface<bool> {
+ protected:
+  void ConfigLink(BrpcLink* link) override { link->SetStripe(4, GetParam()); }
+};
+
+TEST_P(BrpcLinkStripeTest, Send) {
+  sender_->SetChunkParallelSendSize(8);
+  receiver_->SetChunkParallelSendSize(8);
+  sender_->GetLink()->SetMaxBytesPerChunk(1000);
+
+  // chunks of one message go through different connections.
+  const std::string key = "key";
+  const std::string sent = RandStr(64 * 1000 + 7);
+  sender_->Send(key, sent);
+  auto received = receiver_->Recv(key);
+  EXPECT_EQ(sent, std::string_view(received));
+
+  // enough chunks for the adaptive tuner to change connections in use.
+  const size_t test_size = 32;
+  std::vector<std::string> sended_data(test_size);
+  for (size_t i = 0; i < test_size; i++) {
+    sended_data[i] = RandStr(32 * 1000 + i);
+    sender_->SendAsync(fmt::format("Key_{}", i),
+                       ByteContainerView{sended_data[i]});
+  }
+  for (size_t i = 0; i < test_size; i++) {
+    auto received = receiver_->Recv(fmt::format("Key_{}", i));
+    EXPECT_EQ(sended_data[i], std::string_view(received));
+  }
+
+  auto link = std::dynamic_pointer_cast<BrpcLink>(sender_->GetLink());
+  ASSERT_NE(link, nullptr);
+  if (GetParam()) {
+    EXPECT_GE(link->StripeConnections(), 1U);
+    EXPECT_LE(link->StripeConnections(), 4U);
+  } else {
+    EXPECT_EQ(link->StripeConnections(), 4U);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Stripe, BrpcLinkStripeTest, testing::Bool(),
+                         [](const testing::TestParamInfo<bool>& info) {
+                           return info.param ? "Adaptive" : "Fixed";
+                         });
+
 class BrpcLinkSSLTest : public ::testing::Test {
  protected:
   void SetUp() override {
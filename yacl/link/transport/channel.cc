@@ -14,6 +14,8 @@
 
 #include "yacl/link/transport/channel.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <set>
 
@@ -34,6 +36,7 @@ namespace {
 const std::string kAckKey{'A', 'C', 'K', '\x01', '\x02'};
 const std::string kFinKey{'F', 'I', 'N', '\x01', '\x02'};
 const std::string kSeqKey{'\x01', '\x02'};
+const std::string kBatchKey{'B', 'A', 'T', '\x01', '\x02'};
 
 void NormalMessageKeyEnforce(std::string_view k) {
   YACL_ENFORCE(!k.empty(), "do not use empty key");
@@ -68,6 +71,12 @@ std::pair<std::string, size_t> SplitChannelKey(std::string_view key) {
   return ret;
 }
 
+// batch msg value is a list of frames, each frame is
+// | key_size (uint32) | key | value_size (uint64) | value |
+size_t BatchFrameSize(const std::string& key, ByteContainerView value) {
+  return sizeof(uint32_t) + key.size() + sizeof(uint64_t) + value.size();
+}
+
 }  // namespace
 
 class SendTask {
@@ -86,7 +95,11 @@ class SendTask {
 
   ~SendTask() {
     try {
-      channel_->send_sync_.SendTaskFinishedNotify(msg_.seq_id_);
+      if (msg_.batch_seq_ids_.empty()) {
+        channel_->send_sync_.SendTaskFinishedNotify(msg_.seq_id_);
+      } else {
+        channel_->send_sync_.SendTaskFinishedNotify(msg_.batch_seq_ids_);
+      }
     } catch (...) {
       SPDLOG_ERROR("SendTaskFinishedNotify error");
       if (exit_if_async_error_) {
@@ -100,6 +113,19 @@ class SendTask {
     std::unique_ptr<SendTask> task(static_cast<SendTask*>(args));
     try {
       task->channel_->SendImpl(task->msg_.msg_key_, task->msg_.value_);
+      // ack/fin msgs have no seq id.
+      const auto& batch_ids = task->msg_.batch_seq_ids_;
+      if (task->msg_.seq_id_ != 0 || !batch_ids.empty() ||
+          task->channel_->disable_msg_seq_id_) {
+        const auto latency =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - task->msg_.submit_time_)
+                .count();
+        // every msg in a batch is counted, with the oldest msg's latency.
+        for (size_t i = 0; i < std::max<size_t>(batch_ids.size(), 1); i++) {
+          task->channel_->peer_stats_->send_latency_ns.Record(latency);
+        }
+      }
     } catch (const std::exception& e) {
       SPDLOG_ERROR("SendImpl error {}", e.what());
       if (task->exit_if_async_error_) {
@@ -152,13 +178,105 @@ std::optional<Channel::Message> Channel::MessageQueue::Pop(bool block) {
   }
 }
 
+std::optional<Channel::Message> Channel::MessageQueue::PopFor(
+    int64_t timeout_us) {
+  std::unique_lock<bthread::Mutex> lock(mutex_);
+  if (timeout_us > 0 && queue_.empty() && !stopped_) {
+    cond_.wait_for(lock, timeout_us);
+  }
+
+  if (!queue_.empty()) {
+    auto msg = std::move(queue_.front());
+    queue_.pop();
+    return msg;
+  } else {
+    return {};
+  }
+}
+
+bool Channel::CanCoalesce(const Message& msg) const {
+  const size_t max_msg_bytes = coalesce_max_msg_bytes_;
+  return max_msg_bytes > 0 && msg.value_.size() <= max_msg_bytes &&
+         BatchFrameSize(msg.msg_key_, msg.value_) <=
+             link_->GetMaxBytesPerChunk();
+}
+
+Channel::Message Channel::CoalesceMessages(Message&& first,
+                                           std::optional<Message>* left) {
+  const size_t max_batch_bytes = link_->GetMaxBytesPerChunk();
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(coalesce_window_us_);
+
+  std::vector<Message> msgs;
+  size_t batch_bytes = BatchFrameSize(first.msg_key_, first.value_);
+  msgs.push_back(std::move(first));
+  while (true) {
+    const auto remain_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            deadline - std::chrono::steady_clock::now())
+            .count();
+    auto msg = send_msgs_.PopFor(remain_us);
+    if (!msg.has_value()) {
+      break;
+    }
+    const size_t frame_bytes = BatchFrameSize(msg->msg_key_, msg->value_);
+    if (!CanCoalesce(*msg) || batch_bytes + frame_bytes > max_batch_bytes) {
+      *left = std::move(msg);
+      break;
+    }
+    batch_bytes += frame_bytes;
+    msgs.push_back(std::move(*msg));
+  }
+  if (msgs.size() == 1) {
+    return std::move(msgs[0]);
+  }
+
+  Buffer value(batch_bytes);
+  auto* p = value.data<char>();
+  std::vector<size_t> seq_ids;
+  seq_ids.reserve(msgs.size());
+  for (const auto& msg : msgs) {
+    const auto key_size = static_cast<uint32_t>(msg.msg_key_.size());
+    const auto value_size = static_cast<uint64_t>(msg.value_.size());
+    std::memcpy(p, &key_size, sizeof(key_size));
+    p += sizeof(key_size);
+    std::memcpy(p, msg.msg_key_.data(), key_size);
+    p += key_size;
+    std::memcpy(p, &value_size, sizeof(value_size));
+    p += sizeof(value_size);
+    if (value_size > 0) {
+      std::memcpy(p, msg.value_.data(), value_size);
+    }
+    p += value_size;
+    seq_ids.push_back(msg.seq_id_);
+  }
+
+  Message batch(0, kBatchKey, std::move(value));
+  batch.batch_seq_ids_ = std::move(seq_ids);
+  batch.submit_time_ = msgs[0].submit_time_;
+  return batch;
+}
+
 void Channel::SendThread() {
-  while (!send_thread_stopped_.load()) {
-    auto msg = send_msgs_.Pop(true);
+  // msg popped but not packed by last batch.
+  std::optional<Message> left;
+  while (!send_thread_stopped_.load() || left.has_value()) {
+    std::optional<Message> msg;
+    if (left.has_value()) {
+      msg.swap(left);
+    } else {
+      msg = send_msgs_.Pop(true);
+    }
     if (!msg.has_value()) {
       continue;
     }
-    auto seq_id = msg.value().seq_id_;
+    if (CanCoalesce(*msg)) {
+      msg = CoalesceMessages(std::move(*msg), &left);
+    }
+    size_t seq_id = msg->seq_id_;
+    for (auto id : msg->batch_seq_ids_) {
+      seq_id = std::max(seq_id, id);
+    }
     SubmitSendTask(std::move(msg.value()));
     ThrottleWindowWait(seq_id);
   }
@@ -318,6 +436,9 @@ void Channel::SendRequestWithRetry(const ::google::protobuf::Message& request,
   while (true) {
     try {
       link_->SendRequest(request, timeout_override_ms);
+      if (retry_count > 0) {
+        peer_stats_->send_retries.Record(retry_count);
+      }
       break;
     } catch (const yacl::LinkError& e) {
       auto should_retry = [&](const RetryOptions& retry_options) -> bool {
@@ -338,10 +459,14 @@ void Channel::SendRequestWithRetry(const ::google::protobuf::Message& request,
 
       if (!should_retry(retry_options_)) {
         SPDLOG_WARN("send request failed and no retry, message={}", e.what());
+        if (retry_count > 0) {
+          peer_stats_->send_retries.Record(retry_count);
+        }
         throw e;
       }
 
       if (retry_count >= retry_options_.max_retry) {
+        peer_stats_->send_retries.Record(retry_count);
         throw e;
       }
       uint32_t interval_ms =
@@ -373,6 +498,18 @@ void Channel::SendTaskSynchronizer::SendTaskFinishedNotify(size_t seq_id) {
   finished_cond_.notify_all();
 }
 
+void Channel::SendTaskSynchronizer::SendTaskFinishedNotify(
+    const std::vector<size_t>& seq_ids) {
+  std::unique_lock<bthread::Mutex> lock(mutex_);
+  running_tasks_--;
+  for (auto seq_id : seq_ids) {
+    if (seq_id != 0) {
+      finished_ids_.Insert(seq_id);
+    }
+  }
+  finished_cond_.notify_all();
+}
+
 void Channel::SendTaskSynchronizer::WaitSeqIdSendFinished(size_t seq_id) {
   std::unique_lock<bthread::Mutex> lock(mutex_);
   while (!finished_ids_.Contains(seq_id)) {
@@ -417,6 +554,27 @@ Buffer Channel::Recv(const std::string& msg_key) {
   return value;
 }
 
+void Channel::RecvAsync(const std::string& msg_key, RecvCallback done) {
+  NormalMessageKeyEnforce(msg_key);
+
+  Buffer value;
+  size_t seq_id = 0;
+  {
+    std::unique_lock<bthread::Mutex> lock(msg_mutex_);
+    auto itr = recv_msgs_.find(msg_key);
+    if (itr == recv_msgs_.end()) {
+      YACL_ENFORCE(recv_callbacks_.emplace(msg_key, std::move(done)).second,
+                   "duplicated RecvAsync, key={}", msg_key);
+      return;
+    }
+    std::tie(value, seq_id) = std::move(itr->second);
+    recv_msgs_.erase(itr);
+  }
+  SendAck(seq_id);
+
+  done(std::move(value));
+}
+
 void Channel::SendAck(size_t seq_id) {
   if (seq_id > 0) {
     // 0 seq id use for TestSend/TestRecv, no need to send ack.
@@ -437,7 +595,13 @@ void Channel::OnNormalMessage(const std::string& key, T&& v) {
     return;
   }
 
-  if (!waiting_finish_.load()) {
+  auto callback = recv_callbacks_.find(msg_key);
+  if (callback != recv_callbacks_.end()) {
+    auto done = std::move(callback->second);
+    recv_callbacks_.erase(callback);
+    SendAck(seq_id);
+    done(Buffer(std::forward<T>(v)));
+  } else if (!waiting_finish_.load()) {
     auto pair =
         recv_msgs_.emplace(msg_key, std::make_pair(std::forward<T>(v), seq_id));
     if (seq_id > 0 && !pair.second) {
@@ -537,11 +701,36 @@ void Channel::OnMessage(const std::string& key, ByteContainerView value) {
     } else {
       SPDLOG_WARN("Duplicate FIN");
     }
+  } else if (key == kBatchKey) {
+    OnBatchMessage(value);
   } else {
     OnNormalMessage(key, value);
   }
 }
 
+void Channel::OnBatchMessage(ByteContainerView value) {
+  const auto* p = value.data();
+  const auto* end = value.data() + value.size();
+  auto read = [&](void* dst, size_t size) {
+    YACL_ENFORCE(static_cast<size_t>(end - p) >= size,
+                 "invalid batch msg, size={}", value.size());
+    std::memcpy(dst, p, size);
+    p += size;
+  };
+  while (p != end) {
+    uint32_t key_size = 0;
+    read(&key_size, sizeof(key_size));
+    std::string key(key_size, '\0');
+    read(key.data(), key_size);
+    uint64_t value_size = 0;
+    read(&value_size, sizeof(value_size));
+    YACL_ENFORCE(static_cast<uint64_t>(end - p) >= value_size,
+                 "invalid batch msg, size={}", value.size());
+    OnNormalMessage(key, ByteContainerView(p, value_size));
+    p += value_size;
+  }
+}
+
 void Channel::SetRecvTimeout(uint64_t recv_timeout_ms) {
   recv_timeout_ms_ = recv_timeout_ms;
 }
@@ -626,14 +815,26 @@ void Channel::ThrottleWindowWait(size_t wait_count) {
     return;
   }
   std::unique_lock<bthread::Mutex> lock(msg_mutex_);
+  std::chrono::steady_clock::time_point start;
+  bool stalled = false;
   while ((throttle_window_size_ != 0) &&
          (received_ack_ids_.Count() + throttle_window_size_ <= wait_count)) {
+    if (!stalled) {
+      stalled = true;
+      start = std::chrono::steady_clock::now();
+    }
     //                               timeout_us
     if (ack_fin_cond_.wait_for(
             lock, static_cast<int64_t>(recv_timeout_ms_) * 1000) == ETIMEDOUT) {
       YACL_THROW_IO_ERROR("Throttle window wait timeout");
     }
   }
+  if (stalled) {
+    peer_stats_->throttle_wait_ns.Record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  }
 }
 
 void Channel::WaitAsyncSendToFinish() {
@@ -14,7 +14,9 @@
 
 #pragma once
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -23,6 +25,7 @@
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "brpc/controller.h"
 #include "bthread/bthread.h"
@@ -34,6 +37,7 @@
 #include "yacl/base/byte_container_view.h"
 #include "yacl/base/exception.h"
 #include "yacl/link/retry_options.h"
+#include "yacl/link/stats.h"
 #include "yacl/utils/segment_tree.h"
 
 namespace yacl::link::transport {
@@ -67,6 +71,17 @@ class IChannel {
   // block waiting message.
   virtual Buffer Recv(const std::string& key) = 0;
 
+  using RecvCallback = std::function<void(Buffer&&)>;
+
+  // call done with message once received, in place if already received,
+  // otherwise by the thread delivering message with channel lock held, so
+  // done should be short and not call back into channel.
+  // RecvAsync is not reentrant with same key.
+  // throw if the channel does not support it.
+  virtual void RecvAsync(const std::string& key, RecvCallback /*done*/) {
+    YACL_THROW("RecvAsync not supported, key={}", key);
+  }
+
   // called by an async dispatcher.
   virtual void OnMessage(const std::string& key, ByteContainerView value) = 0;
 
@@ -92,6 +107,12 @@ class IChannel {
 
   // set chunk parallel send size
   virtual void SetChunkParallelSendSize(size_t size) = 0;
+
+  // statistics of messages exchanged with peer.
+  std::shared_ptr<PeerStats> GetPeerStats() const { return peer_stats_; }
+
+ protected:
+  const std::shared_ptr<PeerStats> peer_stats_ = std::make_shared<PeerStats>();
 };
 
 class TransportLink {
@@ -187,6 +208,8 @@ class Channel : public IChannel, public std::enable_shared_from_this<Channel> {
 
   Buffer Recv(const std::string& key) override;
 
+  void RecvAsync(const std::string& key, RecvCallback done) override;
+
   void OnMessage(const std::string& key, ByteContainerView value) override;
 
   void SetRecvTimeout(uint64_t recv_timeout_ms) override;
@@ -221,6 +244,15 @@ class Channel : public IChannel, public std::enable_shared_from_this<Channel> {
     disable_msg_seq_id_ = disable_msg_seq_id;
   }
 
+  // pack queued async msgs no larger than max_msg_bytes into one request,
+  // after the first small msg, send thread waits at most window_us for more.
+  // a batch never exceeds one chunk, 0 max_msg_bytes disables coalescing.
+  // peer unpacks batches whether or not it coalesces itself.
+  void SetCoalesce(size_t max_msg_bytes, uint32_t window_us) {
+    coalesce_max_msg_bytes_ = max_msg_bytes;
+    coalesce_window_us_ = window_us;
+  }
+
   void SendRequestWithRetry(
       const ::google::protobuf::Message& request, uint32_t timeout_override_ms,
       spdlog::level::level_enum log_level = spdlog::level::info) const;
@@ -264,6 +296,8 @@ class Channel : public IChannel, public std::enable_shared_from_this<Channel> {
 
   void SendAck(size_t seq_id);
 
+  void OnBatchMessage(ByteContainerView value);
+
   friend class SendTask;
 
   struct Message {
@@ -282,6 +316,11 @@ class Channel : public IChannel, public std::enable_shared_from_this<Channel> {
     std::string msg_key_;
     Buffer value_data_;
     ByteContainerView value_;
+    // seq ids of msgs packed in a batch msg, empty for others.
+    std::vector<size_t> batch_seq_ids_;
+    // for send latency statistics.
+    std::chrono::steady_clock::time_point submit_time_ =
+        std::chrono::steady_clock::now();
   };
 
   void StartSendThread();
@@ -290,10 +329,17 @@ class Channel : public IChannel, public std::enable_shared_from_this<Channel> {
 
   void SubmitSendTask(Message&& msg);
 
+  bool CanCoalesce(const Message& msg) const;
+
+  // pack first and following queued small msgs into one batch msg, the msg
+  // ending the batch (if any) is returned by left.
+  Message CoalesceMessages(Message&& first, std::optional<Message>* left);
+
   class SendTaskSynchronizer {
    public:
     void SendTaskStartNotify();
     void SendTaskFinishedNotify(size_t seq_id);
+    void SendTaskFinishedNotify(const std::vector<size_t>& seq_ids);
     void WaitSeqIdSendFinished(size_t seq_id);
     void WaitAllSendFinished();
 
@@ -308,6 +354,8 @@ class Channel : public IChannel, public std::enable_shared_from_this<Channel> {
    public:
     void Push(Message&&);
     std::optional<Message> Pop(bool block);
+    // wait at most timeout_us if queue is empty.
+    std::optional<Message> PopFor(int64_t timeout_us);
     void EmptyNotify();
 
    private:
@@ -330,11 +378,17 @@ class Channel : public IChannel, public std::enable_shared_from_this<Channel> {
   std::map<std::string, std::shared_ptr<ChunkedMessage>> chunked_values_;
   std::atomic<uint32_t> chunk_parallel_send_size_ = 8;
 
+  // coalescing related.
+  std::atomic<size_t> coalesce_max_msg_bytes_ = 0;
+  std::atomic<uint32_t> coalesce_window_us_ = 0;
+
   // message database related.
   bthread::Mutex msg_mutex_;
   bthread::ConditionVariable msg_db_cond_;
   // msg_key -> <value, seq_id>
   std::map<std::string, std::pair<Buffer, size_t>> recv_msgs_;
+  // msg_key -> RecvAsync callback waiting for msg.
+  std::map<std::string, RecvCallback> recv_callbacks_;
 
   // for Throttle Window
   std::atomic<size_t> throttle_window_size_ = 0;
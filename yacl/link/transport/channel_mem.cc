@@ -14,22 +14,138 @@
 
 #include "yacl/link/transport/channel_mem.h"
 
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
 #include "yacl/base/exception.h"
+#include "yacl/utils/hash_combine.h"
 
 namespace yacl::link::transport {
 
-ChannelMem::ChannelMem(size_t /*self_rank*/, size_t /*peer_rank*/,
-                       size_t timeout_ms)
-    : recv_timeout_ms_(timeout_ms * std::chrono::milliseconds(1)) {}
+ChannelMem::ChannelMem(size_t self_rank, size_t peer_rank, size_t timeout_ms)
+    : self_rank_(self_rank),
+      peer_rank_(peer_rank),
+      recv_timeout_ms_(timeout_ms * std::chrono::milliseconds(1)) {}
 
 void ChannelMem::SetPeer(const std::shared_ptr<ChannelMem>& peer_task) {
   peer_channel_ = peer_task;
   finished_ = false;
 }
 
-void ChannelMem::SendImpl(const std::string& key, ByteContainerView value) {
+void ChannelMem::SetEmulation(const EmulationOptions& options) {
+  std::unique_lock lock(emu_mutex_);
+  YACL_ENFORCE(!deliver_thread_.joinable(), "emulation is already set");
+  if (!options.Enabled()) {
+    return;
+  }
+  emulation_ = options;
+  size_t seed = options.seed;
+  utils::hash_combine(seed, self_rank_, peer_rank_);
+  jitter_rng_.seed(seed);
+  link_free_time_ = Clock::now();
+  deliver_thread_ = std::thread([this] { DeliverLoop(); });
+}
+
+void ChannelMem::StopEmulation() {
+  {
+    std::unique_lock lock(emu_mutex_);
+    emu_stopped_ = true;
+  }
+  emu_cond_.notify_all();
+  if (deliver_thread_.joinable()) {
+    deliver_thread_.join();
+  }
+}
+
+void ChannelMem::EmulateSend(const std::string& key, ByteContainerView value,
+                             bool sync) {
+  const auto now = Clock::now();
+  std::unique_lock lock(emu_mutex_);
+  auto depart_time = now;
+  if (emulation_.bandwidth_bps != 0) {
+    const auto bytes_to_time = [&](uint64_t bytes) {
+      return std::chrono::nanoseconds(static_cast<int64_t>(
+          static_cast<double>(bytes) * 8e9 / emulation_.bandwidth_bps));
+    };
+    // unused tokens are capped by bucket depth.
+    link_free_time_ =
+        std::max(link_free_time_, now - bytes_to_time(emulation_.burst_bytes));
+    link_free_time_ += bytes_to_time(value.size());
+    depart_time = std::max(now, link_free_time_);
+  }
+  auto delay = std::chrono::microseconds(emulation_.latency_us);
+  if (emulation_.jitter_us != 0) {
+    delay += std::chrono::microseconds(jitter_rng_() %
+                                       (uint64_t(emulation_.jitter_us) + 1));
+  }
+  // keep in order.
+  last_deliver_time_ = std::max(last_deliver_time_, depart_time + delay);
+
+  flying_msgs_.push_back({key, Buffer(value), now, last_deliver_time_});
+  const size_t id = ++submitted_count_;
+  emu_cond_.notify_all();
+
+  if (sync) {
+    emu_cond_.wait(lock,
+                   [&] { return emu_stopped_ || delivered_count_ >= id; });
+  }
+}
+
+void ChannelMem::DeliverLoop() {
+  std::unique_lock lock(emu_mutex_);
+  while (true) {
+    emu_cond_.wait(lock, [&] { return emu_stopped_ || !flying_msgs_.empty(); });
+    if (emu_stopped_) {
+      return;
+    }
+    const auto deliver_time = flying_msgs_.front().deliver_time;
+    // messages are queued in deliver order, so only stop interrupts it.
+    if (emu_cond_.wait_until(lock, deliver_time,
+                             [&] { return emu_stopped_; })) {
+      return;
+    }
+    auto msg = std::move(flying_msgs_.front());
+    flying_msgs_.pop_front();
+    lock.unlock();
+
+    if (auto ptr = peer_channel_.lock()) {
+      ptr->OnMessage(msg.key, msg.value);
+      if (msg.key != kFinKey) {
+        peer_stats_->send_latency_ns.Record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - msg.submit_time)
+                .count());
+      }
+    } else {
+      SPDLOG_ERROR("Peer's memory channel released, drop message {}",
+                   msg.key);
+    }
+
+    lock.lock();
+    delivered_count_++;
+    emu_cond_.notify_all();
+  }
+}
+
+void ChannelMem::SendImpl(const std::string& key, ByteContainerView value,
+                          bool sync) {
+  if (deliver_thread_.joinable()) {
+    if (peer_channel_.expired()) {
+      YACL_THROW_IO_ERROR("Peer's memory channel released");
+    }
+    EmulateSend(key, value, sync);
+    return;
+  }
   if (auto ptr = peer_channel_.lock()) {
+    const auto start = std::chrono::steady_clock::now();
     ptr->OnMessage(key, value);
+    if (key != kFinKey) {
+      peer_stats_->send_latency_ns.Record(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count());
+    }
   } else {
     YACL_THROW_IO_ERROR("Peer's memory channel released");
   }
@@ -57,10 +173,33 @@ Buffer ChannelMem::Recv(const std::string& key) {
   return value;
 }
 
+void ChannelMem::RecvAsync(const std::string& key, RecvCallback done) {
+  Buffer value;
+  {
+    std::unique_lock lock(msg_mutex_);
+    auto itr = recv_msgs_.find(key);
+    if (itr == recv_msgs_.end()) {
+      YACL_ENFORCE(recv_callbacks_.emplace(key, std::move(done)).second,
+                   "duplicated RecvAsync, key={}", key);
+      return;
+    }
+    value = std::move(itr->second);
+    recv_msgs_.erase(itr);
+  }
+  done(std::move(value));
+}
+
 void ChannelMem::OnMessage(const std::string& msg_key,
                            ByteContainerView value) {
   {
     std::unique_lock lock(msg_mutex_);
+    auto itr = recv_callbacks_.find(msg_key);
+    if (itr != recv_callbacks_.end()) {
+      auto done = std::move(itr->second);
+      recv_callbacks_.erase(itr);
+      done(Buffer(value));
+      return;
+    }
     recv_msgs_.emplace(msg_key, value);
   }
   msg_db_cond_.notify_all();
@@ -17,11 +17,15 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <random>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
+#include "yacl/link/emulation_options.h"
 #include "yacl/link/transport/channel.h"
 
 namespace yacl::link::transport {
@@ -41,12 +45,17 @@ class ChannelMem final : public IChannel {
       // WaitLinkTaskFinish should be called if you want to keep sync with
       // peers.
     }
+    StopEmulation();
   }
 
   ChannelMem(size_t self_rank, size_t peer_rank, size_t timeout_ms = 20000U);
 
   void SetPeer(const std::shared_ptr<ChannelMem>& peer_task);
 
+  // emulate the network of direction self -> peer, should be called before
+  // any send.
+  void SetEmulation(const EmulationOptions& options);
+
   void SendAsync(const std::string& key, ByteContainerView value) final {
     SendImpl(key, value);
   }
@@ -65,11 +74,13 @@ class ChannelMem final : public IChannel {
   }
 
   void Send(const std::string& key, ByteContainerView value) final {
-    SendImpl(key, value);
+    SendImpl(key, value, true);
   }
 
   Buffer Recv(const std::string& key) final;
 
+  void RecvAsync(const std::string& key, RecvCallback done) final;
+
   void OnMessage(const std::string& key, ByteContainerView value) final;
 
   void SetRecvTimeout(uint64_t timeout_ms) final {
@@ -88,13 +99,48 @@ class ChannelMem final : public IChannel {
   // no affect
 
  private:
-  void SendImpl(const std::string& key, ByteContainerView value);
+  // sync: wait the message delivered, only matters with emulation.
+  void SendImpl(const std::string& key, ByteContainerView value,
+                bool sync = false);
+
+  // emulation related.
+  using Clock = std::chrono::steady_clock;
+
+  struct FlyingMessage {
+    std::string key;
+    Buffer value;
+    Clock::time_point submit_time;
+    Clock::time_point deliver_time;
+  };
+
+  void EmulateSend(const std::string& key, ByteContainerView value,
+                   bool sync);
+  void DeliverLoop();
+  void StopEmulation();
+
+  const size_t self_rank_;
+  const size_t peer_rank_;
+
+  EmulationOptions emulation_;
+  std::mutex emu_mutex_;
+  std::condition_variable emu_cond_;
+  std::deque<FlyingMessage> flying_msgs_;
+  // token bucket: time when all queued bytes have departed.
+  Clock::time_point link_free_time_;
+  Clock::time_point last_deliver_time_;
+  std::mt19937_64 jitter_rng_;
+  size_t submitted_count_ = 0;
+  size_t delivered_count_ = 0;
+  bool emu_stopped_ = false;
+  std::thread deliver_thread_;
+
   // Note: we should never manage peer's lifetime.
   std::weak_ptr<ChannelMem> peer_channel_;
   // message database related.
   std::mutex msg_mutex_;
   std::condition_variable msg_db_cond_;
   std::unordered_map<std::string, Buffer> recv_msgs_;
+  std::unordered_map<std::string, RecvCallback> recv_callbacks_;
 
   std::chrono::milliseconds recv_timeout_ms_ =
       3UL * 60 * std::chrono::milliseconds(1000);
@@ -95,4 +95,44 @@ TEST_F(ChannelMemTest, WaitFinishSync) {
   f_r.get();
 }
 
+TEST_F(ChannelMemTest, Emulation) {
+  EmulationOptions options;
+  // 80 Mbps, i.e. 10 bytes per us.
+  options.bandwidth_bps = 80'000'000;
+  options.latency_us = 20'000;
+  options.jitter_us = 1'000;
+  sender_->SetEmulation(options);
+  receiver_->SetEmulation(options);
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto elapsed_ms = [&] {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  };
+
+  // async send returns immediately, 200KB takes 20ms to depart.
+  for (size_t i = 0; i < 10; i++) {
+    sender_->SendAsync(fmt::format("key{}", i), Buffer(20'000));
+  }
+  EXPECT_LT(elapsed_ms(), 10);
+  for (size_t i = 0; i < 10; i++) {
+    EXPECT_EQ(receiver_->Recv(fmt::format("key{}", i)).size(), 20'000);
+  }
+  // 20ms bandwidth + 20ms latency + jitter
+  EXPECT_GE(elapsed_ms(), 40);
+  EXPECT_LT(elapsed_ms(), 40 + 200);
+
+  // sync send returns when delivered.
+  const auto sync_start = elapsed_ms();
+  receiver_->Send("pong", "x");
+  EXPECT_GE(elapsed_ms() - sync_start, 20);
+  EXPECT_EQ(std::string_view(sender_->Recv("pong")), "x");
+
+  auto f_s = std::async([&] { sender_->WaitLinkTaskFinish(); });
+  auto f_r = std::async([&] { receiver_->WaitLinkTaskFinish(); });
+  f_s.get();
+  f_r.get();
+}
+
 }  // namespace yacl::link::transport::test
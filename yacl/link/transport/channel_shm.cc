@@ -0,0 +1,554 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/transport/channel_shm.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include "yacl/base/exception.h"
+
+namespace yacl::link::transport {
+
+namespace {
+
+constexpr uint64_t kRingMagic = 0x474e495248534c59ULL;  // "YLSHRING"
+constexpr size_t kPageSize = 4096;
+// busy polls before sleeping on futex.
+constexpr size_t kSpinCount = 2000;
+// futex sleep slice, to check stop/timeout.
+constexpr int64_t kWaitSliceMs = 100;
+
+struct RecordHeader {
+  uint32_t type;
+  uint32_t key_len;
+  uint64_t payload_len;
+};
+
+void FutexWait(std::atomic<uint32_t>* addr, uint32_t expected,
+               int64_t timeout_ms) {
+  timespec ts;
+  ts.tv_sec = timeout_ms / 1000;
+  ts.tv_nsec = (timeout_ms % 1000) * 1000000;
+  // not FUTEX_PRIVATE_FLAG, the word is shared between processes.
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT, expected,
+          &ts, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t>* addr) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE, INT_MAX,
+          nullptr, nullptr, 0);
+}
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+size_t RoundUpPow2(size_t v) {
+  size_t ret = kPageSize;
+  while (ret < v) {
+    ret <<= 1;
+  }
+  return ret;
+}
+
+// map a shm segment, fd is closed.
+void* MapSegment(int fd, size_t size, const std::string& name) {
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    YACL_THROW_IO_ERROR("mmap shm {} failed, size={}, error={}", name, size,
+                        std::strerror(errno));
+  }
+  return addr;
+}
+
+}  // namespace
+
+struct ShmRing::Header {
+  uint64_t magic;
+  uint64_t capacity;
+  // consumer pid, producer rejects rings of dead consumers.
+  int64_t owner_pid;
+  // written by producer.
+  alignas(64) std::atomic<uint64_t> write_pos;
+  // futex word, bumped after each write.
+  std::atomic<uint32_t> write_seq;
+  std::atomic<uint32_t> reader_waiting;
+  // written by consumer.
+  alignas(64) std::atomic<uint64_t> read_pos;
+  // futex word, bumped after each read.
+  std::atomic<uint32_t> read_seq;
+  std::atomic<uint32_t> writer_waiting;
+  // set last by consumer, after all fields above are initialized.
+  alignas(64) std::atomic<uint32_t> ready;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "shared memory atomics should be lock free");
+
+ShmRing::ShmRing(std::string name, void* addr, size_t mapped_size, bool owner)
+    : name_(std::move(name)),
+      addr_(addr),
+      mapped_size_(mapped_size),
+      owner_(owner) {
+  header_ = static_cast<Header*>(addr_);
+  data_ = static_cast<uint8_t*>(addr_) + kPageSize;
+  capacity_ = mapped_size_ - kPageSize;
+}
+
+ShmRing::~ShmRing() {
+  if (addr_ != nullptr) {
+    munmap(addr_, mapped_size_);
+  }
+  if (owner_) {
+    shm_unlink(name_.c_str());
+  }
+}
+
+std::unique_ptr<ShmRing> ShmRing::Create(const std::string& name,
+                                         size_t capacity) {
+  static_assert(sizeof(Header) <= kPageSize);
+  capacity = RoundUpPow2(capacity);
+  const size_t mapped_size = kPageSize + capacity;
+
+  // remove stale one left by a crashed process.
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    YACL_THROW_IO_ERROR("create shm {} failed, error={}", name,
+                        std::strerror(errno));
+  }
+  if (ftruncate(fd, mapped_size) != 0) {
+    int err = errno;
+    close(fd);
+    shm_unlink(name.c_str());
+    YACL_THROW_IO_ERROR("resize shm {} failed, error={}", name,
+                        std::strerror(err));
+  }
+  void* addr = MapSegment(fd, mapped_size, name);
+  std::unique_ptr<ShmRing> ring(new ShmRing(name, addr, mapped_size, true));
+
+  auto* header = new (addr) Header();
+  header->magic = kRingMagic;
+  header->capacity = capacity;
+  header->owner_pid = getpid();
+  header->write_pos = 0;
+  header->write_seq = 0;
+  header->reader_waiting = 0;
+  header->read_pos = 0;
+  header->read_seq = 0;
+  header->writer_waiting = 0;
+  header->ready.store(1, std::memory_order_release);
+  return ring;
+}
+
+std::unique_ptr<ShmRing> ShmRing::Open(const std::string& name) {
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) <= kPageSize) {
+    // consumer is still initializing.
+    close(fd);
+    return nullptr;
+  }
+  void* addr = MapSegment(fd, st.st_size, name);
+  std::unique_ptr<ShmRing> ring(new ShmRing(name, addr, st.st_size, false));
+  const auto* header = ring->header_;
+  if (header->ready.load(std::memory_order_acquire) != 1 ||
+      header->magic != kRingMagic || header->capacity != ring->capacity_) {
+    return nullptr;
+  }
+  if (kill(static_cast<pid_t>(header->owner_pid), 0) != 0 && errno == ESRCH) {
+    // stale ring, wait consumer to replace it.
+    return nullptr;
+  }
+  return ring;
+}
+
+void ShmRing::CopyIn(uint64_t pos, const void* src, size_t len) {
+  const size_t offset = pos & (capacity_ - 1);
+  const size_t first = std::min(len, capacity_ - offset);
+  std::memcpy(data_ + offset, src, first);
+  if (first < len) {
+    std::memcpy(data_, static_cast<const uint8_t*>(src) + first, len - first);
+  }
+}
+
+void ShmRing::CopyOut(uint64_t pos, void* dst, size_t len) const {
+  const size_t offset = pos & (capacity_ - 1);
+  const size_t first = std::min(len, capacity_ - offset);
+  std::memcpy(dst, data_ + offset, first);
+  if (first < len) {
+    std::memcpy(static_cast<uint8_t*>(dst) + first, data_, len - first);
+  }
+}
+
+void ShmRing::Write(RecordType type, std::string_view key,
+                    ByteContainerView payload,
+                    std::chrono::milliseconds timeout) {
+  const size_t total = sizeof(RecordHeader) + key.size() + payload.size();
+  YACL_ENFORCE(total <= capacity_, "record size {} exceeds ring capacity {}",
+               total, capacity_);
+
+  const uint64_t write_pos = header_->write_pos.load(std::memory_order_relaxed);
+  auto has_room = [&] {
+    return capacity_ - (write_pos -
+                        header_->read_pos.load(std::memory_order_acquire)) >=
+           total;
+  };
+  if (!has_room()) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    size_t spin = 0;
+    while (!has_room()) {
+      if (spin++ < kSpinCount) {
+        CpuRelax();
+        continue;
+      }
+      if (std::chrono::steady_clock::now() > deadline) {
+        YACL_THROW_IO_ERROR("shm ring {} write timeout, peer is not reading",
+                            name_);
+      }
+      header_->writer_waiting.store(1);
+      const uint32_t seq = header_->read_seq.load();
+      if (!has_room()) {
+        FutexWait(&header_->read_seq, seq, kWaitSliceMs);
+      }
+      header_->writer_waiting.store(0);
+    }
+  }
+
+  RecordHeader record{type, static_cast<uint32_t>(key.size()),
+                      static_cast<uint64_t>(payload.size())};
+  CopyIn(write_pos, &record, sizeof(record));
+  CopyIn(write_pos + sizeof(record), key.data(), key.size());
+  CopyIn(write_pos + sizeof(record) + key.size(), payload.data(),
+         payload.size());
+  header_->write_pos.store(write_pos + total, std::memory_order_release);
+  header_->write_seq.fetch_add(1);
+  if (header_->reader_waiting.load() != 0) {
+    FutexWake(&header_->write_seq);
+  }
+}
+
+bool ShmRing::Read(RecordType* type, std::string* key, Buffer* payload,
+                   const std::atomic<bool>& stop) {
+  const uint64_t read_pos = header_->read_pos.load(std::memory_order_relaxed);
+  auto has_data = [&] {
+    return header_->write_pos.load(std::memory_order_acquire) != read_pos;
+  };
+  size_t spin = 0;
+  while (!has_data()) {
+    if (stop.load()) {
+      return false;
+    }
+    if (spin++ < kSpinCount) {
+      CpuRelax();
+      continue;
+    }
+    header_->reader_waiting.store(1);
+    const uint32_t seq = header_->write_seq.load();
+    if (!has_data() && !stop.load()) {
+      FutexWait(&header_->write_seq, seq, kWaitSliceMs);
+    }
+    header_->reader_waiting.store(0);
+  }
+
+  RecordHeader record;
+  CopyOut(read_pos, &record, sizeof(record));
+  key->resize(record.key_len);
+  CopyOut(read_pos + sizeof(record), key->data(), record.key_len);
+  *payload = Buffer(static_cast<int64_t>(record.payload_len));
+  CopyOut(read_pos + sizeof(record) + record.key_len, payload->data(),
+          record.payload_len);
+  *type = static_cast<RecordType>(record.type);
+
+  header_->read_pos.store(
+      read_pos + sizeof(record) + record.key_len + record.payload_len,
+      std::memory_order_release);
+  header_->read_seq.fetch_add(1);
+  if (header_->writer_waiting.load() != 0) {
+    FutexWake(&header_->read_seq);
+  }
+  return true;
+}
+
+uint64_t ShmRing::WritePos() const {
+  return header_->write_pos.load(std::memory_order_relaxed);
+}
+
+uint64_t ShmRing::ReadPos() const {
+  return header_->read_pos.load(std::memory_order_acquire);
+}
+
+bool ShmRing::OwnerAlive() const {
+  return kill(static_cast<pid_t>(header_->owner_pid), 0) == 0 ||
+         errno != ESRCH;
+}
+
+void ShmRing::WakeReader() {
+  header_->write_seq.fetch_add(1);
+  FutexWake(&header_->write_seq);
+}
+
+ChannelShm::ChannelShm(std::string session, size_t self_rank,
+                       size_t peer_rank, const ShmOptions& options,
+                       size_t timeout_ms)
+    : session_(std::move(session)),
+      self_rank_(self_rank),
+      peer_rank_(peer_rank),
+      options_(options),
+      recv_timeout_ms_(timeout_ms * std::chrono::milliseconds(1)) {
+  in_ring_ = ShmRing::Create(
+      fmt::format("{}-{}-{}", session_, peer_rank_, self_rank_),
+      options_.ring_bytes);
+  recv_thread_ = std::thread([this] { ReceiveLoop(); });
+}
+
+ChannelShm::~ChannelShm() {
+  StopReceiving();
+  // records left in our ring are never read now, unlink their segments so
+  // that they do not outlive both parties.
+  ShmRing::RecordType type;
+  std::string key;
+  Buffer payload;
+  while (in_ring_->Read(&type, &key, &payload, stop_receiving_)) {
+    if (type == ShmRing::kSegment && payload.size() > sizeof(uint64_t)) {
+      std::string name(payload.data<char>() + sizeof(uint64_t),
+                       payload.size() - sizeof(uint64_t));
+      shm_unlink(name.c_str());
+    }
+  }
+  // a live peer unlinks segments it has not read when it stops (as above),
+  // a dead one can not.
+  std::unique_lock lock(send_mutex_);
+  PruneSegments();
+  if (out_ring_ != nullptr && !out_ring_->OwnerAlive()) {
+    for (const auto& segment : segments_) {
+      shm_unlink(segment.second.c_str());
+    }
+  }
+}
+
+void ChannelShm::PruneSegments() {
+  if (out_ring_ == nullptr) {
+    return;
+  }
+  const uint64_t read_pos = out_ring_->ReadPos();
+  while (!segments_.empty() && segments_.front().first <= read_pos) {
+    segments_.pop_front();
+  }
+}
+
+void ChannelShm::StopReceiving() {
+  stop_receiving_ = true;
+  if (recv_thread_.joinable()) {
+    in_ring_->WakeReader();
+    recv_thread_.join();
+  }
+}
+
+void ChannelShm::ReceiveLoop() {
+  ShmRing::RecordType type;
+  std::string key;
+  Buffer payload;
+  while (in_ring_->Read(&type, &key, &payload, stop_receiving_)) {
+    if (type == ShmRing::kInline) {
+      OnMessage(key, std::move(payload));
+      continue;
+    }
+    YACL_ENFORCE(type == ShmRing::kSegment && payload.size() > 8,
+                 "unknown shm record type {}", static_cast<uint32_t>(type));
+    uint64_t size;
+    std::memcpy(&size, payload.data(), sizeof(size));
+    std::string name(payload.data<char>() + sizeof(size),
+                     payload.size() - sizeof(size));
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+      SPDLOG_ERROR("open shm segment {} failed, error={}, drop message {}",
+                   name, std::strerror(errno), key);
+      continue;
+    }
+    // the segment lives until the mapping is released.
+    shm_unlink(name.c_str());
+    void* addr = MapSegment(fd, size, name);
+    OnMessage(key, Buffer(addr, size, [size](void* p) { munmap(p, size); }));
+  }
+}
+
+bool ChannelShm::TryConnect() {
+  if (out_ring_ == nullptr) {
+    out_ring_ = ShmRing::Open(
+        fmt::format("{}-{}-{}", session_, self_rank_, peer_rank_));
+  }
+  return out_ring_ != nullptr;
+}
+
+void ChannelShm::SendImpl(const std::string& key, ByteContainerView value) {
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_lock lock(send_mutex_);
+  // peer may start later if ConnectToMesh is not called.
+  const auto deadline = start + recv_timeout_ms_;
+  while (!TryConnect()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      YACL_THROW_NETWORK_ERROR("shm peer rank={} is not started", peer_rank_);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  const size_t ring_limit = out_ring_->Capacity() / 2;
+  if (value.size() <= options_.large_message_bytes &&
+      value.size() + key.size() < ring_limit) {
+    out_ring_->Write(ShmRing::kInline, key, value, recv_timeout_ms_);
+  } else {
+    // write once into a dedicated segment, receiver maps it as the buffer.
+    const auto name = fmt::format("{}-{}-{}-{}", session_, self_rank_,
+                                  peer_rank_, segment_counter_++);
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      YACL_THROW_IO_ERROR("create shm {} failed, error={}", name,
+                          std::strerror(errno));
+    }
+    if (ftruncate(fd, value.size()) != 0) {
+      int err = errno;
+      close(fd);
+      shm_unlink(name.c_str());
+      YACL_THROW_IO_ERROR("resize shm {} failed, error={}", name,
+                          std::strerror(err));
+    }
+    void* addr = MapSegment(fd, value.size(), name);
+    std::memcpy(addr, value.data(), value.size());
+    munmap(addr, value.size());
+
+    std::string ref(sizeof(uint64_t) + name.size(), '\0');
+    const uint64_t size = value.size();
+    std::memcpy(ref.data(), &size, sizeof(size));
+    std::memcpy(ref.data() + sizeof(size), name.data(), name.size());
+    try {
+      out_ring_->Write(ShmRing::kSegment, key, ref, recv_timeout_ms_);
+    } catch (...) {
+      shm_unlink(name.c_str());
+      throw;
+    }
+    PruneSegments();
+    segments_.emplace_back(out_ring_->WritePos(), name);
+  }
+  lock.unlock();
+
+  if (key != kFinKey) {
+    peer_stats_->send_latency_ns.Record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  }
+}
+
+Buffer ChannelShm::Recv(const std::string& key) {
+  Buffer value;
+  {
+    std::unique_lock lock(msg_mutex_);
+    auto stop_waiting = [&] {
+      auto itr = this->recv_msgs_.find(key);
+      if (itr == this->recv_msgs_.end()) {
+        return false;
+      } else {
+        value = std::move(itr->second);
+        this->recv_msgs_.erase(itr);
+        return true;
+      }
+    };
+    if (!msg_db_cond_.wait_for(lock, recv_timeout_ms_, stop_waiting)) {
+      YACL_THROW_IO_ERROR("Get data timeout, key={}", key);
+    }
+  }
+
+  return value;
+}
+
+void ChannelShm::RecvAsync(const std::string& key, RecvCallback done) {
+  Buffer value;
+  {
+    std::unique_lock lock(msg_mutex_);
+    auto itr = recv_msgs_.find(key);
+    if (itr == recv_msgs_.end()) {
+      YACL_ENFORCE(recv_callbacks_.emplace(key, std::move(done)).second,
+                   "duplicated RecvAsync, key={}", key);
+      return;
+    }
+    value = std::move(itr->second);
+    recv_msgs_.erase(itr);
+  }
+  done(std::move(value));
+}
+
+void ChannelShm::OnMessage(const std::string& key, Buffer&& value) {
+  {
+    std::unique_lock lock(msg_mutex_);
+    auto itr = recv_callbacks_.find(key);
+    if (itr != recv_callbacks_.end()) {
+      auto done = std::move(itr->second);
+      recv_callbacks_.erase(itr);
+      done(std::move(value));
+      return;
+    }
+    recv_msgs_.emplace(key, std::move(value));
+  }
+  msg_db_cond_.notify_all();
+}
+
+void ChannelShm::TestSend(uint32_t /*timeout*/) {
+  {
+    std::unique_lock lock(send_mutex_);
+    if (!TryConnect()) {
+      YACL_THROW_NETWORK_ERROR("shm peer rank={} is not started", peer_rank_);
+    }
+  }
+  SendImpl(fmt::format("connect_{}", self_rank_), "");
+}
+
+void ChannelShm::TestRecv() { Recv(fmt::format("connect_{}", peer_rank_)); }
+
+void ChannelShm::WaitLinkTaskFinish() {
+  bool expect = false;
+  if (!finished_.compare_exchange_strong(expect, true)) {
+    return;
+  }
+
+  SendImpl(kFinKey, "");
+  auto recv = Recv(kFinKey);
+  recv.reset();
+}
+
+}  // namespace yacl::link::transport
@@ -0,0 +1,235 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "yacl/link/transport/channel.h"
+
+namespace yacl::link::transport {
+
+struct ShmOptions {
+  static constexpr size_t kDefaultRingBytes = 16UL << 20;
+  static constexpr size_t kDefaultLargeMessageBytes = 1UL << 20;
+
+  // ring buffer size of each direction, rounded up to power of 2.
+  size_t ring_bytes = kDefaultRingBytes;
+  // messages larger than this go through a dedicated shm segment, which is
+  // written once by sender and handed to receiver without copy.
+  size_t large_message_bytes = kDefaultLargeMessageBytes;
+};
+
+// Single producer single consumer byte ring in POSIX shared memory, waiters
+// are woken by futex on the shared counters, so no syscall while both sides
+// are busy.
+//
+// The consumer creates the ring (its inbound direction) and the producer
+// opens it by name. Records are {type, key length, payload length, key,
+// payload}, wrapped around the ring end.
+class ShmRing {
+ public:
+  enum RecordType : uint32_t {
+    kInline = 1,
+    // payload is {uint64 size, segment name}
+    kSegment = 2,
+  };
+
+  struct Header;
+
+  ~ShmRing();
+
+  ShmRing(const ShmRing&) = delete;
+  ShmRing& operator=(const ShmRing&) = delete;
+
+  // create (or replace a stale one) as consumer.
+  static std::unique_ptr<ShmRing> Create(const std::string& name,
+                                         size_t capacity);
+
+  // open as producer, return nullptr if consumer has not created it yet.
+  static std::unique_ptr<ShmRing> Open(const std::string& name);
+
+  // max size of a record.
+  size_t Capacity() const { return capacity_; }
+
+  // block until there is room for the record, throw on timeout.
+  void Write(RecordType type, std::string_view key, ByteContainerView payload,
+             std::chrono::milliseconds timeout);
+
+  // block until a record is read or stop is set (return false).
+  bool Read(RecordType* type, std::string* key, Buffer* payload,
+            const std::atomic<bool>& stop);
+
+  // wake the consumer blocked in Read, e.g. for stop.
+  void WakeReader();
+
+  const std::string& Name() const { return name_; }
+
+  // producer side: end of written records.
+  uint64_t WritePos() const;
+  // producer side: records before it are taken by consumer.
+  uint64_t ReadPos() const;
+  // false if the consumer process is gone.
+  bool OwnerAlive() const;
+
+ private:
+  ShmRing(std::string name, void* addr, size_t mapped_size, bool owner);
+
+  void CopyIn(uint64_t pos, const void* src, size_t len);
+  void CopyOut(uint64_t pos, void* dst, size_t len) const;
+
+  std::string name_;
+  void* addr_ = nullptr;
+  size_t mapped_size_ = 0;
+  // consumer unlinks the name on destruction.
+  bool owner_ = false;
+
+  Header* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+  size_t capacity_ = 0;
+};
+
+// A channel between co-located parties, each direction is a ShmRing
+// (self -> peer ring is created by peer).
+class ChannelShm final : public IChannel {
+ public:
+  // ring names are "{session}-{src rank}-{dst rank}".
+  ChannelShm(std::string session, size_t self_rank, size_t peer_rank,
+             const ShmOptions& options, size_t timeout_ms = 20000U);
+
+  ~ChannelShm() override;
+
+  void SendAsync(const std::string& key, ByteContainerView value) final {
+    SendImpl(key, value);
+  }
+
+  void SendAsync(const std::string& key, Buffer&& value) final {
+    SendImpl(key, value);
+  }
+
+  void SendAsyncThrottled(const std::string& key, Buffer&& value) final {
+    SendImpl(key, value);
+  }
+
+  void SendAsyncThrottled(const std::string& key,
+                          ByteContainerView value) final {
+    SendImpl(key, value);
+  }
+
+  // return when the message is in peer's ring.
+  void Send(const std::string& key, ByteContainerView value) final {
+    SendImpl(key, value);
+  }
+
+  Buffer Recv(const std::string& key) final;
+
+  void RecvAsync(const std::string& key, RecvCallback done) final;
+
+  void OnMessage(const std::string& key, ByteContainerView value) final {
+    OnMessage(key, Buffer(value));
+  }
+
+  void OnMessage(const std::string& key, Buffer&& value);
+
+  void SetRecvTimeout(uint64_t timeout_ms) final {
+    recv_timeout_ms_ = timeout_ms * std::chrono::milliseconds(1);
+  }
+
+  uint64_t GetRecvTimeout() const final { return recv_timeout_ms_.count(); }
+
+  void WaitLinkTaskFinish() final;
+
+  // open peer's ring and send a dummy msg, throw NetworkError if peer is not
+  // started yet.
+  void TestSend(uint32_t timeout) final;
+
+  // wait for dummy msg from peer.
+  void TestRecv() final;
+
+  // do nothing, the ring itself throttles the sender.
+  void SetThrottleWindowSize(size_t) final {}
+  void SetChunkParallelSendSize(size_t) final {}
+
+  // stop receiving thread, called by receiver loop.
+  void StopReceiving();
+
+ private:
+  void SendImpl(const std::string& key, ByteContainerView value);
+  // forget segments the peer has taken (it unlinks them).
+  void PruneSegments();
+  bool TryConnect();
+  void ReceiveLoop();
+
+  const std::string session_;
+  const size_t self_rank_;
+  const size_t peer_rank_;
+  const ShmOptions options_;
+
+  // peer -> self
+  std::unique_ptr<ShmRing> in_ring_;
+  std::thread recv_thread_;
+  std::atomic<bool> stop_receiving_ = false;
+
+  // self -> peer, opened by TestSend or first send.
+  std::mutex send_mutex_;
+  std::unique_ptr<ShmRing> out_ring_;
+  size_t segment_counter_ = 0;
+  // {ring position after the record, name} of segments not taken by peer
+  // yet, in send order. unlinked by destructor if peer is gone, otherwise
+  // peer unlinks unread ones when it stops.
+  std::deque<std::pair<uint64_t, std::string>> segments_;
+
+  // message database related.
+  std::mutex msg_mutex_;
+  std::condition_variable msg_db_cond_;
+  std::unordered_map<std::string, Buffer> recv_msgs_;
+  std::unordered_map<std::string, RecvCallback> recv_callbacks_;
+
+  std::chrono::milliseconds recv_timeout_ms_ =
+      3UL * 60 * std::chrono::milliseconds(1000);
+
+  std::atomic<bool> finished_{false};
+  inline static const std::string kFinKey = "_fin_";
+};
+
+class ReceiverLoopShm final : public IReceiverLoop {
+ public:
+  ~ReceiverLoopShm() override { Stop(); }
+
+  void AddChannel(std::shared_ptr<ChannelShm> channel) {
+    channels_.push_back(std::move(channel));
+  }
+
+  void Stop() override {
+    for (auto& channel : channels_) {
+      channel->StopReceiving();
+    }
+  }
+
+ private:
+  std::vector<std::shared_ptr<ChannelShm>> channels_;
+};
+
+}  // namespace yacl::link::transport
@@ -0,0 +1,169 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/transport/channel_shm.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <future>
+#include <memory>
+#include <string>
+
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace yacl::link::transport::test {
+
+class ChannelShmTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    static int session_count = 0;
+    const auto session =
+        fmt::format("/yacl-test-{}-{}", getpid(), session_count++);
+    ShmOptions options;
+    // small ring to test wrap around & back pressure.
+    options.ring_bytes = 64 << 10;
+    options.large_message_bytes = 16 << 10;
+    sender_ = std::make_shared<ChannelShm>(session, 0, 1, options);
+    receiver_ = std::make_shared<ChannelShm>(session, 1, 0, options);
+  }
+
+  void TearDown() override {
+    auto f_s = std::async([&] { sender_->WaitLinkTaskFinish(); });
+    auto f_r = std::async([&] { receiver_->WaitLinkTaskFinish(); });
+    f_s.get();
+    f_r.get();
+  }
+
+  std::shared_ptr<ChannelShm> sender_;
+  std::shared_ptr<ChannelShm> receiver_;
+};
+
+TEST_F(ChannelShmTest, Normal) {
+  sender_->TestSend(0);
+  receiver_->TestRecv();
+
+  const std::string key = "key";
+  const std::string sent = "test";
+  sender_->SendAsync(key, ByteContainerView{sent});
+  auto received = receiver_->Recv(key);
+  EXPECT_EQ(sent, std::string_view(received));
+
+  receiver_->Send("empty", "");
+  EXPECT_EQ(sender_->Recv("empty").size(), 0);
+}
+
+TEST_F(ChannelShmTest, ManyMessages) {
+  // 4MB in total through a 64KB ring, receiver is slower than sender.
+  const size_t kNum = 1000;
+  auto send = std::async([&] {
+    for (size_t i = 0; i < kNum; i++) {
+      sender_->SendAsync(fmt::format("key{}", i),
+                         std::string(4000 + i % 7, static_cast<char>(i)));
+    }
+  });
+  for (size_t i = 0; i < kNum; i++) {
+    auto received = receiver_->Recv(fmt::format("key{}", i));
+    EXPECT_EQ(std::string_view(received),
+              std::string(4000 + i % 7, static_cast<char>(i)));
+  }
+  send.get();
+}
+
+TEST_F(ChannelShmTest, LargeMessage) {
+  std::string sent(1 << 20, 'x');
+  sent[12345] = 'y';
+  sender_->Send("large", sent);
+  {
+    auto received = receiver_->Recv("large");
+    EXPECT_EQ(std::string_view(received), sent);
+  }
+
+  // larger than ring.
+  std::string huge(1 << 22, 'z');
+  receiver_->SendAsync("huge", huge);
+  EXPECT_EQ(std::string_view(sender_->Recv("huge")), huge);
+}
+
+namespace {
+
+bool SegmentExists(const std::string& session, size_t src, size_t dst,
+                   size_t index) {
+  const auto name = fmt::format("{}-{}-{}-{}", session, src, dst, index);
+  int fd = shm_open(name.c_str(), O_RDONLY, 0600);
+  if (fd < 0) {
+    return false;
+  }
+  close(fd);
+  return true;
+}
+
+}  // namespace
+
+TEST(ChannelShmSegmentTest, UnlinkedByStoppedReceiver) {
+  const auto session = fmt::format("/yacl-test-seg-{}", getpid());
+  ShmOptions options;
+  options.large_message_bytes = 1 << 10;
+  auto sender = std::make_unique<ChannelShm>(session, 0, 1, options);
+  auto receiver = std::make_unique<ChannelShm>(session, 1, 0, options);
+  receiver->StopReceiving();
+
+  sender->Send("large", std::string(1 << 16, 'x'));
+  EXPECT_TRUE(SegmentExists(session, 0, 1, 0));
+  // never read by receiver.
+  receiver.reset();
+  EXPECT_FALSE(SegmentExists(session, 0, 1, 0));
+  sender.reset();
+}
+
+TEST(ChannelShmSegmentTest, UnlinkedBySenderIfReceiverIsGone) {
+  const auto session = fmt::format("/yacl-test-seg-dead-{}", getpid());
+  ShmOptions options;
+  options.large_message_bytes = 1 << 10;
+  int ready[2];
+  int sent[2];
+  ASSERT_EQ(pipe(ready), 0);
+  ASSERT_EQ(pipe(sent), 0);
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // receiver dies without reading or cleaning up.
+    ChannelShm receiver(session, 1, 0, options);
+    receiver.StopReceiving();
+    char c = 0;
+    (void)!write(ready[1], &c, 1);
+    (void)!read(sent[0], &c, 1);
+    _exit(0);
+  }
+  char c = 0;
+  ASSERT_EQ(read(ready[0], &c, 1), 1);
+  auto sender = std::make_unique<ChannelShm>(session, 0, 1, options);
+  sender->Send("large", std::string(1 << 16, 'x'));
+  EXPECT_TRUE(SegmentExists(session, 0, 1, 0));
+  ASSERT_EQ(write(sent[1], &c, 1), 1);
+  ASSERT_EQ(waitpid(pid, nullptr, 0), pid);
+
+  sender.reset();
+  EXPECT_FALSE(SegmentExists(session, 0, 1, 0));
+  // ring left by the dead receiver.
+  shm_unlink(fmt::format("{}-0-1", session).c_str());
+  for (int fd : {ready[0], ready[1], sent[0], sent[1]}) {
+    close(fd);
+  }
+}
+
+}  // namespace yacl::link::transport::test
@@ -14,10 +14,15 @@
 
 #include "yacl/link/transport/channel.h"
 
+#include <chrono>
+#include <future>
+
 #include "fmt/format.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "yacl/link/future.h"
+
 #include "brpc/errno.pb.h"
 #include "interconnection/link/transport.pb.h"
 
@@ -216,4 +221,177 @@ TEST_F(ChannelSendRetryTest, ChunkedRetrySuccess) {
   sender_->Send(key, RandStr(3));
 }
 
+// delivers requests to peer channel directly and counts them.
+class LoopbackLink : public TransportLink {
+ public:
+  using TransportLink::TransportLink;
+
+  void SetPeer(const std::shared_ptr<Channel>& peer) { peer_ = peer; }
+  size_t NumRequests() const { return num_requests_; }
+
+  size_t GetMaxBytesPerChunk() const override { return 1024; }
+  void SetMaxBytesPerChunk(size_t) override {}
+  std::unique_ptr<Request> PackMonoRequest(
+      const std::string& key, ByteContainerView value) const override {
+    auto request = std::make_unique<ic_pb::PushRequest>();
+    request->set_sender_rank(self_rank_);
+    request->set_key(key);
+    request->set_value(value.data(), value.size());
+    request->set_trans_type(ic_pb::TransType::MONO);
+    return request;
+  }
+  std::unique_ptr<Request> PackChunkedRequest(
+      const std::string& key, ByteContainerView value, size_t offset,
+      size_t total_length) const override {
+    auto request = std::make_unique<ic_pb::PushRequest>();
+    request->set_sender_rank(self_rank_);
+    request->set_key(key);
+    request->set_value(value.data(), value.size());
+    request->set_trans_type(ic_pb::TransType::CHUNKED);
+    request->mutable_chunk_info()->set_chunk_offset(offset);
+    request->mutable_chunk_info()->set_message_length(total_length);
+    return request;
+  }
+  void UnpackMonoRequest(const Request& request, std::string* key,
+                         ByteContainerView* value) const override {
+    const auto& req = static_cast<const ic_pb::PushRequest&>(request);
+    *key = req.key();
+    *value = req.value();
+  }
+  void UnpackChunckRequest(const Request& request, std::string* key,
+                           ByteContainerView* value, size_t* offset,
+                           size_t* total_length) const override {
+    const auto& req = static_cast<const ic_pb::PushRequest&>(request);
+    *key = req.key();
+    *value = req.value();
+    *offset = req.chunk_info().chunk_offset();
+    *total_length = req.chunk_info().message_length();
+  }
+  void FillResponseOk(const Request&, Response*) const override {}
+  void FillResponseError(const Request&, Response*) const override {}
+  bool IsChunkedRequest(const Request& request) const override {
+    return static_cast<const ic_pb::PushRequest&>(request).trans_type() ==
+           ic_pb::TransType::CHUNKED;
+  }
+  bool IsMonoRequest(const Request& request) const override {
+    return static_cast<const ic_pb::PushRequest&>(request).trans_type() ==
+           ic_pb::TransType::MONO;
+  }
+  void SendRequest(const Request& request, uint32_t) const override {
+    num_requests_++;
+    ic_pb::PushResponse response;
+    peer_.lock()->OnRequest(request, &response);
+  }
+
+ private:
+  std::weak_ptr<Channel> peer_;
+  mutable std::atomic<size_t> num_requests_ = 0;
+};
+
+class ChannelCoalesceTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    link0_ = std::make_shared<LoopbackLink>(0, 1);
+    link1_ = std::make_shared<LoopbackLink>(1, 0);
+    channel0_ = std::make_shared<Channel>(link0_, false, RetryOptions());
+    channel1_ = std::make_shared<Channel>(link1_, false, RetryOptions());
+    link0_->SetPeer(channel1_);
+    link1_->SetPeer(channel0_);
+  }
+
+  void TearDown() override {
+    auto f = std::async([&] { channel0_->WaitLinkTaskFinish(); });
+    channel1_->WaitLinkTaskFinish();
+    f.get();
+  }
+
+  std::shared_ptr<LoopbackLink> link0_;
+  std::shared_ptr<LoopbackLink> link1_;
+  std::shared_ptr<Channel> channel0_;
+  std::shared_ptr<Channel> channel1_;
+};
+
+TEST_F(ChannelCoalesceTest, SmallMessages) {
+  // wide window, so all msgs below are pushed within it.
+  channel0_->SetCoalesce(64, 10 * 1000);
+  const size_t n = 100;
+  std::vector<std::string> values(n);
+  for (size_t i = 0; i < n; i++) {
+    // a large one in the middle ends the batch and is chunked.
+    values[i] = RandStr(i == n / 2 ? 3000 : i % 64);
+    channel0_->SendAsync(fmt::format("key_{}", i), values[i]);
+  }
+  for (size_t i = 0; i < n; i++) {
+    auto value = channel1_->Recv(fmt::format("key_{}", i));
+    EXPECT_EQ(std::string(value.data<char>(), value.size()), values[i]);
+  }
+  // 3 chunks of the large msg, at most a few batches for the others.
+  EXPECT_LT(link0_->NumRequests(), 10);
+}
+
+TEST_F(ChannelCoalesceTest, SyncSend) {
+  channel0_->SetCoalesce(64, 100);
+  for (size_t i = 0; i < 10; i++) {
+    channel0_->SendAsync(fmt::format("async_{}", i), "a");
+    channel0_->Send(fmt::format("sync_{}", i), "b");
+  }
+  for (size_t i = 0; i < 10; i++) {
+    auto async_value = channel1_->Recv(fmt::format("async_{}", i));
+    auto sync_value = channel1_->Recv(fmt::format("sync_{}", i));
+    EXPECT_EQ(std::string(async_value.data<char>(), async_value.size()), "a");
+    EXPECT_EQ(std::string(sync_value.data<char>(), sync_value.size()), "b");
+  }
+}
+
+// RecvAsync through Channel::OnNormalMessage, callbacks run under the message
+// lock right after the ack is queued.
+using ChannelRecvAsyncTest = ChannelCoalesceTest;
+
+TEST_F(ChannelRecvAsyncTest, Callback) {
+  auto to_string = [](const Buffer& v) {
+    return std::string(v.data<char>(), v.size());
+  };
+
+  // registered before arrival.
+  std::promise<std::string> early;
+  channel1_->RecvAsync("early", [&](Buffer&& v) {
+    early.set_value(to_string(v));
+  });
+  channel0_->SendAsync("early", "a");
+  auto early_value = early.get_future();
+  ASSERT_EQ(early_value.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+  EXPECT_EQ(early_value.get(), "a");
+
+  // arrived before registration, run in place.
+  channel0_->Send("late", "b");
+  std::string late;
+  channel1_->RecvAsync("late", [&](Buffer&& v) { late = to_string(v); });
+  EXPECT_EQ(late, "b");
+
+  // a callback may reply.
+  channel1_->RecvAsync("req", [&](Buffer&& v) {
+    channel1_->SendAsync("rsp", to_string(v) + "c");
+  });
+  channel0_->SendAsync("req", "x");
+  EXPECT_EQ(to_string(channel0_->Recv("rsp")), "xc");
+}
+
+TEST_F(ChannelRecvAsyncTest, LoopGoneBeforeArrival) {
+  Future<Buffer> future;
+  channel1_->RecvAsync("key", [future](Buffer&& v) mutable {
+    future.SetValue(std::move(v));
+  });
+  bool called = false;
+  {
+    EventLoop loop;
+    future.Then(&loop, [&](Buffer&&) { called = true; });
+    EXPECT_THROW(loop.Run(1), IoError);
+  }
+  // delivered after the loop gave up & is destroyed.
+  channel0_->Send("key", "v");
+  EXPECT_FALSE(called);
+  EXPECT_TRUE(future.Ready());
+}
+
 }  // namespace yacl::link::transport::test
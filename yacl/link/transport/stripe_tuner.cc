@@ -0,0 +1,124 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/transport/stripe_tuner.h"
+
+#include <algorithm>
+
+#include "yacl/base/exception.h"
+
+namespace yacl::link::transport {
+
+StripeTuner::StripeTuner(size_t max_streams, bool adaptive,
+                         size_t sample_bytes)
+    : max_streams_(max_streams),
+      adaptive_(adaptive),
+      sample_bytes_(sample_bytes),
+      streams_(adaptive ? 1 : max_streams),
+      throughput_(max_streams + 1, 0) {
+  YACL_ENFORCE(max_streams_ > 0, "max streams should be positive");
+  // probe up on the first sample.
+  samples_since_probe_ = kReprobeSamples - 1;
+}
+
+void StripeTuner::OnRequestStart() {
+  if (!adaptive_) {
+    return;
+  }
+  std::unique_lock lock(mutex_);
+  if (in_flight_++ == 0) {
+    busy_start_ = Clock::now();
+  }
+}
+
+void StripeTuner::OnRequestDone(size_t bytes) {
+  if (!adaptive_) {
+    return;
+  }
+  std::unique_lock lock(mutex_);
+  const auto now = Clock::now();
+  sample_bytes_done_ += bytes;
+  if (--in_flight_ == 0) {
+    busy_time_ += now - busy_start_;
+  }
+  if (sample_bytes_done_ < sample_bytes_) {
+    return;
+  }
+  auto busy = busy_time_;
+  if (in_flight_ != 0) {
+    busy += now - busy_start_;
+    busy_start_ = now;
+  }
+  const double seconds = std::chrono::duration<double>(busy).count();
+  const double throughput =
+      seconds > 0 ? static_cast<double>(sample_bytes_done_) / seconds : 0;
+  sample_bytes_done_ = 0;
+  busy_time_ = Clock::duration(0);
+  lock.unlock();
+
+  if (throughput > 0) {
+    OnSample(throughput);
+  }
+}
+
+size_t StripeTuner::Step(size_t streams, bool up) const {
+  return up ? std::min(max_streams_, streams * 2)
+            : std::max<size_t>(1, streams / 2);
+}
+
+void StripeTuner::OnSample(double throughput) {
+  if (!adaptive_) {
+    return;
+  }
+  std::unique_lock lock(mutex_);
+  size_t cur = streams_.load(std::memory_order_relaxed);
+  auto& ewma = throughput_[cur];
+  ewma = ewma == 0 ? throughput : 0.5 * ewma + 0.5 * throughput;
+
+  if (probe_from_ != 0) {
+    if (throughput_[cur] > throughput_[probe_from_] * (1 + kMinGain)) {
+      // keep going.
+      const size_t next = Step(cur, probe_up_);
+      if (next != cur) {
+        probe_from_ = cur;
+        streams_.store(next, std::memory_order_relaxed);
+        return;
+      }
+    } else {
+      streams_.store(probe_from_, std::memory_order_relaxed);
+    }
+    probe_from_ = 0;
+    samples_since_probe_ = 0;
+    return;
+  }
+
+  if (++samples_since_probe_ < kReprobeSamples) {
+    return;
+  }
+  samples_since_probe_ = 0;
+  probe_up_ = next_probe_up_;
+  size_t next = Step(cur, probe_up_);
+  if (next == cur) {
+    probe_up_ = !probe_up_;
+    next = Step(cur, probe_up_);
+  }
+  if (next != cur) {
+    probe_from_ = cur;
+    streams_.store(next, std::memory_order_relaxed);
+  }
+  // next probe goes the other way.
+  next_probe_up_ = !probe_up_;
+}
+
+}  // namespace yacl::link::transport
@@ -0,0 +1,83 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace yacl::link::transport {
+
+// Chooses over how many connections the chunks of large messages are striped.
+//
+// Throughput is sampled from chunked requests only, over the time at least one
+// of them is in flight, so idle time of the application does not count. The
+// number of streams hill climbs in powers of 2: a probe is kept if it beats
+// the previous number by kMinGain, otherwise reverted, and is retried every
+// kReprobeSamples samples in alternating directions since link conditions
+// change.
+class StripeTuner {
+ public:
+  static constexpr size_t kDefaultSampleBytes = 32UL << 20;
+  static constexpr size_t kReprobeSamples = 16;
+  static constexpr double kMinGain = 0.1;
+
+  // adaptive = false always uses max_streams.
+  StripeTuner(size_t max_streams, bool adaptive,
+              size_t sample_bytes = kDefaultSampleBytes);
+
+  size_t MaxStreams() const { return max_streams_; }
+
+  // number of streams to use now, in [1, MaxStreams()].
+  size_t Streams() const { return streams_.load(std::memory_order_relaxed); }
+
+  // called around each chunked request.
+  void OnRequestStart();
+  void OnRequestDone(size_t bytes);
+
+  // feed a throughput sample (bytes per second) directly, for test.
+  void OnSample(double throughput);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  size_t Step(size_t streams, bool up) const;
+
+  const size_t max_streams_;
+  const bool adaptive_;
+  const size_t sample_bytes_;
+
+  std::atomic<size_t> streams_;
+
+  std::mutex mutex_;
+  // busy time accounting.
+  size_t in_flight_ = 0;
+  Clock::time_point busy_start_;
+  Clock::duration busy_time_{0};
+  size_t sample_bytes_done_ = 0;
+
+  // hill climbing, ewma throughput of each streams number.
+  std::vector<double> throughput_;
+  // streams before current probe, 0 if not probing.
+  size_t probe_from_ = 0;
+  // direction of current probe & next one.
+  bool probe_up_ = true;
+  bool next_probe_up_ = true;
+  size_t samples_since_probe_ = 0;
+};
+
+}  // namespace yacl::link::transport
@@ -0,0 +1,84 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yacl/link/transport/stripe_tuner.h"
+
+#include <algorithm>
+#include <map>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace yacl::link::transport::test {
+
+TEST(StripeTunerTest, Fixed) {
+  StripeTuner tuner(8, false);
+  EXPECT_EQ(tuner.Streams(), 8);
+  tuner.OnSample(100);
+  tuner.OnRequestStart();
+  tuner.OnRequestDone(1 << 30);
+  EXPECT_EQ(tuner.Streams(), 8);
+}
+
+TEST(StripeTunerTest, ClimbToSaturation) {
+  // a single flow gets 100, saturated at 4 flows.
+  auto link = [](size_t streams) {
+    return 100.0 * static_cast<double>(std::min<size_t>(streams, 4));
+  };
+
+  StripeTuner tuner(16, true);
+  EXPECT_EQ(tuner.Streams(), 1);
+  std::map<size_t, size_t> used;
+  for (size_t i = 0; i < 400; i++) {
+    used[tuner.Streams()]++;
+    tuner.OnSample(link(tuner.Streams()));
+  }
+  EXPECT_EQ(tuner.Streams(), 4);
+  // mostly settled, with a probe every kReprobeSamples samples.
+  EXPECT_GT(used[4], 400 * 8 / 10);
+}
+
+TEST(StripeTunerTest, FollowChange) {
+  StripeTuner tuner(16, true);
+  for (size_t i = 0; i < 100; i++) {
+    tuner.OnSample(100.0 * std::min<size_t>(tuner.Streams(), 8));
+  }
+  EXPECT_EQ(tuner.Streams(), 8);
+  // e.g. peer is cpu bound now, more flows only add overhead.
+  for (size_t i = 0; i < 200; i++) {
+    tuner.OnSample(100.0 / static_cast<double>(tuner.Streams()));
+  }
+  EXPECT_LE(tuner.Streams(), 2);
+}
+
+TEST(StripeTunerTest, BusyTime) {
+  StripeTuner tuner(4, true, 1000);
+  auto send = [&](size_t busy_ms, size_t idle_ms) {
+    for (size_t i = 0; i < 2; i++) {
+      tuner.OnRequestStart();
+      std::this_thread::sleep_for(std::chrono::milliseconds(busy_ms));
+      tuner.OnRequestDone(500);
+      // idle time is not counted.
+      std::this_thread::sleep_for(std::chrono::milliseconds(idle_ms));
+    }
+  };
+  // first sample triggers a probe.
+  send(20, 0);
+  EXPECT_EQ(tuner.Streams(), 2);
+  // 2x faster when busy, although the app is idle mostly.
+  send(10, 50);
+  EXPECT_EQ(tuner.Streams(), 4);
+}
+
+}  // namespace yacl::link::transport::test
@@ -16,6 +16,7 @@
 
 #include "benchmark/benchmark.h"
 
+#include "yacl/io/msgpack/buffer.h"
 #include "yacl/math/mpint/mp_int.h"
 
 namespace yacl::math::bench {
@@ -81,10 +82,56 @@ static void BM_MPIntPackingUsingToBytes(benchmark::State& state) {
       bytes_written / mp_ints.size() / state.iterations();
 }
 
+// pack the whole vector, as most protocols do.
+static void BM_MPIntArrayPackingUsingMsgpack(benchmark::State& state) {
+  int64_t bytes_written = 0;
+  for (auto _ : state) {
+    yacl::Buffer buf;
+    io::StreamBuffer sbuf(&buf);
+    msgpack::pack(sbuf, mp_ints);
+    bytes_written += buf.size();
+  }
+  state.counters["bytes_written"] = bytes_written / state.iterations();
+}
+
+static void BM_MPIntArrayPackingUsingSerializeArray(benchmark::State& state) {
+  int64_t bytes_written = 0;
+  for (auto _ : state) {
+    auto buf = MPInt::SerializeArray(mp_ints);
+    bytes_written += buf.size();
+  }
+  state.counters["bytes_written"] = bytes_written / state.iterations();
+}
+
+static void BM_MPIntArrayUnpackingUsingMsgpack(benchmark::State& state) {
+  auto buf = MPInt::SerializeArray(mp_ints);
+  for (auto _ : state) {
+    std::vector<MPInt> res;
+    auto oh = msgpack::unpack(buf.data<char>(), buf.size());
+    oh.get().convert(res);
+    benchmark::DoNotOptimize(res);
+  }
+}
+
+static void BM_MPIntArrayUnpackingUsingDeserializeArray(
+    benchmark::State& state) {
+  auto buf = MPInt::SerializeArray(mp_ints);
+  for (auto _ : state) {
+    auto res = MPInt::DeserializeArray(buf);
+    benchmark::DoNotOptimize(res);
+  }
+}
+
 BENCHMARK(BM_MPIntPackingUsingSerialize)->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_MPIntPackingUsingDeserialize)->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_MPIntPackingUsingToHexString)->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_MPIntPackingUsingToBytes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MPIntArrayPackingUsingMsgpack)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MPIntArrayPackingUsingSerializeArray)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MPIntArrayUnpackingUsingMsgpack)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MPIntArrayUnpackingUsingDeserializeArray)
+    ->Unit(benchmark::kMillisecond);
 
 }  // namespace yacl::math::bench
 
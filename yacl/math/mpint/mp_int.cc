@@ -14,6 +14,7 @@
 
 #include "yacl/math/mpint/mp_int.h"
 
+#include "yacl/io/msgpack/spec_traits.h"
 #include "yacl/math/mpint/tommath_ext_features.h"
 #include "yacl/math/mpint/tommath_ext_types.h"
 
@@ -657,6 +658,47 @@ void MPInt::Deserialize(yacl::ByteContainerView buffer) {
   mpx_deserialize(&n_, buffer.data(), buffer.size());
 }
 
+yacl::Buffer MPInt::SerializeArray(absl::Span<const MPInt> mps) {
+  yacl::Buffer buffer(SerializeArray(mps, nullptr, 0));
+  SerializeArray(mps, buffer.data<uint8_t>(), buffer.size());
+  return buffer;
+}
+
+size_t MPInt::SerializeArray(absl::Span<const MPInt> mps, uint8_t *buf,
+                             size_t buf_len) {
+  // pass 1: exact size
+  size_t total_buf = io::msgpack_traits::HeadSizeOfArray(mps.size());
+  for (const auto &mp : mps) {
+    auto body_sz = mpx_serialize_size(mp.n_);
+    total_buf += io::msgpack_traits::HeadSizeOfStr(body_sz) + body_sz;
+  }
+  if (buf == nullptr) {
+    return total_buf;
+  }
+  YACL_ENFORCE(buf_len >= total_buf,
+               "buf is too small, min required={}, actual={}", total_buf,
+               buf_len);
+
+  // pass 2: write in place
+  auto *pos = reinterpret_cast<char *>(buf);
+  pos += io::msgpack_traits::WriteArrayHead(mps.size(), pos);
+  for (const auto &mp : mps) {
+    auto body_sz = mpx_serialize_size(mp.n_);
+    pos += io::msgpack_traits::WriteStrHead(body_sz, pos);
+    pos += mpx_serialize(mp.n_, reinterpret_cast<uint8_t *>(pos), body_sz);
+  }
+  return total_buf;
+}
+
+std::vector<MPInt> MPInt::DeserializeArray(yacl::ByteContainerView buffer) {
+  size_t pos = 0;
+  std::vector<MPInt> mps(io::msgpack_traits::ReadArrayHead(buffer, &pos));
+  for (auto &mp : mps) {
+    mp.Deserialize(io::msgpack_traits::ReadStr(buffer, &pos));
+  }
+  return mps;
+}
+
 yacl::Buffer MPInt::ToBytes(size_t byte_len, Endian endian) const {
   yacl::Buffer buf(byte_len);
   ToBytes(buf.data<unsigned char>(), byte_len, endian);
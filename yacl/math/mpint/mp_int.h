@@ -17,7 +17,9 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
+#include "absl/types/span.h"
 #include "libtommath/tommath.h"
 #include "msgpack.hpp"
 
@@ -312,6 +314,21 @@ class MPInt {
   size_t Serialize(uint8_t *buf, size_t buf_len) const;
 
   void Deserialize(yacl::ByteContainerView buffer);
+
+  // Serialize mpints as a msgpack array of str, same bytes as msgpack::pack of
+  // std::vector<MPInt>. Sizes are computed first so the output is allocated
+  // once and every mpint is serialized in place.
+  [[nodiscard]] static yacl::Buffer SerializeArray(
+      absl::Span<const MPInt> mps);
+  // if buf is nullptr, then calc serialize size only
+  // @return: the actual size of serialized buffer
+  // @throw: if buf_len is too small, an exception will be thrown
+  static size_t SerializeArray(absl::Span<const MPInt> mps, uint8_t *buf,
+                               size_t buf_len);
+  // Deserialize output of SerializeArray (or msgpack::pack of
+  // std::vector<MPInt>) directly from buffer, without msgpack object copies.
+  static std::vector<MPInt> DeserializeArray(yacl::ByteContainerView buffer);
+
   [[nodiscard]] std::string ToString() const;
   [[nodiscard]] std::string ToHexString() const;
 
@@ -418,7 +435,17 @@ MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
     template <typename Stream>
     msgpack::packer<Stream> &operator()(msgpack::packer<Stream> &object,
                                         const yacl::math::MPInt &mp) const {
-      object.pack(std::string_view(mp.Serialize()));
+      // serialize on stack, avoid a temp Buffer per mpint.
+      constexpr size_t kStackBufSize = 1024;
+      size_t size = mp.Serialize(nullptr, 0);
+      if (size > kStackBufSize) {
+        object.pack(std::string_view(mp.Serialize()));
+        return object;
+      }
+      uint8_t buf[kStackBufSize];
+      mp.Serialize(buf, size);
+      object.pack_str(size);
+      object.pack_str_body(reinterpret_cast<const char *>(buf), size);
       return object;
     }
   };
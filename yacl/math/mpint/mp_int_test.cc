@@ -357,6 +357,47 @@ TEST_F(MPIntTest, MsgpackWorks) {
   const msgpack::object& obj = oh.get();
   obj.convert(x2);
   ASSERT_EQ(x1, x2);
+
+  // large mpint, not serialized on stack
+  MPInt x3;
+  MPInt::RandomExactBits(10000, &x3);
+  buf.clear();
+  msgpack::pack(buf, x3);
+  msgpack::object_handle oh3 = msgpack::unpack(buf.data(), buf.size());
+  oh3.get().convert(x2);
+  ASSERT_EQ(x3, x2);
+}
+
+TEST_F(MPIntTest, SerializeArrayWorks) {
+  for (size_t n : {0, 1, 15, 16, 100}) {
+    std::vector<MPInt> xs(n);
+    for (size_t i = 0; i < n; ++i) {
+      MPInt::RandomExactBits(i * 30 + 1, &xs[i]);
+      if (i % 3 == 0) {
+        xs[i].NegateInplace();
+      }
+    }
+
+    auto buf = MPInt::SerializeArray(xs);
+    EXPECT_EQ(buf.size(), MPInt::SerializeArray(xs, nullptr, 0));
+    // same as msgpack
+    msgpack::sbuffer sbuf;
+    msgpack::pack(sbuf, xs);
+    ASSERT_EQ(std::string_view(buf),
+              std::string_view(sbuf.data(), sbuf.size()));
+
+    EXPECT_EQ(MPInt::DeserializeArray(buf), xs);
+    std::vector<MPInt> ys;
+    msgpack::object_handle oh = msgpack::unpack(sbuf.data(), sbuf.size());
+    oh.get().convert(ys);
+    EXPECT_EQ(ys, xs);
+  }
+
+  std::vector<MPInt> xs = {MPInt(1), MPInt(2)};
+  std::vector<uint8_t> small(3);
+  EXPECT_ANY_THROW(MPInt::SerializeArray(xs, small.data(), small.size()));
+  auto buf = MPInt::SerializeArray(xs);
+  EXPECT_ANY_THROW(MPInt::DeserializeArray({buf.data(), buf.size() - 1}));
 }
 
 TEST_F(MPIntTest, RandPrimeOverWorks) {
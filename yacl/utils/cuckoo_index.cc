@@ -14,11 +14,54 @@
 
 #include "yacl/utils/cuckoo_index.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <mutex>
 #include <set>
+#include <utility>
+
+#include "yacl/utils/parallel.h"
 
 namespace yacl {
 
+namespace {
+
+constexpr int64_t kParallelGrainSize = 1 << 14;
+
+// Bins prefetched ahead of atomic operations.
+constexpr size_t kPrefetchDistance = 16;
+
+// Call fn(entries) for blocks of codes[begin, end), where entries are
+// {bin_idx, encoded bin} of every distinct bin of inputs in the block. The min
+// hash idx is kept for colliding hash functions.
+template <typename Fn>
+void ForEachBinBlock(absl::Span<const CuckooIndex::HashType> codes,
+                     int64_t begin, int64_t end, uint64_t num_hash,
+                     uint64_t num_bins, const Fn& fn) {
+  constexpr int64_t kBlockSize = 1024;
+  std::vector<std::pair<uint64_t, uint64_t>> entries;
+  entries.reserve(kBlockSize * CuckooIndex::kMaxNumHash);
+  for (int64_t block = begin; block < end; block += kBlockSize) {
+    entries.clear();
+    for (int64_t i = block; i < std::min(end, block + kBlockSize); ++i) {
+      CuckooIndex::HashRoom room(codes[i]);
+      std::array<uint64_t, CuckooIndex::kMaxNumHash> bins;
+      for (uint64_t j = 0; j < num_hash; ++j) {
+        bins[j] = room.GetHash(j) % num_bins;
+        if (std::find(bins.begin(), bins.begin() + j, bins[j]) ==
+            bins.begin() + j) {
+          entries.emplace_back(bins[j], CuckooIndex::Bin::Encode(i, j));
+        }
+      }
+    }
+    fn(absl::MakeConstSpan(entries));
+  }
+}
+
+}  // namespace
+
 CuckooIndex::CuckooIndex(const Options& options) : options_(options) {
   bins_.resize(options_.NumBins());
   stash_.resize(options_.num_stash);
@@ -72,6 +115,73 @@ void CuckooIndex::Insert(absl::Span<const HashType> codes) {
   }
 }
 
+void CuckooIndex::ParallelInsert(absl::Span<const HashType> codes) {
+  const size_t input_offset = hashes_.size();
+  const size_t num_bins = options_.NumBins();
+
+  // Add to hash rooms.
+  for (const HashType& code : codes) {
+    hashes_.emplace_back(code);
+  }
+  YACL_ENFORCE(hashes_.size() <= options_.num_input);
+
+  std::mutex stash_mutex;
+  // Same rounds as `Insert` over the inputs of each task. Bins of a round are
+  // prefetched ahead, as the atomic swaps do not overlap cache misses.
+  auto insert = [&](int64_t begin, int64_t end) {
+    std::vector<Bin> candidates(end - begin);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      // Init candidates. Start from first hash function.
+      candidates[i].set_encoded(input_offset + begin + i);
+    }
+    std::vector<uint64_t> bin_idxes;
+
+    size_t try_count = 0;
+    while (!candidates.empty() && try_count++ < options_.max_try_count) {
+      bin_idxes.resize(candidates.size());
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        const Bin candid = candidates[i];
+        bin_idxes[i] =
+            hashes_[candid.InputIdx()].GetHash(candid.HashIdx()) % num_bins;
+      }
+      size_t write_idx = 0;
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        if (i + kPrefetchDistance < candidates.size()) {
+          __builtin_prefetch(&bins_[bin_idxes[i + kPrefetchDistance]], 1);
+        }
+        Bin evicted_bin(
+            bins_[bin_idxes[i]].AtomicSwap(candidates[i].encoded()));
+        if (!evicted_bin.IsEmpty()) {
+          // Try next hash for evicted items.
+          uint64_t next_candid =
+              Bin::Encode(evicted_bin.InputIdx(),
+                          (evicted_bin.HashIdx() + 1) % options_.num_hash);
+          candidates[write_idx++].set_encoded(next_candid);
+        }
+      }
+      candidates.resize(write_idx);
+    }
+
+    std::lock_guard<std::mutex> lock(stash_mutex);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      PutToStash(candidates[i].InputIdx());
+    }
+  };
+  parallel_for(0, codes.size(), kParallelGrainSize, insert);
+}
+
+CuckooIndex::Candidates CuckooIndex::Lookup(HashType code) const {
+  const HashRoom room(code);
+  const uint64_t num_bins = options_.NumBins();
+  // num_hash <= kMaxNumHash, checked by the constructor.
+  Candidates candidates;
+  candidates.num = options_.num_hash;
+  for (uint64_t i = 0; i < options_.num_hash; ++i) {
+    candidates.bins[i] = room.GetHash(i) % num_bins;
+  }
+  return candidates;
+}
+
 void CuckooIndex::PutToStash(uint64_t input_idx) {
   // `stash` is small enough to do a linear search.
   for (size_t i = 0; i < stash_.size(); ++i) {
@@ -147,4 +257,64 @@ uint8_t CuckooIndex::MinCollidingHashIdx(uint64_t bin_index) const {
   return -1;
 }
 
-}  // namespace yacl
\ No newline at end of file
+SimpleHashIndex::SimpleHashIndex(const CuckooIndex::Options& options,
+                                 absl::Span<const HashType> codes) {
+  const uint64_t num_bins = options.NumBins();
+  const uint64_t num_hash = options.num_hash;
+  YACL_ENFORCE(num_hash > 0 && num_hash <= CuckooIndex::kMaxNumHash,
+               "num_hash={} out of range [1, {}]", num_hash,
+               CuckooIndex::kMaxNumHash);
+
+  // Count bin sizes.
+  std::vector<std::atomic<uint64_t>> cursors(num_bins);
+  auto count = [&](int64_t begin, int64_t end) {
+    ForEachBinBlock(codes, begin, end, num_hash, num_bins, [&](auto entries) {
+      for (size_t k = 0; k < entries.size(); ++k) {
+        if (k + kPrefetchDistance < entries.size()) {
+          __builtin_prefetch(&cursors[entries[k + kPrefetchDistance].first],
+                             1);
+        }
+        cursors[entries[k].first].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  };
+  parallel_for(0, codes.size(), kParallelGrainSize, count);
+
+  offsets_.resize(num_bins + 1);
+  offsets_[0] = 0;
+  for (uint64_t i = 0; i < num_bins; ++i) {
+    const uint64_t size = cursors[i].load(std::memory_order_relaxed);
+    max_bin_size_ = std::max(max_bin_size_, size);
+    offsets_[i + 1] = offsets_[i] + size;
+    cursors[i].store(offsets_[i], std::memory_order_relaxed);
+  }
+
+  // Scatter inputs, then restore input order in each bin.
+  items_.resize(offsets_.back());
+  auto scatter = [&](int64_t begin, int64_t end) {
+    ForEachBinBlock(codes, begin, end, num_hash, num_bins, [&](auto entries) {
+      for (size_t k = 0; k < entries.size(); ++k) {
+        if (k + kPrefetchDistance < entries.size()) {
+          __builtin_prefetch(&cursors[entries[k + kPrefetchDistance].first],
+                             1);
+        }
+        uint64_t pos =
+            cursors[entries[k].first].fetch_add(1, std::memory_order_relaxed);
+        items_[pos].set_encoded(entries[k].second);
+      }
+    });
+  };
+  parallel_for(0, codes.size(), kParallelGrainSize, scatter);
+
+  auto sort = [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      std::sort(items_.begin() + offsets_[i], items_.begin() + offsets_[i + 1],
+                [](const Bin& a, const Bin& b) {
+                  return a.InputIdx() < b.InputIdx();
+                });
+    }
+  };
+  parallel_for(0, num_bins, kParallelGrainSize, sort);
+}
+
+}  // namespace yacl
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include "absl/types/span.h"
@@ -66,6 +67,11 @@ class CuckooIndex {
       return prev;
     }
 
+    // Swap for concurrent inserts.
+    uint64_t AtomicSwap(uint64_t encoded) {
+      return __atomic_exchange_n(&encoded_, encoded, __ATOMIC_ACQ_REL);
+    }
+
     bool IsEmpty() const { return encoded_ == kEmpty; }
 
     static uint64_t Encode(uint64_t input_idx, uint8_t hash_idx) {
@@ -98,6 +104,21 @@ class CuckooIndex {
     const HashType code_;
   };
 
+  // Max `num_hash`, hash idx takes 8 bytes of the code from idx * kBlockSize.
+  inline static constexpr size_t kMaxNumHash =
+      (sizeof(HashType) - sizeof(uint64_t)) / HashRoom::kBlockSize + 1;
+
+  // Candidate bins of a code, see `Lookup`. Fixed capacity, no allocation.
+  struct Candidates {
+    std::array<uint64_t, kMaxNumHash> bins;
+    size_t num = 0;
+
+    size_t size() const { return num; }
+    uint64_t operator[](size_t idx) const { return bins[idx]; }
+    const uint64_t* begin() const { return bins.data(); }
+    const uint64_t* end() const { return bins.data() + num; }
+  };
+
   struct Options {
     // Number of expected inputs.
     uint64_t num_input;
@@ -137,6 +158,16 @@ class CuckooIndex {
   // This interface assumes `inputs` are already cryptographic random.
   void Insert(absl::Span<const HashType> codes);
 
+  // Same as `Insert`, but inputs are split into `parallel_for` tasks. Each
+  // task runs the eviction rounds of `Insert` over its inputs, swapping
+  // candidates into bins atomically. The result is a valid index, but unlike
+  // `Insert` the bin of each input is not deterministic.
+  void ParallelInsert(absl::Span<const HashType> codes);
+
+  // Candidate bins of code, one for each hash function (may repeat). The input
+  // of code is in one of them, or in stash.
+  Candidates Lookup(HashType code) const;
+
   // For debug only.
   void SanityCheck() const;
 
@@ -154,4 +185,38 @@ class CuckooIndex {
   std::vector<HashRoom> hashes_;
 };
 
+// Simple hashing companion of CuckooIndex, e.g. for PSI senders. Every input is
+// put into all its candidate bins of the peer's CuckooIndex (a bin hit by
+// several hash functions keeps the min hash idx, same as
+// `MinCollidingHashIdx`). Bins are stored in CSR layout: inputs of bin i are
+// items()[offsets()[i], offsets()[i + 1]), in input order.
+class SimpleHashIndex {
+ public:
+  using HashType = CuckooIndex::HashType;
+  using Bin = CuckooIndex::Bin;
+
+  // `options` must be the ones of the peer's CuckooIndex. Built with
+  // `parallel_for`.
+  SimpleHashIndex(const CuckooIndex::Options& options,
+                  absl::Span<const HashType> codes);
+
+  uint64_t NumBins() const { return offsets_.size() - 1; }
+
+  absl::Span<const Bin> GetBin(uint64_t bin_idx) const {
+    return absl::MakeConstSpan(items_.data() + offsets_[bin_idx],
+                               offsets_[bin_idx + 1] - offsets_[bin_idx]);
+  }
+
+  uint64_t MaxBinSize() const { return max_bin_size_; }
+
+  const std::vector<uint64_t>& offsets() const { return offsets_; }
+
+  const std::vector<Bin>& items() const { return items_; }
+
+ private:
+  std::vector<uint64_t> offsets_;
+  std::vector<Bin> items_;
+  uint64_t max_bin_size_ = 0;
+};
+
 }  // namespace yacl
@@ -0,0 +1,104 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "yacl/crypto/utils/rand.h"
+#include "yacl/utils/cuckoo_index.h"
+#include "yacl/utils/parallel.h"
+
+namespace yacl::bench {
+
+// range(0): number of inputs.
+static void BM_CuckooInsert(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto options = CuckooIndex::SelectParams(n, 0, 3);
+  auto inputs = crypto::RandVec<uint128_t>(n, true);
+  for (auto _ : state) {
+    CuckooIndex cuckoo_index(options);
+    cuckoo_index.Insert(absl::MakeSpan(inputs));
+    benchmark::DoNotOptimize(cuckoo_index.bins().data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// range(0): number of inputs.
+// runs on the whole intra-op pool, whose size is fixed at its first use, so
+// compare thread counts across runs: YACL_NUM_THREADS=16 cuckoo_index_bench
+static void BM_CuckooParallelInsert(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto options = CuckooIndex::SelectParams(n, 0, 3);
+  auto inputs = crypto::RandVec<uint128_t>(n, true);
+  for (auto _ : state) {
+    CuckooIndex cuckoo_index(options);
+    cuckoo_index.ParallelInsert(absl::MakeSpan(inputs));
+    benchmark::DoNotOptimize(cuckoo_index.bins().data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.counters["threads"] = get_num_threads();
+}
+
+// range(0): number of inputs. threads as BM_CuckooParallelInsert.
+static void BM_SimpleHashIndex(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto options = CuckooIndex::SelectParams(n, 0, 3);
+  auto inputs = crypto::RandVec<uint128_t>(n, true);
+  for (auto _ : state) {
+    SimpleHashIndex simple_index(options, absl::MakeSpan(inputs));
+    benchmark::DoNotOptimize(simple_index.items().data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.counters["threads"] = get_num_threads();
+}
+
+// range(0): number of inputs.
+static void BM_CuckooLookup(benchmark::State& state) {
+  const size_t n = state.range(0);
+  auto options = CuckooIndex::SelectParams(n, 0, 3);
+  auto inputs = crypto::RandVec<uint128_t>(n, true);
+  CuckooIndex cuckoo_index(options);
+  cuckoo_index.ParallelInsert(absl::MakeSpan(inputs));
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(cuckoo_index.Lookup(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_CuckooInsert)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24);
+
+BENCHMARK(BM_CuckooParallelInsert)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24);
+
+BENCHMARK(BM_SimpleHashIndex)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24);
+
+BENCHMARK(BM_CuckooLookup)->Unit(benchmark::kMillisecond)->Arg(1 << 20);
+
+}  // namespace yacl::bench
@@ -14,6 +14,7 @@
 
 #include "yacl/utils/cuckoo_index.h"
 
+#include <algorithm>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -57,6 +58,30 @@ TEST_P(CuckooIndexTest, Works) {
   }
 }
 
+TEST_P(CuckooIndexTest, ParallelWorks) {
+  const auto& param = GetParam();
+  CuckooIndex cuckoo_index(param);
+  std::vector<uint128_t> inputs = crypto::RandVec<uint128_t>(param.num_input);
+
+  // Insert by batches.
+  constexpr size_t kChunkSize = 100000;
+  for (size_t i = 0; i < inputs.size(); i += kChunkSize) {
+    size_t chunk_size = std::min(kChunkSize, inputs.size() - i);
+    absl::Span<const uint128_t> chunk(inputs.data() + i, chunk_size);
+    ASSERT_NO_THROW(cuckoo_index.ParallelInsert(chunk));
+  }
+  ASSERT_NO_THROW(cuckoo_index.SanityCheck());
+
+  // Every input is in one of its candidate bins.
+  const auto& bins = cuckoo_index.bins();
+  for (size_t i = 0; i < bins.size(); ++i) {
+    if (!bins[i].IsEmpty()) {
+      auto candidates = cuckoo_index.Lookup(inputs[bins[i].InputIdx()]);
+      ASSERT_EQ(candidates[bins[i].HashIdx()], i);
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     Works_Instances, CuckooIndexTest,
     testing::Values(
@@ -81,4 +106,36 @@ TEST(CuckooIndexTest, Bad_SmallScaleFactor) {
   ASSERT_THROW(cuckoo_index.Insert(absl::MakeSpan(inputs)), yacl::Exception);
 }
 
+TEST(SimpleHashIndexTest, Works) {
+  auto options = CuckooIndex::SelectParams(1 << 16, 0, 3);
+  std::vector<uint128_t> inputs = crypto::RandVec<uint128_t>(1 << 16);
+  CuckooIndex cuckoo_index(options);
+  SimpleHashIndex simple_index(options, absl::MakeSpan(inputs));
+
+  // Expected bins, built serially.
+  std::vector<std::vector<uint64_t>> expected(options.NumBins());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    auto candidates = cuckoo_index.Lookup(inputs[i]);
+    for (size_t j = 0; j < candidates.size(); ++j) {
+      if (std::find(candidates.begin(), candidates.begin() + j,
+                    candidates[j]) == candidates.begin() + j) {
+        expected[candidates[j]].push_back(CuckooIndex::Bin::Encode(i, j));
+      }
+    }
+  }
+
+  ASSERT_EQ(simple_index.NumBins(), options.NumBins());
+  uint64_t max_bin_size = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    auto bin = simple_index.GetBin(i);
+    ASSERT_EQ(bin.size(), expected[i].size());
+    for (size_t j = 0; j < bin.size(); ++j) {
+      EXPECT_EQ(bin[j].encoded(), expected[i][j]);
+    }
+    max_bin_size = std::max<uint64_t>(max_bin_size, bin.size());
+  }
+  EXPECT_EQ(simple_index.MaxBinSize(), max_bin_size);
+  EXPECT_EQ(simple_index.offsets().back(), simple_index.items().size());
+}
+
 }  // namespace yacl